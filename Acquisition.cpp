@@ -0,0 +1,270 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Acquisition.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "Acquisition.h"
+#include "units.h"
+
+/* HTU21D steps */
+#define ACQ_HTU_IDLE        0
+#define ACQ_HTU_TEMP        1
+#define ACQ_HTU_HUMD        2
+
+Acquisition::Acquisition( DRV_HTU21D *htu_sensor, MPL3115A2 *baro_sensor ) {
+	htu = htu_sensor;
+	baro = baro_sensor;
+	htu_state = ACQ_HTU_IDLE;
+	htu_step_ms = 0;
+	htu_res = DRV_HTU21D_MAXRES;
+	mpl_busy = false;
+	collecting = false;
+	pending = ACQ_SAMPLE_T();
+	last = ACQ_SAMPLE_T();
+	have_last = false;
+}
+
+/**
+ * @brief      Triggers both sensors.  Returns at once - call service() from
+ *             the main loop, or use acquire() to wait.
+ *
+ * @return     false if a sample is already being taken.
+ */
+bool Acquisition::start( void ) {
+	if ( busy() ) {
+		return false;
+	}
+	pending = ACQ_SAMPLE_T();
+	pending.start_ms = millis();
+
+	htu->setConfig();
+	htu_res = htu->getResolution();
+	htu_state = ACQ_HTU_IDLE;
+	if ( htu->triggerTemp() ) {
+		htu_step_ms = millis();
+		htu_state = ACQ_HTU_TEMP;
+	}
+	mpl_busy = false;
+	if ( baro->eventsActive() ) {
+		/* the device converts on its own timer */
+		poll_mpl_events();
+	}
+	else if ( baro->startConversion() ) {
+		mpl_busy = true;
+		/* the ratio may be changed before the result is in */
+		pending.mpl_conv_ms = MPL3115A2::conversionTime_ms( baro->getOversampling() );
+	}
+	/* completed by the next service(), empty if neither sensor answered */
+	collecting = true;
+	return true;
+}
+
+/**
+ * @brief      Collects whatever has finished converting - call from every
+ *             pass of loop().  Never blocks.
+ *
+ * @return     true on the call that completes the sample.
+ */
+bool Acquisition::service( void ) {
+	if ( !busy() ) {
+		return false;
+	}
+	uint32_t now = millis();
+
+	if ( ( ACQ_HTU_IDLE != htu_state ) && mpl_busy &&
+	     ( (int32_t) ( mpl_due_ms() - htu_due_ms() ) < 0 ) ) {
+		service_mpl();
+		service_htu( now );
+	}
+	else {
+		service_htu( now );
+		service_mpl();
+	}
+
+	if ( ( ACQ_HTU_IDLE != htu_state ) || mpl_busy ) {
+		return false;
+	}
+	collecting = false;
+	last = pending;
+	have_last = true;
+	return true;
+}
+
+/**
+ * @brief      true while a sample is being taken.
+ */
+bool Acquisition::busy( void ) {
+	return collecting;
+}
+
+/**
+ * @brief      Time until service() next has something to collect - how long
+ *             the caller may sleep.
+ *
+ * @return     ms, 0 if service() should run now, ACQ_NOT_DUE if no sample
+ *             is being taken.
+ */
+uint32_t Acquisition::msUntilDue( void ) {
+	if ( !busy() ) {
+		return ACQ_NOT_DUE;
+	}
+	uint32_t now = millis();
+	uint32_t wait = ACQ_NOT_DUE;
+
+	/* service() collects a step once millis() is past its due time */
+	if ( ACQ_HTU_IDLE != htu_state ) {
+		wait = ms_left( htu_due_ms() + 1, now );
+	}
+	if ( mpl_busy ) {
+		uint32_t left = ms_left( mpl_due_ms() + 1, now );
+		wait = ( left < wait ) ? left : wait;
+	}
+	/* nothing converting - the next service() completes the sample */
+	return ( ACQ_NOT_DUE == wait ) ? 0 : wait;
+}
+
+/**
+ * @brief      Takes a sample and waits for it - the longer of the two
+ *             sensors' conversion times.  A sample already under way is
+ *             finished instead of a new one started.
+ *
+ * @param[out] sample  the sample - check its valid bits.
+ *
+ * @return     false if no sample could be taken.
+ */
+bool Acquisition::acquire( ACQ_SAMPLE_T *sample ) {
+	if ( !busy() ) {
+		start();
+	}
+	while ( !service() && busy() ) {
+		delay( 1 );
+	}
+	return getSample( sample );
+}
+
+/**
+ * @brief      The most recent complete sample.  Never touches the bus.
+ *
+ * @return     false until a sample has completed.
+ */
+bool Acquisition::getSample( ACQ_SAMPLE_T *sample ) {
+	if ( !have_last ) {
+		return false;
+	}
+	*sample = last;
+	return true;
+}
+
+/**
+ * @brief      millis() the running HTU21D conversion is due at.
+ */
+uint32_t Acquisition::htu_due_ms( void ) {
+	return htu_step_ms + DRV_HTU21D::conversionTime_ms( ACQ_HTU_HUMD == htu_state, htu_res );
+}
+
+/**
+ * @brief      millis() the running MPL3115A2 conversion is due at.
+ */
+uint32_t Acquisition::mpl_due_ms( void ) {
+	return pending.start_ms + pending.mpl_conv_ms;
+}
+
+/**
+ * @brief      ms from now to due, 0 once it has passed.
+ */
+uint32_t Acquisition::ms_left( uint32_t due, uint32_t now ) {
+	return ( (int32_t) ( due - now ) > 0 ) ? ( due - now ) : 0;
+}
+
+/**
+ * @brief      Fetches the HTU21D result once its conversion time is up, and
+ *             follows the temperature with the humidity.  A result that has
+ *             not come at twice the conversion time is given up on.
+ */
+void Acquisition::service_htu( uint32_t now ) {
+	if ( ACQ_HTU_IDLE == htu_state ) {
+		return;
+	}
+	bool humidity = ( ACQ_HTU_HUMD == htu_state );
+	uint32_t conv_ms = DRV_HTU21D::conversionTime_ms( humidity, htu_res );
+	uint32_t elapsed = now - htu_step_ms;
+	/* millis() steps whole ms, so equal can still be short */
+	if ( elapsed <= conv_ms ) {
+		return;
+	}
+
+	uint16_t raw;
+	HTU21D_FETCH_T result = htu->fetchMeasurement( humidity, &raw );
+	if ( ( HTU21D_FETCH_BUSY == result ) && ( elapsed <= 2 * conv_ms ) ) {
+		return;
+	}
+
+	if ( humidity ) {
+		if ( HTU21D_FETCH_OK == result ) {
+			pending.humidity_c100 = units_htu_humidity_c100( raw );
+			pending.valid |= ACQ_VALID_HTU_RH;
+		}
+		pending.htu_ms = (uint16_t) ( millis() - pending.start_ms );
+		htu_state = ACQ_HTU_IDLE;
+		return;
+	}
+
+	if ( HTU21D_FETCH_OK == result ) {
+		pending.temp_htu_c100 = units_htu_temp_c100( raw );
+		pending.valid |= ACQ_VALID_HTU_T;
+	}
+	if ( htu->triggerHumidity() ) {
+		htu_step_ms = millis();
+		htu_state = ACQ_HTU_HUMD;
+	}
+	else {
+		pending.htu_ms = (uint16_t) ( millis() - pending.start_ms );
+		htu_state = ACQ_HTU_IDLE;
+	}
+}
+
+/**
+ * @brief      Takes the barometer's newest result in event mode if it moved
+ *             past a window since the last one published - one INT_SOURCE
+ *             read when it has not.
+ */
+void Acquisition::poll_mpl_events( void ) {
+	MPL3115A2_SAMPLE_T s;
+
+	if ( baro->pollEvents( &s ) ) {
+		pending.pressure_pa4 = s.pressure;
+		pending.temp_mpl_c100 = s.temp_c100;
+		pending.valid |= ACQ_VALID_MPL;
+	}
+	else {
+		pending.valid |= ACQ_MPL_HELD;
+	}
+	pending.mpl_ms = (uint16_t) ( millis() - pending.start_ms );
+}
+
+/**
+ * @brief      Collects the MPL3115A2 result - the driver keeps off the bus
+ *             until its conversion time is up.
+ */
+void Acquisition::service_mpl( void ) {
+	if ( !mpl_busy ) {
+		return;
+	}
+	if ( baro->conversionReady() ) {
+		if ( baro->collectPressure( &pending.pressure_pa4 ) &&
+		     baro->collectTemperature_c100( &pending.temp_mpl_c100 ) ) {
+			pending.valid |= ACQ_VALID_MPL;
+		}
+	}
+	else if ( MPL3115A2_CONV_BUSY == baro->conversionState() ) {
+		return;
+	}
+	pending.mpl_ms = (uint16_t) ( millis() - pending.start_ms );
+	mpl_busy = false;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,93 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Acquisition.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Takes one environmental sample from the HTU21D and the
+ *             MPL3115A2 with their conversions overlapped.
+ *
+ * @details    The two parts convert independently and only share the bus
+ *             to be told to start and to hand over a result.  start()
+ *             triggers the HTU21D temperature and the MPL3115A2 one-shot
+ *             back to back; service() then touches the bus only for a
+ *             sensor whose conversion time is up, earliest first, and
+ *             triggers the HTU21D humidity as soon as its temperature is
+ *             in.  A sample takes the longer of the MPL3115A2 conversion
+ *             and the HTU21D pair instead of the sum of all three -
+ *             host/bench_acquire measures both.
+ *
+ *             The coordinator drives the HTU21D with its no-hold-master
+ *             commands, so the driver's own service() pipeline must not
+ *             run alongside it.  A barometer in event mode converts on
+ *             its own timer: start() asks pollEvents() for a change
+ *             instead, and a sample with none is marked ACQ_MPL_HELD, so
+ *             the pressure last published still stands.  A barometer in
+ *             batch mode is left alone and the sample goes without it.
+ */
+
+#ifndef ACQUISITION_H
+#define ACQUISITION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Arduino.h"
+#include "drv_htu21d.h"
+#include "MPL3115A2.h"
+
+/* ACQ_SAMPLE_T valid bits */
+#define ACQ_VALID_HTU_T     (0x01)
+#define ACQ_VALID_HTU_RH    (0x02)
+#define ACQ_VALID_MPL       (0x04)  /* pressure and temperature */
+#define ACQ_MPL_HELD        (0x08)  /* event mode, nothing moved past its window */
+
+/* msUntilDue() with no sample being taken */
+#define ACQ_NOT_DUE         (0xFFFFFFFFUL)
+
+/** @brief      One environmental sample. */
+typedef struct ACQ_SAMPLE
+{
+	uint32_t start_ms;      /* millis() when the conversions were triggered */
+	uint16_t htu_ms;        /* start to the HTU21D humidity collected */
+	uint16_t mpl_ms;        /* start to the MPL3115A2 result collected */
+	uint16_t mpl_conv_ms;   /* MPL3115A2 conversion time at the ratio it ran */
+	int16_t temp_htu_c100;
+	int16_t humidity_c100;
+	int16_t temp_mpl_c100;
+	uint32_t pressure_pa4;
+	uint8_t valid;
+} ACQ_SAMPLE_T;
+
+class Acquisition {
+public:
+	Acquisition( DRV_HTU21D *htu, MPL3115A2 *baro );
+	bool start( void );
+	bool service( void );
+	bool busy( void );
+	uint32_t msUntilDue( void );
+	bool acquire( ACQ_SAMPLE_T *sample );
+	bool getSample( ACQ_SAMPLE_T *sample );
+private:
+	uint32_t htu_due_ms( void );
+	uint32_t mpl_due_ms( void );
+	static uint32_t ms_left( uint32_t due, uint32_t now );
+	void service_htu( uint32_t now );
+	void service_mpl( void );
+	void poll_mpl_events( void );
+	DRV_HTU21D *htu;
+	MPL3115A2 *baro;
+	uint8_t htu_state;
+	uint32_t htu_step_ms;   /* millis() the current HTU21D conversion began */
+	uint8_t htu_res;
+	bool mpl_busy;
+	bool collecting;
+	ACQ_SAMPLE_T pending;
+	ACQ_SAMPLE_T last;
+	bool have_last;
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -41,6 +41,7 @@
 #include <Wire.h>
 
 #include "MPL3115A2.h"
+#include "units.h"
 
 /*-----------------------------------------*/
 /* Private declarations  */
@@ -74,6 +75,14 @@
 
 #define MPL3115A2_WHO_AM_I                      (0x0C)
 
+#define MPL3115A2_F_STATUS                      (0x0D)
+#define MPL3115A2_F_STATUS_OVF                  (0x80)
+#define MPL3115A2_F_STATUS_CNT_MASK             (0x3F)
+#define MPL3115A2_F_DATA                        (0x0E)
+#define MPL3115A2_F_SETUP                       (0x0F)
+#define MPL3115A2_F_SETUP_OFF                   (0x00)
+#define MPL3115A2_F_SETUP_CIRCULAR              (0x40)
+
 #define MPL3115A2_PT_DATA_CFG                   (0x13)
 #define MPL3115A2_PT_DATA_CFG_TDEFE             (0x01)
 #define MPL3115A2_PT_DATA_CFG_PDEFE             (0x02)
@@ -95,12 +104,77 @@
 #define MPL3115A2_CTRL_REG1_ALT                 (0x80)
 #define MPL3115A2_CTRL_REG1_BAR                 (0x00)
 #define MPL3115A2_CTRL_REG2                     (0x27)
+#define MPL3115A2_CTRL_REG2_ST_MASK             (0x0F)
 #define MPL3115A2_CTRL_REG3                     (0x28)
 #define MPL3115A2_CTRL_REG4                     (0x29)
+#define MPL3115A2_CTRL_REG4_INT_EN_PW           (0x20)
+#define MPL3115A2_CTRL_REG4_INT_EN_TW           (0x10)
 #define MPL3115A2_CTRL_REG5                     (0x2A)
 
 #define MPL3115A2_REGISTER_STARTCONVERSION      (0x12)
+#define MPL3115A2_INT_SOURCE                    (0x12)
+#define MPL3115A2_INT_SOURCE_SRC_PW             (0x20)
+#define MPL3115A2_INT_SOURCE_SRC_TW             (0x10)
+
+#define MPL3115A2_P_TGT_MSB                     (0x16)
+#define MPL3115A2_P_TGT_LSB                     (0x17)
+#define MPL3115A2_T_TGT                         (0x18)
+#define MPL3115A2_P_WND_MSB                     (0x19)
+#define MPL3115A2_P_WND_LSB                     (0x1A)
+#define MPL3115A2_T_WND                         (0x1B)
+
+/* CTRL_REG1 OS field */
+#define MPL3115A2_CTRL_REG1_OS_SHIFT            (3)
+/* status poll interval used by the blocking getters once a conversion is
+   due, at most */
+#define MPL3115A2_POLL_MS                       (10)
+/* a held result younger than this is reused by getTemperature() */
+#define MPL3115A2_RESULT_MAX_AGE_MS             (1000)
+/* STATUS, OUT_P MSB/CSB/LSB and OUT_T MSB/LSB - the read pointer runs
+   through them in order with the FIFO off */
+#define MPL3115A2_BURST_LEN                     (6)
+/* OUT_P MSB/CSB/LSB and OUT_T MSB/LSB of one FIFO sample */
+#define MPL3115A2_SAMPLE_LEN                    (5)
+/* FIFO samples per read - the twi library buffers 32 bytes */
+#define MPL3115A2_DRAIN_CHUNK                   (6)
+
+
+/**
+ * @brief      Minimum time between samples for each oversampling ratio,
+ *             from the datasheet (OS1 to OS128).
+ */
+const uint16_t mpl3115a2_conv_time_ms[MPL3115A2_OS128 + 1] PROGMEM =
+{
+	6, 10, 18, 34, 66, 130, 258, 512
+};
+
+/**
+ * @brief      The 20 bit pressure/altitude of OUT_P_MSB, OUT_P_CSB, OUT_P_LSB.
+ */
+static uint32_t out_p_raw( const uint8_t *out_p )
+{
+	uint32_t raw = ( (uint32_t) out_p[0] << 16 ) | ( (uint32_t) out_p[1] << 8 ) | out_p[2];
+	return raw >> 4;
+}
 
+/**
+ * @brief      OUT_T_MSB:OUT_T_LSB.
+ */
+static uint16_t out_t_raw( const uint8_t *out_t )
+{
+	return ( (uint16_t) out_t[0] << 8 ) | out_t[1];
+}
+
+/**
+ * @brief      Sign extends a 20 bit altitude.
+ */
+static uint32_t altitude_raw( uint32_t raw )
+{
+	if ( raw & 0x80000 ) {
+		raw |= 0xFFF00000;
+	}
+	return raw;
+}
 
 /**
  * @brief      Constructs the MPL3115A2 driver.
@@ -108,6 +182,26 @@
 MPL3115A2::MPL3115A2 ()
 {
 	device_mode = 0;
+	conv_state = MPL3115A2_CONV_IDLE;
+	conv_mode = 0;
+	conv_start_ms = 0;
+	conv_p_raw = 0;
+	conv_t_raw = 0;
+	conv_poll_status = false;
+	oversample = MPL3115A2_OS128;
+	conv_os = MPL3115A2_OS128;
+	auto_os = MPL3115A2_OS128;
+	auto_state = MPL3115A2_AUTO_OFF;
+	auto_mode = 0;
+	auto_period_log2 = 0;
+	auto_start_ms = 0;
+	batch_next = 0;
+	events_primed = false;
+	events_follow_up = false;
+	events_p_window = 0;
+	events_t_window_c100 = 0;
+	events_p_target = 0;
+	events_t_target_c100 = 0;
 }
 
 /**
@@ -127,11 +221,31 @@ uint8_t MPL3115A2::i2c_read( uint8_t read_register ) {
 	return Wire.read();
 }
 
+/**
+ * @brief      Reads consecutive registers in one transaction: the register
+ *             pointer write and a repeated START read of len bytes.
+ *
+ * @return     number of bytes received, 0 if the device did not answer.
+ */
+uint8_t MPL3115A2::i2c_read_burst( uint8_t first_register, uint8_t *data, uint8_t len ) {
+	Wire.beginTransmission( MPL3115A2_ADDRESS );
+	Wire.write( first_register );
+	if ( 0 != Wire.endTransmission( false ) ) {
+		return 0;
+	}
+
+	uint8_t bytes_rxd = Wire.requestFrom( (uint8_t) MPL3115A2_ADDRESS, len );
+	for ( uint8_t i = 0; i < bytes_rxd; i++ ) {
+		data[i] = Wire.read();
+	}
+	return bytes_rxd;
+}
+
 void MPL3115A2::i2c_write( uint8_t reg_addr, uint8_t value ) {
 	Wire.beginTransmission( MPL3115A2_ADDRESS );
 	Wire.write( reg_addr );
 	Wire.write( value );
-	Wire.endTransmission(false);
+	Wire.endTransmission();
 }
 
 /**
@@ -154,6 +268,9 @@ void MPL3115A2::set_device_mode ( uint8_t mode )
  *                            this can always be changed later.
  *
  * @return     true if the device has been initialized properly.
+ *
+ * @note       The device is left in standby, conversions are only run on
+ *             request with startConversion().
  */
 bool MPL3115A2::init ( bool altitude_mode ) {
 	bool init_success = false;
@@ -163,59 +280,231 @@ bool MPL3115A2::init ( bool altitude_mode ) {
 		init_success = true;
 	}
 
-	//set_device_mode( MPL3115A2_CTRL_REG1_ALT );
-	i2c_write( MPL3115A2_CTRL_REG1,
-	 MPL3115A2_CTRL_REG1_SBYB |
-	 MPL3115A2_CTRL_REG1_OS128 |
-	 MPL3115A2_CTRL_REG1_ALT);
+	if ( altitude_mode ) {
+		set_device_mode( MPL3115A2_CTRL_REG1_ALT );
+	}
+	else {
+		set_device_mode( MPL3115A2_CTRL_REG1_BAR );
+	}
+	i2c_write( MPL3115A2_CTRL_REG1, os_bits( oversample ) | device_mode );
 
 	i2c_write( MPL3115A2_PT_DATA_CFG, 
 			   MPL3115A2_PT_DATA_CFG_TDEFE | MPL3115A2_PT_DATA_CFG_PDEFE |
 			   MPL3115A2_PT_DATA_CFG_DREM );
 
+	conv_state = MPL3115A2_CONV_IDLE;
+
 	return init_success;
 }
 
 /**
- * @brief      Get the MPL3115A2 Pressure Reading
+ * @brief      Triggers a one-shot (OST) conversion in the current device mode
+ *             and oversampling ratio and returns immediately.  The result is
+ *             picked up later with conversionReady() and the collect
+ *             functions.
  *
- * @param[out] pressure  the returned pressure result - valid if the function
+ * @return     true if a conversion is running, false in batch or event
+ *             mode.
+ */
+bool MPL3115A2::startConversion( void )
+{
+	if ( MPL3115A2_CONV_BUSY == conv_state ) {
+		return true;
+	}
+	if ( MPL3115A2_AUTO_OFF != auto_state ) {
+		/* the device is sampling on its own timer */
+		return false;
+	}
+
+	i2c_write( MPL3115A2_CTRL_REG1,
+			   os_bits( oversample ) |
+			   MPL3115A2_CTRL_REG1_OST |
+			   device_mode );
+
+	conv_mode = device_mode;
+	conv_os = oversample;
+	conv_start_ms = millis();
+	conv_poll_status = false;
+	conv_state = MPL3115A2_CONV_BUSY;
+	return true;
+}
+
+/**
+ * @brief      Advances the conversion state machine without blocking.  The
+ *             bus is left alone until the conversion time for the ratio the
+ *             conversion was started with has passed (and it is abandoned at
+ *             twice that), after
+ *             that a call reads STATUS, OUT_P and OUT_T in one 6 byte burst
+ *             and keeps the result if STATUS says it is complete.
+ *
+ * @details    Reading OUT_P_MSB clears the data ready flags, so a burst that
+ *             finds the conversion still running may have cleared a flag
+ *             raised between the STATUS and OUT_P bytes.  After one such
+ *             burst the calls poll STATUS on its own and only burst once it
+ *             reports the data ready.
+ *
+ * @return     true once a result is held and can be collected.
+ */
+bool MPL3115A2::conversionReady( void )
+{
+	if ( MPL3115A2_CONV_BUSY == conv_state ) {
+		uint32_t elapsed = millis() - conv_start_ms;
+		uint16_t conv_ms = conversionTime_ms( conv_os );
+		/* millis() steps whole ms, so equal can still be short */
+		if ( elapsed > conv_ms ) {
+			if ( !conv_poll_status ||
+				 ( i2c_read( MPL3115A2_REGISTER_STATUS ) & MPL3115A2_REGISTER_STATUS_PTDR ) ) {
+				uint8_t burst[MPL3115A2_BURST_LEN];
+				if ( MPL3115A2_BURST_LEN != i2c_read_burst( MPL3115A2_REGISTER_STATUS,
+															burst, MPL3115A2_BURST_LEN ) ) {
+					conv_state = MPL3115A2_CONV_ERROR;
+				}
+				else if ( burst[0] & MPL3115A2_REGISTER_STATUS_PTDR ) {
+					decode_conversion( burst );
+					conv_state = MPL3115A2_CONV_READY;
+				}
+				else {
+					conv_poll_status = true;
+				}
+			}
+			if ( ( MPL3115A2_CONV_BUSY == conv_state ) &&
+				 ( elapsed > 2UL * conv_ms ) ) {
+				conv_state = MPL3115A2_CONV_ERROR;
+			}
+		}
+	}
+	return ( MPL3115A2_CONV_READY == conv_state );
+}
+
+/**
+ * @brief      The state of the last conversion started.
+ */
+MPL3115A2_CONV_STATE_T MPL3115A2::conversionState( void )
+{
+	return conv_state;
+}
+
+/**
+ * @brief      Takes the pressure/altitude and temperature of a completed
+ *             conversion from a STATUS burst.
+ *
+ * @param[in]  burst  STATUS, OUT_P_MSB, OUT_P_CSB, OUT_P_LSB, OUT_T_MSB,
+ *                    OUT_T_LSB.
+ */
+void MPL3115A2::decode_conversion( const uint8_t *burst )
+{
+	conv_p_raw = out_p_raw( &burst[1] );
+	conv_t_raw = out_t_raw( &burst[4] );
+}
+
+/**
+ * @brief      Collects the pressure from a completed barometer mode
+ *             conversion.
+ *
+ * @param[out] pressure  pressure in Q18.2 pascals - valid if the function
  *                       returns true.
  *
- * @return     true if the pressure value is valid.
- * @return     false if the pressure reading is invalid, mode is incorrect or other
- *             failures.
+ * @return     true if a barometer mode result is held.
  */
-bool MPL3115A2::getPressure( uint32_t* pressure )
+bool MPL3115A2::collectPressure( uint32_t* pressure )
 {
-	bool valid_pressure = false;
+	if ( ( MPL3115A2_CONV_READY != conv_state ) ||
+		 ( MPL3115A2_CTRL_REG1_BAR != conv_mode ) ) {
+		return false;
+	}
+	*pressure = conv_p_raw;
+	return true;
+}
 
-	i2c_write(MPL3115A2_CTRL_REG1, 
-			MPL3115A2_CTRL_REG1_SBYB |
-			MPL3115A2_CTRL_REG1_OS128 |
-			MPL3115A2_CTRL_REG1_BAR);
+/**
+ * @brief      Collects the altitude from a completed altimeter mode
+ *             conversion.
+ *
+ * @param[out] altitude  altitude in signed Q16.4 meters - valid if the
+ *                       function returns true.
+ *
+ * @return     true if an altimeter mode result is held.
+ */
+bool MPL3115A2::collectAltitude( uint32_t* altitude )
+{
+	if ( ( MPL3115A2_CONV_READY != conv_state ) ||
+		 ( MPL3115A2_CTRL_REG1_ALT != conv_mode ) ) {
+		return false;
+	}
+	*altitude = altitude_raw( conv_p_raw );
+	return true;
+}
 
-	uint8_t sta = 0;
-	while (! (sta & MPL3115A2_REGISTER_STATUS_PDR)) {
-		sta = i2c_read(MPL3115A2_REGISTER_STATUS);
-		delay(10);
+/**
+ * @brief      Collects the temperature of a completed conversion (either
+ *             mode).
+ *
+ * @param[out] temperature  temperature in degrees C - valid if the function
+ *                          returns true.
+ *
+ * @return     true if a result is held.
+ */
+bool MPL3115A2::collectTemperature( float* temperature )
+{
+	if ( MPL3115A2_CONV_READY != conv_state ) {
+		return false;
 	}
-	
-	Wire.beginTransmission(MPL3115A2_ADDRESS); // start transmission to device 
-	Wire.write(MPL3115A2_REGISTER_PRESSURE_MSB); 
-	Wire.endTransmission(false); // end transmission
+	/* Q8.4 two's complement in the upper 12 bits */
+	int16_t t_q4 = (int16_t) conv_t_raw;
+	t_q4 >>= 4;
+	*temperature = t_q4 / 16.0;
+	return true;
+}
 
-	Wire.requestFrom((uint8_t)MPL3115A2_ADDRESS, (uint8_t)3);// send data n-bytes read
-	
-	*pressure = Wire.read(); // receive DATA
-	*pressure <<= 8;
-	*pressure |= Wire.read(); // receive DATA
-	*pressure <<= 8;
-	*pressure |= Wire.read(); // receive DATA
-	*pressure >>= 4;
-	valid_pressure = true;
+/**
+ * @brief      collectTemperature() in hundredths of a degree C, without
+ *             touching a float.
+ *
+ * @return     true if a result is held.
+ */
+bool MPL3115A2::collectTemperature_c100( int16_t *c100 )
+{
+	if ( MPL3115A2_CONV_READY != conv_state ) {
+		return false;
+	}
+	*c100 = units_mpl_temp_c100( conv_t_raw );
+	return true;
+}
 
-	return valid_pressure;
+/**
+ * @brief      Runs a conversion in the given mode, at the oversampling
+ *             ratio set, and waits for it.  Used by the blocking getters.
+ *
+ * @return     true if the conversion completed.
+ */
+bool MPL3115A2::wait_conversion( uint8_t mode )
+{
+	uint8_t saved_mode = device_mode;
+
+	if ( MPL3115A2_CONV_BUSY == conv_state ) {
+		/* let the running conversion finish rather than stacking another */
+		while ( !conversionReady() && ( MPL3115A2_CONV_BUSY == conv_state ) ) {
+			delay( poll_ms( conv_os ) );
+		}
+	}
+	conv_state = MPL3115A2_CONV_IDLE;
+
+	set_device_mode( mode );
+	bool started = startConversion();
+	set_device_mode( saved_mode );
+	if ( !started ) {
+		return false;
+	}
+
+	/* nothing to ask the device until the conversion is due */
+	delay( conversionTime_ms( conv_os ) + 1 );
+	while ( !conversionReady() ) {
+		if ( MPL3115A2_CONV_ERROR == conv_state ) {
+			return false;
+		}
+		delay( poll_ms( conv_os ) );
+	}
+	return true;
 }
 
 /**
@@ -227,44 +516,33 @@ bool MPL3115A2::getPressure( uint32_t* pressure )
  * @return     true if the pressure value is valid.
  * @return     false if the pressure reading is invalid, mode is incorrect or other
  *             failures.
+ *
+ * @note       Blocks for a full conversion, use startConversion() and
+ *             collectPressure() from the main loop.  Fails in batch or event mode.
  */
-bool MPL3115A2::getAltitude( uint32_t* altitude )
+bool MPL3115A2::getPressure( uint32_t* pressure )
 {
-	bool valid_altitude = false;
-
-	//if ( device_mode == MPL3115A2_CTRL_REG1_ALT ) {
-		i2c_write( MPL3115A2_CTRL_REG1, 
-	 			   MPL3115A2_CTRL_REG1_SBYB |
-				   MPL3115A2_CTRL_REG1_OS128 |
-	 			   MPL3115A2_CTRL_REG1_ALT);
+	return ( wait_conversion( MPL3115A2_CTRL_REG1_BAR ) &&
+			 collectPressure( pressure ) );
+}
 
-		uint8_t sta = 0;
-		while (! (sta & MPL3115A2_REGISTER_STATUS_PDR)) {
-			sta = i2c_read(MPL3115A2_REGISTER_STATUS);
-			delay(10);
-		}
-		
-		Wire.beginTransmission(MPL3115A2_ADDRESS); // start transmission to device 
-		Wire.write(MPL3115A2_REGISTER_PRESSURE_MSB); 
-		Wire.endTransmission(false); // end transmission
-
-		uint8_t bytes_rxd = Wire.requestFrom((uint8_t)MPL3115A2_ADDRESS, (uint8_t)3);// send data n-bytes read
-		if ( 2 < bytes_rxd ) {
-			*altitude = Wire.read(); // receive DATA
-			*altitude <<= 8;
-			*altitude |= Wire.read(); // receive DATA
-			*altitude <<= 8;
-			*altitude |= Wire.read(); // receive DATA
-			*altitude >>= 4;
-
-		  	if (*altitude & 0x80000) {
-				*altitude |= 0xFFF00000;
-		  	}
-		  	//float altitude = altitude;
-			//altitude /= 16.0;
-			valid_altitude = true;
-		}
-	return valid_altitude;
+/**
+ * @brief      Get the MPL3115A2 Altitude Reading
+ *
+ * @param[out] altitude  the returned altitude result - valid if the function
+ *                       returns true.
+ *
+ * @return     true if the altitude value is valid.
+ * @return     false if the altitude reading is invalid, mode is incorrect or other
+ *             failures.
+ *
+ * @note       Blocks for a full conversion, use startConversion() and
+ *             collectAltitude() from the main loop.  Fails in batch or event mode.
+ */
+bool MPL3115A2::getAltitude( uint32_t* altitude )
+{
+	return ( wait_conversion( MPL3115A2_CTRL_REG1_ALT ) &&
+			 collectAltitude( altitude ) );
 }
 
 
@@ -280,38 +558,443 @@ float MPL3115A2::getPressure_Pa( void ) {
     return f_press;
 }
 
+/**
+ * @brief      Blocking pressure reading in inches of mercury, -9999 on
+ *             failure.  Converted in fixed point, only the result is a float.
+ */
 float MPL3115A2::getPressure_InHg( void ) {
-	return (getPressure_Pa()/3386.38);
+	uint32_t pressure;
+	float f_press = -9999;
+
+	if ( getPressure( &pressure ) ) {
+		f_press = units_pa4_to_inhg1000( pressure ) / 1000.0f;
+	}
+	return f_press;
 }
 
+/**
+ * @brief      Gets the temperature, reusing a result that is still held from
+ *             a recent conversion, otherwise running a new one.
+ *
+ * @return     temperature in degrees C, -999 on failure.
+ */
 float MPL3115A2::getTemperature() {
-	uint16_t t_u16;
-	uint8_t sta = 0;
-
-	while (! (sta & MPL3115A2_REGISTER_STATUS_TDR)) {
-		sta = i2c_read(MPL3115A2_REGISTER_STATUS);
-		delay(10);
-	}
-	
-	Wire.beginTransmission(MPL3115A2_ADDRESS); // start transmission to device 
-	Wire.write(MPL3115A2_REGISTER_TEMP_MSB); 
-	Wire.endTransmission(false); // end transmission
-	float temp;
-	uint8_t bytes_rxd = Wire.requestFrom((uint8_t)MPL3115A2_ADDRESS, (uint8_t)2);// send data n-bytes read
-	
-	if ( 1 < bytes_rxd) {
-		t_u16 = Wire.read(); // receive DATA
-		t_u16 <<= 8;
-		t_u16 |= Wire.read(); // receive DATA
-		t_u16 >>= 4;
-		temp = t_u16;
-		temp /= 16.0;
+	float temp = -999;
+	bool recent = ( MPL3115A2_CONV_READY == conv_state ) &&
+				  ( ( millis() - conv_start_ms ) < MPL3115A2_RESULT_MAX_AGE_MS );
+
+	if ( recent || wait_conversion( device_mode ) ) {
+		collectTemperature( &temp );
+	}
+	return temp;
+}
+
+/**
+ * @brief      Puts the device into active mode on its own timer, one
+ *             conversion every 2^period_log2 seconds at the oversampling
+ *             ratio set - the setup batch and event mode share.  Every ratio
+ *             converts well inside the shortest (1 s) period.  The FIFO,
+ *             timer and interrupt enables are only set up in standby; leaving
+ *             and re-entering a FIFO mode empties it.
+ */
+void MPL3115A2::start_auto( MPL3115A2_AUTO_T state, uint8_t period_log2,
+							uint8_t f_setup, uint8_t int_enable )
+{
+	i2c_write( MPL3115A2_CTRL_REG1, os_bits( oversample ) | device_mode );
+	i2c_write( MPL3115A2_F_SETUP, MPL3115A2_F_SETUP_OFF );
+	if ( MPL3115A2_F_SETUP_OFF != f_setup ) {
+		i2c_write( MPL3115A2_F_SETUP, f_setup );
+	}
+	i2c_write( MPL3115A2_CTRL_REG2, period_log2 & MPL3115A2_CTRL_REG2_ST_MASK );
+	i2c_write( MPL3115A2_CTRL_REG4, int_enable );
+	i2c_write( MPL3115A2_CTRL_REG1,
+			   os_bits( oversample ) |
+			   MPL3115A2_CTRL_REG1_SBYB |
+			   device_mode );
+
+	conv_state = MPL3115A2_CONV_IDLE;
+	auto_state = state;
+	auto_mode = device_mode;
+	auto_os = oversample;
+	auto_period_log2 = period_log2;
+	auto_start_ms = millis();
+	batch_next = 0;
+}
+
+/**
+ * @brief      Back to standby and one-shot conversions.
+ */
+void MPL3115A2::stop_auto( void )
+{
+	i2c_write( MPL3115A2_CTRL_REG1, os_bits( oversample ) | device_mode );
+	i2c_write( MPL3115A2_F_SETUP, MPL3115A2_F_SETUP_OFF );
+	i2c_write( MPL3115A2_CTRL_REG2, 0 );
+	i2c_write( MPL3115A2_CTRL_REG4, 0 );
+	auto_state = MPL3115A2_AUTO_OFF;
+}
+
+/**
+ * @brief      Samples the timer has taken since start_auto(): the first one
+ *             conversion time in, then one a period.
+ */
+uint32_t MPL3115A2::auto_samples_taken( void )
+{
+	uint32_t elapsed = millis() - auto_start_ms;
+	uint16_t conv_ms = conversionTime_ms( auto_os );
+	if ( elapsed < conv_ms ) {
+		return 0;
+	}
+	return ( elapsed - conv_ms ) / samplePeriod_ms() + 1;
+}
+
+/**
+ * @brief      millis() at which the timer took sample number index.
+ */
+uint32_t MPL3115A2::auto_sample_ms( uint32_t index )
+{
+	return auto_start_ms + conversionTime_ms( auto_os ) + index * samplePeriod_ms();
+}
+
+/**
+ * @brief      OUT_P and OUT_T of a sample as collectPressure() or
+ *             collectAltitude() and collectTemperature_c100() give them.
+ */
+void MPL3115A2::decode_sample( const uint8_t *out, MPL3115A2_SAMPLE_T *sample )
+{
+	sample->pressure = out_p_raw( out );
+	if ( MPL3115A2_CTRL_REG1_ALT == auto_mode ) {
+		sample->pressure = altitude_raw( sample->pressure );
+	}
+	sample->temp_c100 = units_mpl_temp_c100( out_t_raw( &out[3] ) );
+}
+
+/**
+ * @brief      Puts the device into batch mode: it converts on its own timer,
+ *             once every 2^period_log2 seconds, and queues each result in its
+ *             32 sample FIFO for drainBatch() to pick up.  One-shot
+ *             conversions are refused until stopBatch().
+ *
+ * @details    The timer steps in whole seconds, so 1 Hz is the fastest rate.
+ *             The FIFO is circular: left undrained for more than 32 periods
+ *             it keeps the newest samples and drainBatch() reports the rest
+ *             as lost.
+ *
+ * @param[in]  period_log2  0 (every second) to
+ *                          MPL3115A2_BATCH_PERIOD_LOG2_MAX (about 9 hours).
+ *
+ * @return     false if the period is out of range.
+ */
+bool MPL3115A2::startBatch( uint8_t period_log2 )
+{
+	if ( period_log2 > MPL3115A2_BATCH_PERIOD_LOG2_MAX ) {
+		return false;
+	}
+	start_auto( MPL3115A2_AUTO_BATCH, period_log2, MPL3115A2_F_SETUP_CIRCULAR, 0 );
+	return true;
+}
+
+/**
+ * @brief      Reads the samples queued since the last drain, oldest first:
+ *             an F_STATUS read, then the FIFO in bursts of up to
+ *             MPL3115A2_DRAIN_CHUNK samples.
+ *
+ * @details    The device does not stamp its samples.  The first is taken one
+ *             conversion time after startBatch() and one period apart from
+ *             there, so each is stamped from its place in the sequence.
+ *             After an overflow the newest sample is placed by the clock.
+ *
+ * @param[out] samples      filled with up to max_samples samples.
+ * @param[in]  max_samples  room in samples; any more stay queued.
+ * @param[out] lost         samples the FIFO dropped since the last drain,
+ *                          may be 0.
+ *
+ * @return     number of samples filled in.
+ */
+uint8_t MPL3115A2::drainBatch( MPL3115A2_SAMPLE_T *samples, uint8_t max_samples, uint16_t *lost )
+{
+	uint16_t dropped = 0;
+	uint8_t count = 0;
+
+	if ( MPL3115A2_AUTO_BATCH == auto_state ) {
+		uint8_t fsta = i2c_read( MPL3115A2_F_STATUS );
+		count = fsta & MPL3115A2_F_STATUS_CNT_MASK;
+
+		if ( fsta & MPL3115A2_F_STATUS_OVF ) {
+			uint32_t taken = auto_samples_taken();
+			uint32_t first = ( taken > count ) ? ( taken - count ) : 0;
+			if ( first > batch_next ) {
+				uint32_t gap = first - batch_next;
+				dropped = ( gap > 0xFFFF ) ? 0xFFFF : (uint16_t) gap;
+				batch_next = first;
+			}
+		}
+		if ( count > max_samples ) {
+			count = max_samples;
+		}
+
+		uint8_t done = 0;
+		while ( done < count ) {
+			uint8_t chunk = count - done;
+			uint8_t buf[MPL3115A2_DRAIN_CHUNK * MPL3115A2_SAMPLE_LEN];
+			if ( chunk > MPL3115A2_DRAIN_CHUNK ) {
+				chunk = MPL3115A2_DRAIN_CHUNK;
+			}
+			uint8_t len = chunk * MPL3115A2_SAMPLE_LEN;
+			if ( len != i2c_read_burst( MPL3115A2_F_DATA, buf, len ) ) {
+				break;
+			}
+			for ( uint8_t i = 0; i < chunk; i++ ) {
+				MPL3115A2_SAMPLE_T *s = &samples[done + i];
+				decode_sample( &buf[i * MPL3115A2_SAMPLE_LEN], s );
+				s->time_ms = auto_sample_ms( batch_next++ );
+			}
+			done += chunk;
+		}
+		count = done;
+	}
+	if ( lost ) {
+		*lost = dropped;
+	}
+	return count;
+}
+
+/**
+ * @brief      Leaves batch mode; the device goes back to standby and
+ *             one-shot conversions.  Samples still queued are discarded.
+ */
+void MPL3115A2::stopBatch( void )
+{
+	if ( MPL3115A2_AUTO_BATCH == auto_state ) {
+		stop_auto();
+	}
+}
+
+bool MPL3115A2::batchActive( void )
+{
+	return ( MPL3115A2_AUTO_BATCH == auto_state );
+}
+
+/**
+ * @brief      Time between samples in batch or event mode.
+ */
+uint32_t MPL3115A2::samplePeriod_ms( void )
+{
+	return 1000UL << auto_period_log2;
+}
+
+/**
+ * @brief      Puts the device into event mode: it converts on its own timer,
+ *             once every 2^period_log2 seconds, and raises SRC_PW or SRC_TW
+ *             when a result crosses the edge of the window around the value
+ *             last published.  Until then pollEvents() costs one INT_SOURCE
+ *             read.
+ *
+ * @details    The comparators work against a target in P_TGT/T_TGT and a
+ *             window in P_WND/T_WND, re-centred on each value published.
+ *             T_TGT holds whole degrees and P_TGT 2 Pa steps, so a flag can
+ *             come a little early; pollEvents() checks each one against the
+ *             published values before it reports it.  A flag marks a
+ *             crossing, not a level: a result still outside the device's
+ *             window, or one just re-centred on, gets no further flag, so
+ *             pollEvents() reads the next sample itself in those cases.
+ *
+ * @param[in]  period_log2       0 (every second) to
+ *                               MPL3115A2_BATCH_PERIOD_LOG2_MAX.
+ * @param[in]  pressure_window   change reported, in Pa in barometer mode
+ *                               (2 Pa steps) or m in altimeter mode.
+ * @param[in]  temp_window_c     change reported, in whole degrees C.
+ *
+ * @return     false if the period is out of range or a window is 0.
+ */
+bool MPL3115A2::startEvents( uint8_t period_log2, uint16_t pressure_window,
+							 uint8_t temp_window_c )
+{
+	if ( ( period_log2 > MPL3115A2_BATCH_PERIOD_LOG2_MAX ) ||
+		 ( 0 == pressure_window ) || ( 0 == temp_window_c ) ) {
+		return false;
+	}
+
+	uint16_t p_wnd = pressure_window;
+	if ( MPL3115A2_CTRL_REG1_ALT == device_mode ) {
+		events_p_window = (uint32_t) pressure_window * 16;
 	}
 	else {
-		temp = -999;
+		/* P_WND counts 2 Pa */
+		p_wnd = ( pressure_window + 1 ) / 2;
+		events_p_window = (uint32_t) p_wnd * 8;
 	}
-	
-	return temp;
+	events_t_window_c100 = (int16_t) temp_window_c * 100;
+	events_primed = false;
+	events_follow_up = false;
+
+	Wire.beginTransmission( MPL3115A2_ADDRESS );
+	Wire.write( MPL3115A2_P_WND_MSB );
+	Wire.write( (uint8_t) ( p_wnd >> 8 ) );
+	Wire.write( (uint8_t) p_wnd );
+	Wire.write( temp_window_c );
+	Wire.endTransmission();
+
+	start_auto( MPL3115A2_AUTO_EVENTS, period_log2, MPL3115A2_F_SETUP_OFF,
+				MPL3115A2_CTRL_REG4_INT_EN_PW | MPL3115A2_CTRL_REG4_INT_EN_TW );
+	return true;
+}
+
+/**
+ * @brief      true if a and b are further apart than window.
+ */
+static bool outside( int32_t a, int32_t b, int32_t window )
+{
+	int32_t d = a - b;
+	return ( d > window ) || ( -d > window );
+}
+
+/**
+ * @brief      Checks for a change worth publishing.  The first call after
+ *             the first sample always publishes, to set the baseline.
+ *
+ * @param[out] sample  the newest sample - valid if the return is not 0.
+ *
+ * @return     MPL3115A2_EVENT_PRESSURE and/or MPL3115A2_EVENT_TEMPERATURE
+ *             for what moved outside its window, 0 for nothing to publish.
+ */
+uint8_t MPL3115A2::pollEvents( MPL3115A2_SAMPLE_T *sample )
+{
+	uint8_t events = 0;
+
+	if ( MPL3115A2_AUTO_EVENTS != auto_state ) {
+		return 0;
+	}
+	uint32_t taken = auto_samples_taken();
+	if ( 0 == taken ) {
+		return 0;
+	}
+	if ( events_primed && !events_follow_up ) {
+		uint8_t src = i2c_read( MPL3115A2_INT_SOURCE );
+		if ( 0 == ( src & ( MPL3115A2_INT_SOURCE_SRC_PW | MPL3115A2_INT_SOURCE_SRC_TW ) ) ) {
+			return 0;
+		}
+	}
+
+	/* reading OUT_P and OUT_T clears the flags */
+	uint8_t burst[MPL3115A2_BURST_LEN];
+	MPL3115A2_SAMPLE_T now;
+	if ( MPL3115A2_BURST_LEN != i2c_read_burst( MPL3115A2_REGISTER_STATUS,
+												burst, MPL3115A2_BURST_LEN ) ) {
+		return 0;
+	}
+	decode_sample( &burst[1], &now );
+	now.time_ms = auto_sample_ms( taken - 1 );
+
+	if ( !events_primed ) {
+		events = MPL3115A2_EVENT_PRESSURE | MPL3115A2_EVENT_TEMPERATURE;
+	}
+	else {
+		if ( outside( now.pressure, events_last.pressure, events_p_window ) ) {
+			events |= MPL3115A2_EVENT_PRESSURE;
+		}
+		if ( outside( now.temp_c100, events_last.temp_c100, events_t_window_c100 ) ) {
+			events |= MPL3115A2_EVENT_TEMPERATURE;
+		}
+	}
+	if ( events ) {
+		int32_t p_tgt;
+		int8_t t_tgt = (int8_t) units_div_round( now.temp_c100, 100 );
+		if ( MPL3115A2_CTRL_REG1_ALT == auto_mode ) {
+			p_tgt = units_div_round( (int32_t) now.pressure, 16 );
+			events_p_target = p_tgt * 16;
+		}
+		else {
+			p_tgt = (int32_t) ( ( now.pressure + 4 ) / 8 );
+			events_p_target = p_tgt * 8;
+		}
+		events_t_target_c100 = (int16_t) t_tgt * 100;
+
+		Wire.beginTransmission( MPL3115A2_ADDRESS );
+		Wire.write( MPL3115A2_P_TGT_MSB );
+		Wire.write( (uint8_t) ( p_tgt >> 8 ) );
+		Wire.write( (uint8_t) p_tgt );
+		Wire.write( (uint8_t) t_tgt );
+		Wire.endTransmission();
+
+		events_last = now;
+		events_primed = true;
+		*sample = now;
+	}
+	/* the device will not flag a result that stays outside its window */
+	events_follow_up = events ||
+		outside( now.pressure, events_p_target, events_p_window - 1 ) ||
+		outside( now.temp_c100, events_t_target_c100, events_t_window_c100 - 1 );
+	return events;
+}
+
+/**
+ * @brief      Leaves event mode for standby and one-shot conversions.
+ */
+void MPL3115A2::stopEvents( void )
+{
+	if ( MPL3115A2_AUTO_EVENTS == auto_state ) {
+		stop_auto();
+	}
+}
+
+/**
+ * @brief      true while the device is in event mode.
+ */
+bool MPL3115A2::eventsActive( void )
+{
+	return ( MPL3115A2_AUTO_EVENTS == auto_state );
+}
+
+/**
+ * @brief      Sets the oversampling ratio for the conversions started from
+ *             here on - one-shot, blocking or batch/event mode.  A running
+ *             conversion or auto mode keeps the ratio it started with.
+ *
+ * @details    Each step doubles the samples averaged: about twice the
+ *             conversion time (conversionTime_ms()) for about 1/sqrt(2) of
+ *             the noise.  OS1 converts in 6 ms for quick looks at a gust
+ *             front, OS128 in 512 ms for the barometer report.
+ */
+void MPL3115A2::setOversampling( MPL3115A2_OVERSAMPLE_T os )
+{
+	oversample = ( os > MPL3115A2_OS128 ) ? MPL3115A2_OS128 : os;
+}
+
+MPL3115A2_OVERSAMPLE_T MPL3115A2::getOversampling( void )
+{
+	return oversample;
+}
+
+/**
+ * @brief      The time a conversion at the given ratio takes.
+ */
+uint16_t MPL3115A2::conversionTime_ms( MPL3115A2_OVERSAMPLE_T os )
+{
+	if ( os > MPL3115A2_OS128 ) {
+		os = MPL3115A2_OS128;
+	}
+	return pgm_read_word( &mpl3115a2_conv_time_ms[os] );
+}
+
+/**
+ * @brief      CTRL_REG1 OS field for a ratio.
+ */
+uint8_t MPL3115A2::os_bits( MPL3115A2_OVERSAMPLE_T os )
+{
+	return (uint8_t) ( os << MPL3115A2_CTRL_REG1_OS_SHIFT );
+}
+
+/**
+ * @brief      STATUS poll interval for a late conversion - an eighth of the
+ *             conversion time, up to MPL3115A2_POLL_MS.
+ */
+uint16_t MPL3115A2::poll_ms( MPL3115A2_OVERSAMPLE_T os )
+{
+	uint16_t ms = conversionTime_ms( os ) / 8;
+	if ( ms > MPL3115A2_POLL_MS ) {
+		ms = MPL3115A2_POLL_MS;
+	}
+	return ( ms ) ? ms : 1;
 }
 
 void MPL3115A2::setAltitude_Mode( void ) {
@@ -43,6 +43,71 @@
 #define MPL3115A2_CTRL_REG1_ALT                 (0x80)
 #define MPL3115A2_CTRL_REG1_BAR                 (0x00)
 
+/* samples the FIFO holds in batch mode */
+#define MPL3115A2_FIFO_DEPTH                    (32)
+/* slowest batch rate, one sample every 2^15 s */
+#define MPL3115A2_BATCH_PERIOD_LOG2_MAX         (15)
+
+/** @brief      One-shot conversion state. */
+typedef enum MPL3115A2_CONV_STATE
+{
+	MPL3115A2_CONV_IDLE,
+	MPL3115A2_CONV_BUSY,
+	MPL3115A2_CONV_READY,
+	MPL3115A2_CONV_ERROR
+} MPL3115A2_CONV_STATE_T;
+
+/**
+ * @brief      Oversampling ratio - 2^n samples averaged per conversion.
+ *
+ *             | ratio | conversion | pressure noise |
+ *             |-------|------------|----------------|
+ *             | OS1   |   6 ms     | 17 Pa RMS      |
+ *             | OS2   |  10 ms     | 12 Pa          |
+ *             | OS4   |  18 ms     | 8.5 Pa         |
+ *             | OS8   |  34 ms     | 6.0 Pa         |
+ *             | OS16  |  66 ms     | 4.2 Pa         |
+ *             | OS32  | 130 ms     | 3.0 Pa         |
+ *             | OS64  | 258 ms     | 2.1 Pa         |
+ *             | OS128 | 512 ms     | 1.5 Pa         |
+ *
+ *             Conversion times are the datasheet minimum time between
+ *             samples; the noise is the datasheet 1.5 Pa at OS128 scaled by
+ *             the square root of the samples averaged, as the host model
+ *             has it (host/bench_mpl measures it).
+ */
+typedef enum MPL3115A2_OVERSAMPLE
+{
+	MPL3115A2_OS1,
+	MPL3115A2_OS2,
+	MPL3115A2_OS4,
+	MPL3115A2_OS8,
+	MPL3115A2_OS16,
+	MPL3115A2_OS32,
+	MPL3115A2_OS64,
+	MPL3115A2_OS128
+} MPL3115A2_OVERSAMPLE_T;
+
+/** @brief      What the device is doing on its own timer. */
+typedef enum MPL3115A2_AUTO
+{
+	MPL3115A2_AUTO_OFF,
+	MPL3115A2_AUTO_BATCH,
+	MPL3115A2_AUTO_EVENTS
+} MPL3115A2_AUTO_T;
+
+/* pollEvents() result bits */
+#define MPL3115A2_EVENT_PRESSURE                (0x01)
+#define MPL3115A2_EVENT_TEMPERATURE             (0x02)
+
+/** @brief      A sample drained in batch mode or published in event mode. */
+typedef struct MPL3115A2_SAMPLE
+{
+	uint32_t time_ms;       /* millis() when the device took it */
+	uint32_t pressure;      /* as collectPressure() or collectAltitude() */
+	int16_t temp_c100;
+} MPL3115A2_SAMPLE_T;
+
 #if 1
 class MPL3115A2 {
 public:
@@ -56,11 +121,62 @@ public:
 	float getFloatPressure( void );
 	float getPressure_InHg( void );
 	float getPressure_Pa( void );
+	bool startConversion( void );
+	bool conversionReady( void );
+	MPL3115A2_CONV_STATE_T conversionState( void );
+	bool collectPressure( uint32_t* pressure );
+	bool collectAltitude( uint32_t* altitude );
+	bool collectTemperature( float* temperature );
+	bool collectTemperature_c100( int16_t *c100 );
+	bool startBatch( uint8_t period_log2 );
+	uint8_t drainBatch( MPL3115A2_SAMPLE_T *samples, uint8_t max_samples, uint16_t *lost );
+	void stopBatch( void );
+	bool batchActive( void );
+	uint32_t samplePeriod_ms( void );
+	bool startEvents( uint8_t period_log2, uint16_t pressure_window, uint8_t temp_window_c );
+	uint8_t pollEvents( MPL3115A2_SAMPLE_T *sample );
+	void stopEvents( void );
+	bool eventsActive( void );
+	void setOversampling( MPL3115A2_OVERSAMPLE_T os );
+	MPL3115A2_OVERSAMPLE_T getOversampling( void );
+	static uint16_t conversionTime_ms( MPL3115A2_OVERSAMPLE_T os );
 private:
+	static uint8_t os_bits( MPL3115A2_OVERSAMPLE_T os );
+	static uint16_t poll_ms( MPL3115A2_OVERSAMPLE_T os );
 	uint8_t i2c_read( uint8_t read_register );
+	uint8_t i2c_read_burst( uint8_t first_register, uint8_t *data, uint8_t len );
 	void i2c_write( uint8_t reg_addr, uint8_t value );
 	void set_device_mode ( uint8_t mode );
+	void decode_conversion( const uint8_t *burst );
+	void start_auto( MPL3115A2_AUTO_T state, uint8_t period_log2, uint8_t f_setup,
+					 uint8_t int_enable );
+	void stop_auto( void );
+	uint32_t auto_samples_taken( void );
+	uint32_t auto_sample_ms( uint32_t index );
+	void decode_sample( const uint8_t *out, MPL3115A2_SAMPLE_T *sample );
+	bool wait_conversion( uint8_t mode );
 	uint8_t device_mode;
+	MPL3115A2_CONV_STATE_T conv_state;
+	uint8_t conv_mode;
+	uint32_t conv_start_ms;
+	uint32_t conv_p_raw;
+	uint16_t conv_t_raw;
+	bool conv_poll_status;
+	MPL3115A2_OVERSAMPLE_T oversample;
+	MPL3115A2_OVERSAMPLE_T conv_os;
+	MPL3115A2_OVERSAMPLE_T auto_os;
+	MPL3115A2_AUTO_T auto_state;
+	uint8_t auto_mode;
+	uint8_t auto_period_log2;
+	uint32_t auto_start_ms;
+	uint32_t batch_next;
+	bool events_primed;
+	bool events_follow_up;
+	uint32_t events_p_window;
+	int16_t events_t_window_c100;
+	int32_t events_p_target;
+	int16_t events_t_target_c100;
+	MPL3115A2_SAMPLE_T events_last;
 };
 #endif
 #endif
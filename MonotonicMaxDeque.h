@@ -0,0 +1,92 @@
+/*-----------------------------------------------*/
+/** @addtogroup WSA80422_device Argent Weather Sensor Assembly
+ * @{
+ *
+ * @file MonotonicMaxDeque.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Sliding window maximum over the last N samples.
+ *
+ * @details    The deque only keeps samples that could still become the
+ *             maximum: a new sample evicts every older one that is not
+ *             larger, so the values run strictly decreasing from front to
+ *             back and the front is the window maximum.  Each sample is
+ *             pushed and popped at most once, so push() is O(1) amortized
+ *             and max() is O(1).  A small tag (e.g. the wind direction)
+ *             travels with each sample so the caller knows where the maximum
+ *             came from.  Ties resolve to the most recent sample.
+ *
+ *             Entries are 3 bytes for an 8 bit value; the worst case
+ *             (strictly falling input) needs all N of them.
+ *
+ * @tparam     T      sample type.
+ * @tparam     N      window length in samples, at most 255.
+ */
+
+#ifndef MONOTONIC_MAX_DEQUE_H
+#define MONOTONIC_MAX_DEQUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+template <typename T, uint8_t N>
+class MonotonicMaxDeque {
+public:
+	MonotonicMaxDeque() { clear(); }
+
+	void clear( void ) {
+		front = 0;
+		num = 0;
+		next_seq = 0;
+	}
+
+	/** @brief Adds the newest sample and expires the one leaving the window. */
+	void push( T value, uint8_t tag ) {
+		uint8_t seq = next_seq++;
+
+		while ( num && ( (uint8_t) ( seq - entry[front].seq ) >= N ) ) {
+			front = next_index( front );
+			num--;
+		}
+		while ( num && ( entry[back_index()].value <= value ) ) {
+			num--;
+		}
+
+		uint8_t idx = ( front + num ) % N;
+		entry[idx].value = value;
+		entry[idx].tag = tag;
+		entry[idx].seq = seq;
+		num++;
+	}
+
+	bool empty( void ) const { return 0 == num; }
+
+	/** @brief Largest sample in the window, 0 if empty. */
+	T max( void ) const { return num ? entry[front].value : 0; }
+
+	/** @brief Tag pushed with the largest sample, 0 if empty. */
+	uint8_t maxTag( void ) const { return num ? entry[front].tag : 0; }
+
+	/** @brief How many pushes ago the maximum arrived (0 = newest). */
+	uint8_t maxAge( void ) const { return num ? (uint8_t) ( next_seq - 1 - entry[front].seq ) : 0; }
+
+private:
+	struct Entry {
+		T value;
+		uint8_t tag;
+		uint8_t seq;
+	};
+
+	static uint8_t next_index( uint8_t i ) { return ( i + 1 == N ) ? 0 : i + 1; }
+	uint8_t back_index( void ) const { return ( front + num - 1 ) % N; }
+
+	Entry entry[N];
+	uint8_t front;
+	uint8_t num;
+	uint8_t next_seq;
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,119 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file PowerSave.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include <avr/sleep.h>
+#include "PowerSave.h"
+
+PowerSave::PowerSave() {
+	woken = false;
+	resetStats();
+}
+
+/**
+ * @brief      Sleeps for up to us microseconds - call at the end of loop()
+ *             with the time to the next thing it has to do.
+ *
+ * @param[in]  us    longest sleep, micros().
+ *
+ * @return     true if the sleep ran to within a tick of us, false if it
+ *             was cut short or too short to take.
+ */
+bool PowerSave::sleepUntil( uint32_t us ) {
+	bool early = false;
+	uint16_t legs = 0;
+
+	if ( us <= POWER_TICK_US ) {
+		return false;
+	}
+	uint32_t start = micros();
+	us -= POWER_TICK_US;
+
+	set_sleep_mode( SLEEP_MODE_IDLE );
+	for ( ;; ) {
+		if ( ( micros() - start ) >= us ) {
+			noInterrupts();
+			break;
+		}
+		noInterrupts();
+		/* anything after this check wakes the sleep below */
+		if ( woken || ( Serial.available() > 0 ) ) {
+			early = true;
+			break;
+		}
+		sleep_enable();
+		interrupts();
+		sleep_cpu();
+		sleep_disable();
+		legs++;
+	}
+	woken = false;
+	interrupts();
+
+	uint32_t slept = micros() - start;
+	uint32_t busy = (uint32_t) legs * POWER_WAKE_US;
+	slept = ( slept > busy ) ? slept - busy : 0;
+	asleep_ms += slept / 1000;
+	asleep_rem_us += (uint16_t) ( slept % 1000 );
+	if ( asleep_rem_us >= 1000 ) {
+		asleep_rem_us -= 1000;
+		asleep_ms++;
+	}
+	sleeps++;
+	wakes += legs;
+	if ( early ) {
+		early_wakes++;
+	}
+	return !early;
+}
+
+/**
+ * @brief      Ends the sleep under way - call from a pulse ISR.
+ */
+void PowerSave::wake( void ) {
+	woken = true;
+}
+
+void PowerSave::resetStats( void ) {
+	start_ms = millis();
+	asleep_ms = 0;
+	asleep_rem_us = 0;
+	sleeps = 0;
+	early_wakes = 0;
+	wakes = 0;
+}
+
+void PowerSave::getStats( POWER_STATS_T *stats ) {
+	stats->sleeps = sleeps;
+	stats->early_wakes = early_wakes;
+	stats->wakes = wakes;
+	stats->asleep_ms = asleep_ms;
+	stats->elapsed_ms = millis() - start_ms;
+}
+
+/**
+ * @brief      Share of the time since resetStats() spent awake, in tenths
+ *             of a percent.
+ */
+uint16_t PowerSave::awakePermille( void ) {
+	uint32_t elapsed = millis() - start_ms;
+	uint32_t asleep = ( asleep_ms > elapsed ) ? elapsed : asleep_ms;
+	uint32_t awake = elapsed - asleep;
+
+	if ( 0 == elapsed ) {
+		return 1000;
+	}
+	/* keep awake x 1000 inside 32 bits */
+	while ( elapsed > 4000000UL ) {
+		elapsed >>= 1;
+		awake >>= 1;
+	}
+	return (uint16_t) ( ( awake * 1000UL + elapsed / 2 ) / elapsed );
+}
+
+/** @} end of addtogroup */
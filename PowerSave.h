@@ -0,0 +1,85 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file PowerSave.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Puts the MCU to sleep between events and keeps count of how
+ *             much of the time it was awake.
+ *
+ * @details    sleepUntil() idles the core until a deadline - the next
+ *             scheduler tick or sensor conversion - while the timers, the
+ *             UART and the external interrupts keep running.  Idle rather
+ *             than power-down: power-down stops timer0, so millis() and
+ *             micros() would stand still and every deadline and pulse
+ *             timestamp would be wrong, and INT0/INT1 only wake it on a low
+ *             level, not the falling edge the pulse inputs use.
+ *
+ *             The core wakes on every timer0 overflow (1.024 ms) and goes
+ *             straight back to sleep unless the deadline is less than one
+ *             overflow away - the rest is left to loop() so the scheduler
+ *             keeps its sub-millisecond timing.  A pulse ISR that calls
+ *             wake(), or a byte arriving on the serial port, ends the sleep
+ *             at once so the pulse rings are drained long before they can
+ *             fill.  An edge that lands between the check and the sleep
+ *             instruction still wakes it - interrupts are only enabled by
+ *             the instruction before it.
+ *
+ *             Time spent asleep is measured with micros() and counted
+ *             against the time since resetStats() to give the awake share
+ *             of the run.  Each wake-up inside a sleep - its ISR and the
+ *             pass back to the sleep instruction - is charged as awake at
+ *             POWER_WAKE_US, as micros() cannot tell it from the sleep
+ *             around it.  At calm it is most of the awake time.
+ */
+
+#ifndef POWER_SAVE_H
+#define POWER_SAVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Arduino.h"
+
+/* @brief      timer0 overflow period at 16 MHz - an idle core wakes this
+ *             often, so a sleep ends up to this late.  Sleeps stop one
+ *             period short of the deadline and shorter waits are not slept */
+#define POWER_TICK_US 1024
+
+/* @brief      Awake time of one wake-up inside a sleep: the ISR that woke
+ *             the core and a pass of the loop with its micros() call, about
+ *             100 cycles at 16 MHz */
+#define POWER_WAKE_US 6
+
+/* @brief      Sleep statistics since resetStats() */
+typedef struct POWER_STATS
+{
+	uint32_t sleeps;        /* sleepUntil() calls that slept */
+	uint32_t early_wakes;   /* cut short by a pulse or serial input */
+	uint32_t wakes;         /* wake-ups inside the sleeps, charged as awake */
+	uint32_t asleep_ms;
+	uint32_t elapsed_ms;
+} POWER_STATS_T;
+
+class PowerSave {
+public:
+	PowerSave();
+	bool sleepUntil( uint32_t us );
+	void wake( void );
+	void resetStats( void );
+	void getStats( POWER_STATS_T *stats );
+	uint16_t awakePermille( void );
+private:
+	volatile bool woken;
+	uint32_t start_ms;
+	uint32_t asleep_ms;
+	uint16_t asleep_rem_us;
+	uint32_t sleeps;
+	uint32_t early_wakes;
+	uint32_t wakes;
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,177 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Profile.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "Profile.h"
+
+/* longest region name, with its terminator */
+#define PROFILE_NAME_LEN    (12)
+
+/* region names for the dump, in PROFILE_REGION_T order */
+static const char profile_region_name[PROFILE_NUM_REGIONS][PROFILE_NAME_LEN] PROGMEM = {
+	"loop",
+	"isr_wind",
+	"isr_rain",
+	"pulses",
+	"acquire",
+	"log",
+	"task_wind",
+	"task_rain",
+	"task_report",
+	"late_wind"
+};
+
+static_assert( PROFILE_NUM_SLOTS > 0, "PROFILE_REGIONS selects no region" );
+
+/* the recorded regions only, in PROFILE_REGION_T order */
+static PROFILE_STATS_T profile_stats[PROFILE_NUM_SLOTS];
+static uint8_t profile_dump_pos = PROFILE_NUM_REGIONS;
+
+/**
+ * @brief      Records one time in a region's slot - safe from an ISR, as
+ *             long as a region is only recorded from one context.
+ *             PROFILE_SCOPE() and PROFILE_ADD() pick the slot, and drop the
+ *             regions PROFILE_REGIONS leaves out.
+ */
+void profile_record( uint8_t slot, uint32_t us ) {
+	if ( slot >= PROFILE_NUM_SLOTS ) {
+		return;
+	}
+	PROFILE_STATS_T *st = &profile_stats[slot];
+	if ( ( 0 == st->count ) || ( us < st->min_us ) ) {
+		st->min_us = us;
+	}
+	if ( us > st->max_us ) {
+		st->max_us = us;
+	}
+	if ( st->count < 0xFFFFFFFFUL ) {
+		st->count++;
+	}
+	st->sum_us = ( st->sum_us + us < st->sum_us ) ? 0xFFFFFFFFUL : st->sum_us + us;
+	uint8_t *bin = &st->hist[profile_bin( us )];
+	if ( *bin < 0xFF ) {
+		( *bin )++;
+	}
+}
+
+/**
+ * @brief      Histogram bin of a time - floor(log2(us)), 0 for 0 and 1 us,
+ *             the last bin for anything longer.
+ */
+uint8_t profile_bin( uint32_t us ) {
+	uint8_t bin = 0;
+	while ( ( us >>= 1 ) && ( bin < PROFILE_HIST_BINS - 1 ) ) {
+		bin++;
+	}
+	return bin;
+}
+
+void profile_reset( void ) {
+	noInterrupts();
+	memset( profile_stats, 0, sizeof( profile_stats ) );
+	interrupts();
+}
+
+/**
+ * @brief      Copies out a region's statistics.
+ *
+ * @return     false for an unknown region, or one that is not recorded.
+ */
+bool profile_get( uint8_t region, PROFILE_STATS_T *stats ) {
+	if ( !profile_recorded( region ) ) {
+		return false;
+	}
+	/* the ISR regions may be written meanwhile */
+	noInterrupts();
+	*stats = profile_stats[profile_slot( region )];
+	interrupts();
+	return true;
+}
+
+/**
+ * @brief      Moves the dump on to the next recorded region at or after
+ *             pos.
+ */
+static void profile_dump_seek( uint8_t pos ) {
+	while ( ( pos < PROFILE_NUM_REGIONS ) && !profile_recorded( pos ) ) {
+		pos++;
+	}
+	profile_dump_pos = pos;
+}
+
+/**
+ * @brief      Starts a dump of every recorded region - see
+ *             profile_dump_next().
+ */
+void profile_dump_start( void ) {
+	profile_dump_seek( 0 );
+}
+
+/**
+ * @brief      A dump has regions left to print.
+ */
+bool profile_dumping( void ) {
+	return profile_dump_pos < PROFILE_NUM_REGIONS;
+}
+
+/**
+ * @brief      Prints the next region of a dump and clears it, so the next
+ *             dump covers the time since.  One line:
+ *
+ *             P <name> n=<count> min=<us> mean=<us> max=<us> h=<bin>:<count>,...
+ *
+ *             with only the bins that counted anything.  A region with no
+ *             times prints its name and n=0.
+ *
+ * @return     false once the dump is over.
+ */
+bool profile_dump_next( Print *out ) {
+	PROFILE_STATS_T st;
+	char c;
+
+	if ( profile_dump_pos >= PROFILE_NUM_REGIONS ) {
+		return false;
+	}
+	uint8_t region = profile_dump_pos;
+	uint8_t slot = profile_slot( region );
+	profile_dump_seek( region + 1 );
+	noInterrupts();
+	st = profile_stats[slot];
+	memset( &profile_stats[slot], 0, sizeof( PROFILE_STATS_T ) );
+	interrupts();
+
+	out->print( F( "P " ) );
+	for ( uint8_t i = 0; ( c = (char) pgm_read_byte( &profile_region_name[region][i] ) ); i++ ) {
+		out->print( c );
+	}
+	out->print( F( " n=" ) );
+	out->print( (unsigned long) st.count );
+	if ( st.count ) {
+		out->print( F( " min=" ) );
+		out->print( (unsigned long) st.min_us );
+		out->print( F( " mean=" ) );
+		out->print( (unsigned long) ( st.sum_us / st.count ) );
+		out->print( F( " max=" ) );
+		out->print( (unsigned long) st.max_us );
+		char sep = '=';
+		out->print( F( " h" ) );
+		for ( uint8_t i = 0; i < PROFILE_HIST_BINS; i++ ) {
+			if ( st.hist[i] ) {
+				out->print( sep );
+				out->print( i );
+				out->print( ':' );
+				out->print( (unsigned int) st.hist[i] );
+				sep = ',';
+			}
+		}
+	}
+	out->println();
+	return true;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,151 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Profile.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Timing of named hot paths - the ISRs, the driver calls, the
+ *             scheduler tasks and how late their ticks fire.
+ *
+ * @details    Each region keeps a count, the minimum, maximum and sum of
+ *             its times in micros() and a log2 histogram: bin k counts the
+ *             times from 2^k up to 2^(k+1) us, bin 0 takes anything under
+ *             2 us and the last bin everything from 2^(PROFILE_HIST_BINS-1)
+ *             up.  The bins saturate at 255.  PROFILE_SCOPE() times the
+ *             rest of the block it opens, PROFILE_ADD() records a time
+ *             measured elsewhere, such as a scheduler tick's lateness.
+ *
+ *             Build with PROFILE_ENABLE set to 1 to compile the recording
+ *             in - 28 bytes of RAM and two micros() calls for each region
+ *             PROFILE_REGIONS selects.  The regions it leaves out compile
+ *             to nothing.  At 0 (the default) the macros are empty,
+ *             nothing calls into Profile.cpp and the linker drops it.
+ *             micros() steps 4 us on a 16 MHz AVR; the host simulation
+ *             runs the same code against its virtual clock.
+ *
+ *             profile_dump_start() and profile_dump_next() print the regions
+ *             as text, one line a call, so a dump never holds loop() up for
+ *             more than a line.  Each region is cleared as it is printed,
+ *             so a dump covers the time since the one before.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Arduino.h"
+
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE 0
+#endif
+
+/* @brief      Histogram bins - the last one takes 2048 us and up */
+#define PROFILE_HIST_BINS 12
+
+/* @brief      The regions, in the order of profile_region_name[] */
+typedef enum PROFILE_REGION
+{
+	PROF_LOOP,          /* a loop() pass, less its sleep */
+	PROF_ISR_WIND,      /* anemometer ISR */
+	PROF_ISR_RAIN,      /* rain gauge ISR */
+	PROF_PULSES,        /* WSA80422::service_pulses() */
+	PROF_ACQ,           /* HTU21D and MPL3115A2 bus work and publishing */
+	PROF_LOG,           /* EEPROM log writing */
+	PROF_TASK_WIND,     /* 1 s wind calculations */
+	PROF_TASK_RAIN,     /* 60 s rain calculations, log and minute report */
+	PROF_TASK_REPORT,   /* 5 s report, telemetry frame or text */
+	PROF_LATE_WIND,     /* how late the 1 s tick ran */
+	PROFILE_NUM_REGIONS
+} PROFILE_REGION_T;
+
+/* @brief      One region's statistics, us */
+typedef struct PROFILE_STATS
+{
+	uint32_t count;
+	uint32_t sum_us;                    /* saturates */
+	uint32_t min_us;
+	uint32_t max_us;
+	uint8_t hist[PROFILE_HIST_BINS];    /* saturate */
+} PROFILE_STATS_T;
+
+#define PROFILE_BIT( region )           ( 1U << ( region ) )
+
+/* @brief      Regions recorded, one PROFILE_BIT() each - the loop pass and
+ *             the 1 s tick's lateness unless the build picks others.  Set
+ *             it for the whole build, Profile.cpp sizes its table from it.
+ *             Each region costs 28 bytes, and the sketch's SRAM budget has
+ *             room for two. */
+#ifndef PROFILE_REGIONS
+#define PROFILE_REGIONS                 ( PROFILE_BIT( PROF_LOOP ) | PROFILE_BIT( PROF_LATE_WIND ) )
+#endif
+
+static inline constexpr uint8_t profile_bit_count( uint16_t bits ) {
+	return bits ? (uint8_t) ( ( bits & 1 ) + profile_bit_count( bits >> 1 ) ) : 0;
+}
+
+/* @brief      Whether a region is recorded */
+static inline constexpr bool profile_recorded( uint8_t region ) {
+	return ( region < PROFILE_NUM_REGIONS ) && ( ( PROFILE_REGIONS >> region ) & 1 );
+}
+
+/* @brief      A recorded region's place in the statistics table */
+static inline constexpr uint8_t profile_slot( uint8_t region ) {
+	return profile_bit_count( PROFILE_REGIONS & ( PROFILE_BIT( region ) - 1 ) );
+}
+
+#define PROFILE_NUM_SLOTS               profile_bit_count( PROFILE_REGIONS & ( PROFILE_BIT( PROFILE_NUM_REGIONS ) - 1 ) )
+
+/* @brief      RAM Profile.cpp takes once it is linked in, and in this
+ *             build - none unless PROFILE_ENABLE */
+#define PROFILE_LINKED_RAM_BYTES ( PROFILE_NUM_SLOTS * sizeof( PROFILE_STATS_T ) + 1 )
+#if PROFILE_ENABLE
+#define PROFILE_RAM_BYTES PROFILE_LINKED_RAM_BYTES
+#else
+#define PROFILE_RAM_BYTES 0
+#endif
+
+void profile_record( uint8_t slot, uint32_t us );
+void profile_reset( void );
+bool profile_get( uint8_t region, PROFILE_STATS_T *stats );
+uint8_t profile_bin( uint32_t us );
+void profile_dump_start( void );
+bool profile_dump_next( Print *out );
+bool profile_dumping( void );
+
+/**
+ * @brief      Times from its construction to the end of the enclosing
+ *             block.
+ */
+template <uint8_t REGION, bool RECORDED = profile_recorded( REGION )>
+class ProfileScope {
+public:
+	ProfileScope() : start_us( micros() ) {}
+	~ProfileScope() { profile_record( profile_slot( REGION ), micros() - start_us ); }
+private:
+	uint32_t start_us;
+};
+
+/* a region left out - nothing to time */
+template <uint8_t REGION>
+class ProfileScope<REGION, false> {
+public:
+	ProfileScope() {}
+};
+
+#if PROFILE_ENABLE
+#define PROFILE_SCOPE( region )         ProfileScope<( region )> profile_scope
+#define PROFILE_ADD( region, us )       do { if ( profile_recorded( region ) ) { \
+                                             profile_record( profile_slot( region ), ( us ) ); } } while ( 0 )
+#define PROFILE_DUMPING()               profile_dumping()
+#else
+#define PROFILE_SCOPE( region )         do { } while ( 0 )
+#define PROFILE_ADD( region, us )       do { } while ( 0 )
+#define PROFILE_DUMPING()               ( false )
+#endif
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,104 @@
+/*-----------------------------------------------*/
+/** @addtogroup WSA80422_device Argent Weather Sensor Assembly
+ * @{
+ *
+ * @file PulseRing.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Lock-free single producer / single consumer ring of pulse
+ *             timestamps, filled from an ISR and drained from loop().
+ *
+ * @details    The ISR is the only writer of head and the main loop the only
+ *             writer of tail, and both are single bytes so every access is
+ *             atomic on the AVR.  The timestamp is stored before head is
+ *             advanced, so the consumer never sees a slot that is still being
+ *             written, and the consumer frees slots by moving tail once per
+ *             batch.  Neither side masks interrupts.
+ *
+ *             The indices run freely over 0-255 and are masked on use, which
+ *             is why N must be a power of two.  A push into a full ring is
+ *             dropped and counted.
+ *
+ * @tparam     N      slots, a power of two no larger than 128.
+ */
+
+#ifndef PULSE_RING_H
+#define PULSE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+template <uint8_t N>
+class PulseRing {
+	static_assert( N && !( N & ( N - 1 ) ) && ( N <= 128 ), "N must be a power of two <= 128" );
+public:
+	PulseRing() { clear(); }
+
+	/** @brief Empties the ring - only while the producer is quiet. */
+	void clear( void ) {
+		head = 0;
+		tail = 0;
+		dropped = 0;
+	}
+
+	/**
+	 * @brief      Producer side, called from the ISR.
+	 *
+	 * @return     false if the ring was full and the stamp was dropped.
+	 */
+	bool push( uint32_t stamp_us ) {
+		uint8_t h = head;
+		if ( (uint8_t) ( h - tail ) >= N ) {
+			if ( dropped < 0xFFFF ) {
+				dropped++;
+			}
+			return false;
+		}
+		stamps[h & ( N - 1 )] = stamp_us;
+		head = h + 1;
+		return true;
+	}
+
+	/**
+	 * @brief      Consumer side - moves up to max stamps, oldest first, into
+	 *             out.
+	 *
+	 * @return     the number of stamps copied, 0 when empty.
+	 */
+	uint8_t pop( uint32_t *out, uint8_t max ) {
+		uint8_t t = tail;
+		uint8_t n = head - t;
+		if ( n > max ) {
+			n = max;
+		}
+		for ( uint8_t i = 0; i < n; i++ ) {
+			out[i] = stamps[(uint8_t) ( t + i ) & ( N - 1 )];
+		}
+		tail = t + n;
+		return n;
+	}
+
+	/** @brief Stamps waiting to be drained. */
+	uint8_t pending( void ) const { return head - tail; }
+
+	/** @brief Pushes lost to a full ring since clear(), saturating. */
+	uint16_t overflows( void ) const {
+		uint16_t n;
+		/* two byte value written by the ISR - read until stable */
+		do {
+			n = dropped;
+		} while ( n != dropped );
+		return n;
+	}
+
+private:
+	volatile uint32_t stamps[N];
+	volatile uint8_t head;
+	volatile uint8_t tail;
+	volatile uint16_t dropped;
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,94 @@
+/*-----------------------------------------------*/
+/** @addtogroup WSA80422_device Argent Weather Sensor Assembly
+ * @{
+ *
+ * @file RingAccumulator.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Fixed size sliding window with a running sum.
+ *
+ * @details    push() overwrites the oldest sample once the window is full
+ *             and keeps the sum up to date by subtracting what falls out, so
+ *             both push() and the sum/mean queries cost the same no matter
+ *             how long the window is.  cycleComplete() reports every Nth push,
+ *             which is how one window feeds the next coarser one (1 s -> 5 s,
+ *             1 min -> 1 hr, ...).
+ *
+ * @tparam     T      sample type.
+ * @tparam     N      window length in samples.
+ * @tparam     SUM_T  accumulator type, wide enough for N samples.
+ */
+
+#ifndef RING_ACCUMULATOR_H
+#define RING_ACCUMULATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+template <typename T, uint16_t N, typename SUM_T = int32_t>
+class RingAccumulator {
+public:
+	RingAccumulator() { clear(); }
+
+	/** @brief Empties the window. */
+	void clear( void ) {
+		for ( uint16_t i = 0; i < N; i++ ) {
+			buf[i] = 0;
+		}
+		total = 0;
+		head = 0;
+		num = 0;
+	}
+
+	/** @brief Adds the newest sample, dropping the oldest once full. */
+	void push( T value ) {
+		if ( num == N ) {
+			total -= buf[head];
+		}
+		else {
+			num++;
+		}
+		buf[head] = value;
+		total += value;
+		head = ( head + 1 == N ) ? 0 : head + 1;
+	}
+
+	/** @brief Sum of the samples in the window. */
+	SUM_T sum( void ) const { return total; }
+
+	/** @brief Mean of the samples in the window, 0 if empty. */
+	SUM_T mean( void ) const { return num ? ( total / (SUM_T) num ) : 0; }
+
+	/** @brief Number of samples held, at most N. */
+	uint16_t count( void ) const { return num; }
+
+	bool full( void ) const { return num == N; }
+
+	/** @brief True right after every Nth push since the last clear(). */
+	bool cycleComplete( void ) const { return ( 0 == head ) && ( num == N ); }
+
+	/** @brief The sample pushed age pushes ago (0 = newest). */
+	T at( uint16_t age ) const {
+		if ( age >= num ) {
+			return 0;
+		}
+		uint16_t idx = ( head + N - 1 - age ) % N;
+		return buf[idx];
+	}
+
+	/** @brief The most recent sample, 0 if empty. */
+	T newest( void ) const { return at( 0 ); }
+
+	static uint16_t capacity( void ) { return N; }
+
+private:
+	T buf[N];
+	SUM_T total;
+	uint16_t head;
+	uint16_t num;
+};
+
+#endif
+
+/** @} end of addtogroup */
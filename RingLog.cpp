@@ -0,0 +1,309 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file RingLog.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "RingLog.h"
+#include "cobs.h"
+#include "crc8.h"
+
+/* byte programs per record: the top seq byte is cleared first and written
+   again last, so the slot reads as empty until the record is complete */
+#define RINGLOG_WRITE_STEPS ( RINGLOG_RECORD_LEN + 1 )
+#define RINGLOG_COMMIT_BYTE 2
+
+static uint8_t write_step_byte( uint8_t step ) {
+	if ( ( 0 == step ) || ( RINGLOG_RECORD_LEN == step ) ) {
+		return RINGLOG_COMMIT_BYTE;
+	}
+	return ( step <= RINGLOG_COMMIT_BYTE ) ? step - 1 : step;
+}
+
+RingLog::RingLog() {
+	base_addr = 0;
+	slots = 0;
+	next_seq = 0;
+	pending_pos = RINGLOG_WRITE_STEPS;
+	pending_addr = 0;
+	pending_seq = 0;
+	dump_seq = RINGLOG_SEQ_LIMIT;
+}
+
+/**
+ * @brief      Takes over an area of the EEPROM and finds where the log left
+ *             off.  Reads the whole area, so call it once from setup().
+ *
+ * @param[in]  base   first byte of the area.
+ * @param[in]  len    bytes, rounded down to whole slots.
+ *
+ * @return     false if the area holds fewer than two slots.
+ */
+bool RingLog::begin( uint16_t base, uint16_t len ) {
+	uint8_t image[RINGLOG_RECORD_LEN];
+	RINGLOG_RECORD_T rec;
+	bool found = false;
+	uint32_t newest = 0;
+
+	base_addr = base;
+	slots = len / RINGLOG_RECORD_LEN;
+	pending_pos = RINGLOG_WRITE_STEPS;
+	dump_seq = RINGLOG_SEQ_LIMIT;
+	next_seq = 0;
+	if ( slots < 2 ) {
+		slots = 0;
+		return false;
+	}
+
+	for ( uint16_t i = 0; i < slots; i++ ) {
+		uint16_t addr = base_addr + i * RINGLOG_RECORD_LEN;
+		for ( uint8_t j = 0; j < RINGLOG_RECORD_LEN; j++ ) {
+			image[j] = EEPROM.read( addr + j );
+		}
+		/* a record sitting in the wrong slot is as good as damaged */
+		if ( !unpack( image, &rec ) || ( i != rec.seq % slots ) ) {
+			continue;
+		}
+		if ( !found || ( rec.seq > newest ) ) {
+			newest = rec.seq;
+			found = true;
+		}
+	}
+	next_seq = found ? newest + 1 : 0;
+	return true;
+}
+
+/**
+ * @brief      Queues a record for writing and gives it the next sequence
+ *             number.  The bytes go out from service().
+ *
+ * @param      rec   seq is filled in.
+ *
+ * @return     false if the previous record is still being written or the
+ *             log is not set up.
+ */
+bool RingLog::append( RINGLOG_RECORD_T *rec ) {
+	if ( !slots || busy() || ( next_seq >= RINGLOG_SEQ_LIMIT ) ) {
+		return false;
+	}
+	rec->seq = next_seq;
+	pack( rec, pending );
+	pending_seq = next_seq;
+	pending_addr = slot_addr( next_seq );
+	pending_pos = 0;
+	next_seq++;
+	service();
+	return true;
+}
+
+/**
+ * @brief      Programs the next byte of a queued record if the EEPROM is
+ *             idle - call from every pass of loop().  Bytes that are already
+ *             right cost a read and no write.
+ */
+void RingLog::service( void ) {
+	while ( ( pending_pos < RINGLOG_WRITE_STEPS ) && eeprom_is_ready() ) {
+		uint8_t i = write_step_byte( pending_pos );
+		EEPROM.update( pending_addr + i, ( 0 == pending_pos ) ? 0xFF : pending[i] );
+		pending_pos++;
+	}
+}
+
+/**
+ * @brief      A record is still being written.
+ */
+bool RingLog::busy( void ) {
+	return pending_pos < RINGLOG_WRITE_STEPS;
+}
+
+/**
+ * @brief      Records the log holds when full.
+ */
+uint16_t RingLog::capacity( void ) {
+	return slots;
+}
+
+/**
+ * @brief      Sequence number the next append() will use.
+ */
+uint32_t RingLog::nextSeq( void ) {
+	return next_seq;
+}
+
+/**
+ * @brief      Oldest sequence number still in the log, if it was written.
+ */
+uint32_t RingLog::oldestSeq( void ) {
+	return ( next_seq > slots ) ? next_seq - slots : 0;
+}
+
+/**
+ * @brief      Reads one record back, waiting for the EEPROM if a byte is
+ *             being programmed.
+ *
+ * @return     false if the record was overwritten, never written or
+ *             damaged.
+ */
+bool RingLog::read( uint32_t seq, RINGLOG_RECORD_T *rec ) {
+	uint8_t image[RINGLOG_RECORD_LEN];
+	return read_image( seq, image ) && unpack( image, rec );
+}
+
+/**
+ * @brief      Starts sending the log from seq since on - or from the oldest
+ *             record still held, if since has been overwritten.
+ */
+void RingLog::startDump( uint32_t since ) {
+	dump_seq = since;
+}
+
+/**
+ * @brief      There are records left to dump.  Records appended while a
+ *             dump runs are included.
+ */
+bool RingLog::dumping( void ) {
+	return dump_seq < next_seq;
+}
+
+/**
+ * @brief      Fetches the next record of a dump without waiting on the
+ *             EEPROM.  Missing or damaged records are skipped.
+ *
+ * @param[out] image  RINGLOG_RECORD_LEN bytes, as stored - see frame().
+ *
+ * @return     true if a record was fetched, false if the dump is over or
+ *             the EEPROM is busy (try again later).
+ */
+bool RingLog::dumpNext( uint8_t *image ) {
+	while ( dumping() ) {
+		if ( dump_seq < oldestSeq() ) {
+			dump_seq = oldestSeq();
+		}
+		bool from_ram = busy() && ( dump_seq == pending_seq );
+		if ( !from_ram && !eeprom_is_ready() ) {
+			return false;
+		}
+		if ( read_image( dump_seq++, image ) ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief      Packs a record into a slot image, CRC included.  Values that
+ *             do not fit are saturated.
+ */
+void RingLog::pack( const RINGLOG_RECORD_T *rec, uint8_t *image ) {
+	uint8_t valid = rec->valid & ( RINGLOG_VALID_HTU | RINGLOG_VALID_BARO | RINGLOG_VALID_VANE );
+	uint8_t gust_dir = 0;
+	uint16_t dir = ( rec->wind_dir < 360 ) ? rec->wind_dir : 0;
+	uint32_t pa = 0;
+
+	if ( ( valid & RINGLOG_VALID_VANE ) && ( rec->gust_dir < WDIR_NUM_BANDS ) ) {
+		gust_dir = (uint8_t) rec->gust_dir;
+	}
+	else {
+		valid &= (uint8_t) ~RINGLOG_VALID_VANE;
+	}
+	if ( rec->pressure_pa > RINGLOG_PRESSURE_BASE ) {
+		pa = rec->pressure_pa - RINGLOG_PRESSURE_BASE;
+		if ( pa > 0xFFFF ) {
+			pa = 0xFFFF;
+		}
+	}
+
+	image[0] = (uint8_t) rec->seq;
+	image[1] = (uint8_t) ( rec->seq >> 8 );
+	image[2] = (uint8_t) ( rec->seq >> 16 );
+	image[3] = (uint8_t) ( valid | ( ( dir >> 5 ) & 0x08 ) | ( gust_dir << 4 ) );
+	image[4] = (uint8_t) rec->wind_mph10;
+	image[5] = (uint8_t) ( rec->wind_mph10 >> 8 );
+	image[6] = (uint8_t) rec->gust_mph10;
+	image[7] = (uint8_t) ( rec->gust_mph10 >> 8 );
+	image[8] = (uint8_t) dir;
+	image[9] = rec->rain_tips;
+	image[10] = (uint8_t) rec->temp_c100;
+	image[11] = (uint8_t) ( (uint16_t) rec->temp_c100 >> 8 );
+	image[12] = rec->humidity_x2;
+	image[13] = (uint8_t) pa;
+	image[14] = (uint8_t) ( pa >> 8 );
+	image[15] = crc8( image, RINGLOG_RECORD_LEN - 1 );
+}
+
+/**
+ * @brief      Unpacks a slot image.
+ *
+ * @return     false for an erased or damaged slot.
+ */
+bool RingLog::unpack( const uint8_t *image, RINGLOG_RECORD_T *rec ) {
+	uint32_t seq = image[0] | ( (uint32_t) image[1] << 8 ) | ( (uint32_t) image[2] << 16 );
+
+	if ( ( seq >= RINGLOG_SEQ_LIMIT ) || !crc8_verify( image, RINGLOG_RECORD_LEN ) ) {
+		return false;
+	}
+	rec->seq = seq;
+	rec->valid = image[3] & 0x07;
+	rec->wind_mph10 = (uint16_t) ( image[4] | ( image[5] << 8 ) );
+	rec->gust_mph10 = (uint16_t) ( image[6] | ( image[7] << 8 ) );
+	rec->wind_dir = (uint16_t) ( image[8] | ( ( image[3] & 0x08 ) << 5 ) );
+	rec->gust_dir = ( rec->valid & RINGLOG_VALID_VANE ) ? (WINDDIR_T) ( image[3] >> 4 ) : WDIR_ERR;
+	rec->rain_tips = image[9];
+	rec->temp_c100 = (int16_t) ( image[10] | ( image[11] << 8 ) );
+	rec->humidity_x2 = image[12];
+	rec->pressure_pa = RINGLOG_PRESSURE_BASE + (uint16_t) ( image[13] | ( image[14] << 8 ) );
+	return true;
+}
+
+/**
+ * @brief      Builds the serial frame for a dumped record, framed like
+ *             telemetry: 0x00 | COBS( RINGLOG_FRAME_TAG | slot | CRC-8 ) | 0x00.
+ *
+ * @param[out] frame  RINGLOG_FRAME_LEN bytes.
+ *
+ * @return     RINGLOG_FRAME_LEN.
+ */
+size_t RingLog::frame( const uint8_t *image, uint8_t *frame ) {
+	uint8_t payload[RINGLOG_RECORD_LEN + 2];
+
+	payload[0] = RINGLOG_FRAME_TAG;
+	memcpy( payload + 1, image, RINGLOG_RECORD_LEN );
+	payload[RINGLOG_RECORD_LEN + 1] = crc8( payload, RINGLOG_RECORD_LEN + 1 );
+
+	frame[0] = 0;
+	size_t n = 1 + cobs_encode( payload, sizeof( payload ), frame + 1 );
+	frame[n++] = 0;
+	return n;
+}
+
+uint16_t RingLog::slot_addr( uint32_t seq ) {
+	return base_addr + (uint16_t) ( seq % slots ) * RINGLOG_RECORD_LEN;
+}
+
+/**
+ * @brief      Fetches the stored image of a record - from RAM while it is
+ *             still being written.
+ *
+ * @return     false unless the slot holds an intact copy of seq.
+ */
+bool RingLog::read_image( uint32_t seq, uint8_t *image ) {
+	RINGLOG_RECORD_T rec;
+
+	if ( !slots || ( seq >= next_seq ) || ( seq < oldestSeq() ) ) {
+		return false;
+	}
+	if ( busy() && ( seq == pending_seq ) ) {
+		memcpy( image, pending, RINGLOG_RECORD_LEN );
+		return true;
+	}
+	uint16_t addr = slot_addr( seq );
+	for ( uint8_t i = 0; i < RINGLOG_RECORD_LEN; i++ ) {
+		image[i] = EEPROM.read( addr + i );
+	}
+	return unpack( image, &rec ) && ( seq == rec.seq );
+}
+
+/** @} end of addtogroup */
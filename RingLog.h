@@ -0,0 +1,140 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file RingLog.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Wear-levelled circular log of per-minute readings in the
+ *             on-chip EEPROM, so a host that was down can fetch what it
+ *             missed.
+ *
+ * @details    The log area is split into RINGLOG_RECORD_LEN byte slots and
+ *             record seq always lives in slot seq % slots.  Every slot is
+ *             written once per lap and there is no header or head pointer
+ *             that would be rewritten on every record, so the wear is spread
+ *             evenly over the whole area.  With the full 1 KB (64 slots, a
+ *             little over an hour of records) a cell is programmed at most
+ *             once every 64 minutes - twice for the top seq byte, see below
+ *             - which is 6 years to the 100,000 cycle rating for the busiest
+ *             cells and 12 for the rest.
+ *
+ *             A slot is (little endian)
+ *
+ *                 seq:24 | flags | wind | gust | dir | rain | temp | hum |
+ *                 pressure:16 | CRC-8
+ *
+ *             where flags holds the RINGLOG_VALID_* bits, bit 8 of the wind
+ *             direction and the gust compass point.  A slot whose top seq
+ *             byte is 0xFF is empty - erased cells read that way.
+ *
+ *             Writing a record first sets the top seq byte to 0xFF, then
+ *             writes the rest and the top byte last.  A reset lets the byte
+ *             being programmed finish, so at any point the slot holds either
+ *             the old record, nothing, or the whole new one - the CRC is
+ *             there for brown-outs, which can leave a cell with garbage.
+ *             begin() scans every slot and resumes after the newest one
+ *             whose CRC and slot position check out; a record that was cut
+ *             short gets its sequence number written again, and the oldest
+ *             record it was replacing is lost.
+ *
+ *             Records are written a byte at a time from service() whenever
+ *             the EEPROM is idle, so nothing waits the 3.4 ms a byte takes
+ *             to program, and bytes that already hold the right value are
+ *             not programmed at all.  A dump reads the slots back one record
+ *             per call for the same reason.
+ *
+ *             Sequence numbers stop at RINGLOG_SEQ_LIMIT - 31 years at one a
+ *             minute.
+ */
+
+#ifndef RING_LOG_H
+#define RING_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <EEPROM.h>
+#include "WSA80422.h"
+
+/* @brief      Bytes per slot, CRC included */
+#define RINGLOG_RECORD_LEN 16
+
+/* @brief      First sequence number that cannot be stored - a top byte of
+ *             0xFF marks an empty slot */
+#define RINGLOG_SEQ_LIMIT 0xFF0000UL
+
+/* @brief      Offset of the stored pressure, Pa */
+#define RINGLOG_PRESSURE_BASE 50000UL
+
+/* @brief      RINGLOG_RECORD_T::valid bits - clear when the reading was
+ *             not available */
+#define RINGLOG_VALID_HTU       (0x01)
+#define RINGLOG_VALID_BARO      (0x02)
+#define RINGLOG_VALID_VANE      (0x04)
+
+/* @brief      First payload byte of a log record on the serial link - kept
+ *             clear of TELEMETRY_VERSION */
+#define RINGLOG_FRAME_TAG 0x80
+
+/* @brief      Bytes of a whole log record frame: delimiters, COBS code, tag,
+ *             slot and CRC */
+#define RINGLOG_FRAME_LEN ( RINGLOG_RECORD_LEN + 5 )
+
+/**
+ * @brief      One minute of readings, in the units stored.
+ */
+typedef struct RINGLOG_RECORD
+{
+	uint32_t seq;               /* assigned by append() */
+	uint8_t valid;              /* RINGLOG_VALID_* bits */
+	uint16_t wind_mph10;        /* 2 minute mean, mph x 10 */
+	uint16_t wind_dir;          /* of the 2 minute mean, degrees */
+	uint16_t gust_mph10;        /* strongest 1 s wind over 2 minutes */
+	WINDDIR_T gust_dir;         /* WINDDIR_ERR without RINGLOG_VALID_VANE */
+	uint8_t rain_tips;          /* bucket tips in the minute, 0.011" each */
+	int16_t temp_c100;          /* HTU21D */
+	uint8_t humidity_x2;        /* 0.5 % steps */
+	uint32_t pressure_pa;       /* stored from RINGLOG_PRESSURE_BASE up */
+} RINGLOG_RECORD_T;
+
+class RingLog {
+public:
+	RingLog();
+	bool begin( uint16_t base, uint16_t len );
+	bool append( RINGLOG_RECORD_T *rec );
+	void service( void );
+	bool busy( void );
+	uint16_t capacity( void );
+	uint32_t nextSeq( void );
+	uint32_t oldestSeq( void );
+	bool read( uint32_t seq, RINGLOG_RECORD_T *rec );
+
+	void startDump( uint32_t since );
+	bool dumping( void );
+	bool dumpNext( uint8_t *image );
+
+	static void pack( const RINGLOG_RECORD_T *rec, uint8_t *image );
+	static bool unpack( const uint8_t *image, RINGLOG_RECORD_T *rec );
+	static size_t frame( const uint8_t *image, uint8_t *frame );
+private:
+	uint16_t base_addr;
+	uint16_t slots;
+	uint32_t next_seq;
+	/* record being written by service() */
+	uint8_t pending[RINGLOG_RECORD_LEN];
+	uint8_t pending_pos;
+	uint16_t pending_addr;
+	uint32_t pending_seq;
+	/* dump cursor */
+	uint32_t dump_seq;
+	uint32_t dump_end;
+
+	uint16_t slot_addr( uint32_t seq );
+	bool read_image( uint32_t seq, uint8_t *image );
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,215 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Scheduler.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "Scheduler.h"
+
+Scheduler::Scheduler() {
+	num_tasks = 0;
+	run_late_us = 0;
+	run_ticks = 1;
+}
+
+/**
+ * @brief      Registers a periodic task.  Call before start().
+ *
+ * @param[in]  fn         called once per period.
+ * @param[in]  period_ms  period, under 35 minutes.
+ * @param[in]  priority   0 runs first when several tasks are due.
+ *
+ * @return     task id for getStats(), -1 if there is no free slot.
+ */
+int8_t Scheduler::addTask( SCHED_TASK_FN fn, uint32_t period_ms, uint8_t priority ) {
+	if ( num_tasks >= SCHED_MAX_TASKS ) {
+		return -1;
+	}
+	Task *t = &task[num_tasks];
+	t->fn = fn;
+	t->period_us = period_ms * 1000UL;
+	t->due_us = micros() + t->period_us;
+	t->priority = priority;
+	t->catch_up = true;
+	t->stats = SCHED_STATS_T();
+	num_tasks++;
+	return (int8_t) ( num_tasks - 1 );
+}
+
+/**
+ * @brief      Sets every task's first deadline one period from now.
+ */
+void Scheduler::start( void ) {
+	uint32_t now = micros();
+	for ( uint8_t i = 0; i < num_tasks; i++ ) {
+		task[i].due_us = now + task[i].period_us;
+	}
+}
+
+/**
+ * @brief      Runs the most urgent due task, if any - call from every pass
+ *             of loop().
+ *
+ * @return     true if a task ran.
+ */
+bool Scheduler::run( void ) {
+	uint32_t now = micros();
+	int8_t pick = -1;
+	uint32_t pick_late = 0;
+	uint8_t i;
+
+	for ( i = 0; i < num_tasks; i++ ) {
+		int32_t late = (int32_t) ( now - task[i].due_us );
+		if ( late < 0 ) {
+			continue;
+		}
+		if ( ( pick < 0 ) || ( task[i].priority < task[pick].priority ) ||
+		     ( ( task[i].priority == task[pick].priority ) && ( (uint32_t) late > pick_late ) ) ) {
+			pick = i;
+			pick_late = (uint32_t) late;
+		}
+	}
+	if ( pick < 0 ) {
+		return false;
+	}
+
+	Task *t = &task[pick];
+	SCHED_STATS_T *st = &t->stats;
+
+	uint32_t behind = pick_late / t->period_us;
+	uint32_t ticks = 1;
+	if ( !t->catch_up ) {
+		/* this call stands for every tick missed */
+		ticks = ( behind < 0xFFFF ) ? behind + 1 : 0xFFFF;
+	}
+	else if ( behind > SCHED_MAX_CATCHUP ) {
+		/* too far behind to catch up - drop the oldest ticks, keeping the phase */
+		uint32_t drop = behind - SCHED_MAX_CATCHUP;
+		t->due_us += drop * t->period_us;
+		pick_late -= drop * t->period_us;
+		st->skipped = ( st->skipped + drop > 0xFFFF ) ? 0xFFFF : st->skipped + drop;
+	}
+	if ( ( pick_late >= t->period_us ) && ( st->overruns < 0xFFFF ) ) {
+		st->overruns++;
+	}
+	if ( pick_late > st->late_max_us ) {
+		st->late_max_us = pick_late;
+	}
+	/* halve the sum and its count together, so the mean stays right */
+	if ( st->late_sum_us + pick_late < st->late_sum_us ) {
+		st->late_sum_us >>= 1;
+		st->late_n >>= 1;
+	}
+	st->late_sum_us += pick_late;
+	st->late_n++;
+
+	/* counted before the call so a task reporting on itself is consistent */
+	st->runs++;
+	t->due_us += ticks * t->period_us;
+	run_late_us = pick_late;
+	run_ticks = (uint16_t) ticks;
+	uint32_t start = micros();
+	t->fn();
+	uint32_t exec = micros() - start;
+	if ( exec > st->exec_max_us ) {
+		st->exec_max_us = exec;
+	}
+	return true;
+}
+
+/**
+ * @brief      How late the task running now started, us - for a task that
+ *             keeps its own record of it.  After run() returns, the last
+ *             task's.
+ */
+uint32_t Scheduler::lateUs( void ) {
+	return run_late_us;
+}
+
+/**
+ * @brief      Periods the task running now stands for - more than 1 only
+ *             for a task that does not catch up and started a period or
+ *             more late.  After run() returns, the last task's.
+ */
+uint16_t Scheduler::runTicks( void ) {
+	return run_ticks;
+}
+
+/**
+ * @brief      Whether a task runs its missed ticks one by one (the
+ *             default) or once for all of them - for a task that measures
+ *             what happened since its last run, where back to back runs
+ *             would put it all in the first.
+ *
+ * @return     false for an unknown id.
+ */
+bool Scheduler::setCatchUp( uint8_t id, bool catch_up ) {
+	if ( id >= num_tasks ) {
+		return false;
+	}
+	task[id].catch_up = catch_up;
+	return true;
+}
+
+/**
+ * @brief      Time until the next deadline, 0 if a task is already due.
+ */
+uint32_t Scheduler::usUntilNext( void ) {
+	uint32_t now = micros();
+	uint32_t next = 0xFFFFFFFFUL;
+	for ( uint8_t i = 0; i < num_tasks; i++ ) {
+		int32_t left = (int32_t) ( task[i].due_us - now );
+		if ( left <= 0 ) {
+			return 0;
+		}
+		if ( (uint32_t) left < next ) {
+			next = (uint32_t) left;
+		}
+	}
+	return next;
+}
+
+uint8_t Scheduler::taskCount( void ) {
+	return num_tasks;
+}
+
+/**
+ * @brief      Copies out a task's statistics.
+ *
+ * @return     false for an unknown id.
+ */
+bool Scheduler::getStats( uint8_t id, SCHED_STATS_T *stats ) {
+	if ( id >= num_tasks ) {
+		return false;
+	}
+	*stats = task[id].stats;
+	return true;
+}
+
+/**
+ * @brief      Mean start time past the deadline, microseconds.
+ */
+uint32_t Scheduler::meanLateUs( uint8_t id ) {
+	if ( ( id >= num_tasks ) || ( 0 == task[id].stats.late_n ) ) {
+		return 0;
+	}
+	return task[id].stats.late_sum_us / task[id].stats.late_n;
+}
+
+void Scheduler::resetStats( void ) {
+	for ( uint8_t i = 0; i < num_tasks; i++ ) {
+		SCHED_STATS_T *st = &task[i].stats;
+		st->runs = 0;
+		st->late_max_us = 0;
+		st->late_sum_us = 0;
+		st->late_n = 0;
+		st->exec_max_us = 0;
+		st->overruns = 0;
+		st->skipped = 0;
+	}
+}
+
+/** @} end of addtogroup */
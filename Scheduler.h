@@ -0,0 +1,90 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Scheduler.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Cooperative periodic task scheduler.
+ *
+ * @details    Each task has a deadline that moves forward by whole
+ *             periods every time it runs, so a late run never shifts the
+ *             ticks that follow.  A task that falls behind is run again on
+ *             the following passes until it has caught up, up to
+ *             SCHED_MAX_CATCHUP ticks - beyond that the oldest ticks are
+ *             dropped and counted.  A task set not to catch up runs once
+ *             instead, for every tick it missed, and runTicks() tells it
+ *             how many periods that call covers.  When several tasks are
+ *             due the lowest priority number runs first, ties going to the
+ *             earliest deadline.  run() starts at most one task per call so the
+ *             rest of loop() keeps getting serviced.
+ *
+ *             Deadlines are kept in micros(), which wraps every 71 minutes -
+ *             periods must stay under half that.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Arduino.h"
+
+/* @brief      Task slots - about 40 bytes of RAM each, the sketch runs
+ *             three */
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS 4
+#endif
+
+/* @brief      Missed ticks a task may run back to back before the oldest
+ *             are dropped */
+#define SCHED_MAX_CATCHUP 3
+
+/* @brief      Per task timing statistics */
+typedef struct SCHED_STATS
+{
+	uint32_t runs;
+	uint32_t late_max_us;   /* worst start time past the deadline */
+	uint32_t late_sum_us;   /* for the mean */
+	uint32_t late_n;        /* runs in late_sum_us - both halve before the
+	                           sum would overflow */
+	uint32_t exec_max_us;   /* longest run */
+	uint16_t overruns;      /* runs that started a full period or more late */
+	uint16_t skipped;       /* ticks dropped beyond SCHED_MAX_CATCHUP */
+} SCHED_STATS_T;
+
+typedef void (*SCHED_TASK_FN)( void );
+
+class Scheduler {
+public:
+	Scheduler();
+	int8_t addTask( SCHED_TASK_FN fn, uint32_t period_ms, uint8_t priority );
+	void start( void );
+	bool run( void );
+	uint32_t usUntilNext( void );
+	uint8_t taskCount( void );
+	bool getStats( uint8_t id, SCHED_STATS_T *stats );
+	uint32_t meanLateUs( uint8_t id );
+	uint32_t lateUs( void );
+	uint16_t runTicks( void );
+	bool setCatchUp( uint8_t id, bool catch_up );
+	void resetStats( void );
+private:
+	struct Task {
+		SCHED_TASK_FN fn;
+		uint32_t period_us;
+		uint32_t due_us;
+		uint8_t priority;
+		bool catch_up;      /* run missed ticks one by one */
+		SCHED_STATS_T stats;
+	};
+	Task task[SCHED_MAX_TASKS];
+	uint8_t num_tasks;
+	uint32_t run_late_us;
+	uint16_t run_ticks;
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,67 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file SramBudget.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      The share of the ATmega328P's 2048 bytes of SRAM the sketch's
+ *             globals may take.
+ *
+ * @details    The AVR core's serial and I2C buffers and the stack take
+ *             the rest.  SRAM_GLOBALS_BYTES adds up every global and
+ *             static the sketch and its modules own.  The sketch checks it
+ *             against SRAM_GLOBALS_BUDGET when it is built for the board,
+ *             and host/bench_sram checks the same sum with the structs
+ *             packed as avr-gcc lays them out.  Host pointers are 8 bytes
+ *             against the board's 2, so the host figure is an upper bound.
+ *
+ *             Constant tables and strings are not counted.  They must stay
+ *             in flash, behind PROGMEM and F().
+ */
+
+#ifndef SRAM_BUDGET_H
+#define SRAM_BUDGET_H
+
+#include <stdint.h>
+#include "drv_htu21d.h"
+#include "MPL3115A2.h"
+#include "WSA80422.h"
+#include "Scheduler.h"
+#include "Acquisition.h"
+#include "StationSample.h"
+#include "RingLog.h"
+#include "PowerSave.h"
+#include "Profile.h"
+
+/* @brief      ATmega328P SRAM */
+#define SRAM_TOTAL_BYTES 2048
+
+/* @brief      The core's globals - Serial's two 64 byte rings and state,
+ *             the Wire and twi buffers and millis() */
+#define SRAM_CORE_BYTES 350
+
+/* @brief      Stack reserve - the deepest path is a report building its
+ *             telemetry record and frame (112 bytes) under the scheduler,
+ *             with an ISR's saved registers on top */
+#define SRAM_STACK_BYTES 300
+
+/* @brief      What is left for the sketch's globals */
+#define SRAM_GLOBALS_BUDGET ( SRAM_TOTAL_BYTES - SRAM_CORE_BYTES - SRAM_STACK_BYTES )
+
+/* @brief      The sketch's scalars - three task ids, send_telemetry()'s
+ *             sequence number and poll_commands()'s command and argument */
+#define SRAM_SKETCH_SCALARS ( 3 * sizeof( int8_t ) + sizeof( uint16_t ) + sizeof( char ) + \
+                              sizeof( uint32_t ) )
+
+/* @brief      Every global and static, one term per object the sketch
+ *             defines */
+#define SRAM_GLOBALS_BYTES ( sizeof( DRV_HTU21D ) + sizeof( MPL3115A2 ) + sizeof( WSA80422 ) + \
+                             sizeof( Acquisition ) + sizeof( StationPipeline ) + \
+                             sizeof( STATION_MEAN_T ) + sizeof( Scheduler ) + sizeof( RingLog ) + \
+                             sizeof( PowerSave ) + SRAM_SKETCH_SCALARS + PROFILE_RAM_BYTES )
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,197 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file StationSample.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "StationSample.h"
+#include "units.h"
+
+/* samples a mean holds before further ones are ignored */
+#define STATION_MEAN_MAX_N      (255)
+
+StationPipeline::StationPipeline() {
+	snap = STATION_SAMPLE_T();
+	num_sinks = 0;
+}
+
+/**
+ * @brief      Registers a consumer of the snapshot.
+ *
+ * @param[in]  fn        called from dispatch() with the snapshot.
+ * @param[in]  triggers  STATION_VALID_* groups - fn runs when any of them
+ *                       has been published since the last dispatch.
+ *
+ * @return     sink id, -1 if there is no free slot.
+ */
+int8_t StationPipeline::addSink( STATION_SINK_FN fn, uint8_t triggers ) {
+	if ( num_sinks >= STATION_MAX_SINKS ) {
+		return -1;
+	}
+	sink[num_sinks].fn = fn;
+	sink[num_sinks].triggers = triggers;
+	num_sinks++;
+	return (int8_t) ( num_sinks - 1 );
+}
+
+/**
+ * @brief      Publishes the 5 s wind, the 2 minute mean and the gusts.
+ */
+void StationPipeline::publishWind( WSA80422 *ws ) {
+	int16_t x2, y2;
+
+	snap.wind_ms = millis();
+	ws->get_last_a5s_wind( &snap.wind_x, &snap.wind_y, &snap.wind_spd );
+	ws->get_a2m_wind( &x2, &y2, &snap.wind_spd_2m );
+	snap.wind_dir_2m = ws->get_a2m_wind_dir();
+	ws->get_wind_gust( &snap.gust_spd, &snap.gust_dir );
+	ws->get_a10m_wind_gust( &snap.gust_10m_spd, &snap.gust_10m_dir );
+	snap.wind_now = ws->get_instant_wind_speed();
+	ws->get_peak_3s_gust( &snap.gust_3s );
+	publish( STATION_VALID_WIND, STATION_VALID_WIND );
+}
+
+/**
+ * @brief      Publishes the rain totals - call after the minute's rain
+ *             calculations.
+ */
+void StationPipeline::publishRain( WSA80422 *ws ) {
+	snap.rain_ms = millis();
+	ws->get_last_a1m_rain( &snap.rain_1m );
+	ws->get_last_a1hr_24hr_rain( &snap.rain_1hr, &snap.rain_day );
+	snap.rain_rate = ws->get_rain_rate();
+	snap.pulse_overflows = ws->get_pulse_overflows();
+	publish( STATION_VALID_RAIN, STATION_VALID_RAIN );
+}
+
+/**
+ * @brief      Publishes the light sensor voltage.
+ */
+void StationPipeline::publishLight( WSA80422 *ws ) {
+	snap.light_ms = millis();
+	snap.light_mv = ws->get_light_mv();
+	publish( STATION_VALID_LIGHT, STATION_VALID_LIGHT );
+}
+
+/**
+ * @brief      Publishes a completed Acquisition sample.  A sensor that did
+ *             not answer leaves its group invalid.  A barometer in event
+ *             mode with nothing new leaves its group as it was, unpublished.
+ */
+void StationPipeline::publishEnv( const ACQ_SAMPLE_T *env ) {
+	uint8_t valid = 0;
+	uint8_t groups = STATION_VALID_HTU | STATION_VALID_MPL;
+
+	snap.env_ms = env->start_ms;
+	if ( ( env->valid & ACQ_VALID_HTU_T ) && ( env->valid & ACQ_VALID_HTU_RH ) ) {
+		snap.temp_htu_c100 = env->temp_htu_c100;
+		snap.humidity_c100 = env->humidity_c100;
+		valid |= STATION_VALID_HTU;
+	}
+	if ( env->valid & ACQ_VALID_MPL ) {
+		snap.temp_mpl_c100 = env->temp_mpl_c100;
+		snap.pressure_pa4 = env->pressure_pa4;
+		valid |= STATION_VALID_MPL;
+	}
+	if ( env->valid & ACQ_MPL_HELD ) {
+		groups = STATION_VALID_HTU;
+	}
+	publish( groups, valid );
+}
+
+/**
+ * @brief      Runs every sink triggered by a group published since the last
+ *             call, in the order they were added, then clears the fresh
+ *             bits.
+ *
+ * @return     number of sinks run.
+ */
+uint8_t StationPipeline::dispatch( void ) {
+	uint8_t ran = 0;
+
+	for ( uint8_t i = 0; i < num_sinks; i++ ) {
+		if ( snap.fresh & sink[i].triggers ) {
+			sink[i].fn( &snap );
+			ran++;
+		}
+	}
+	snap.fresh = 0;
+	return ran;
+}
+
+/**
+ * @brief      The snapshot as it stands, for code outside a sink.
+ */
+const STATION_SAMPLE_T *StationPipeline::sample( void ) {
+	return &snap;
+}
+
+/**
+ * @brief      Marks groups published - valid if their bit is set in valid.
+ */
+void StationPipeline::publish( uint8_t groups, uint8_t valid ) {
+	snap.valid = (uint8_t) ( ( snap.valid & ~groups ) | ( valid & groups ) );
+	snap.fresh |= groups;
+}
+
+/*----------------------------------------------------------------------------*/
+/* averaging */
+
+/**
+ * @brief      Adds the temperature, humidity and pressure of a snapshot to
+ *             a mean - only the groups published since the last dispatch,
+ *             so a sample is never counted twice.
+ */
+void station_mean_add( STATION_MEAN_T *mean, const STATION_SAMPLE_T *sample ) {
+	uint8_t add = sample->valid & sample->fresh;
+
+	if ( ( add & STATION_VALID_HTU ) && ( mean->htu_n < STATION_MEAN_MAX_N ) ) {
+		mean->temp_sum += sample->temp_htu_c100;
+		mean->humidity_sum += sample->humidity_c100;
+		mean->htu_n++;
+	}
+	if ( ( add & STATION_VALID_MPL ) && ( mean->mpl_n < STATION_MEAN_MAX_N ) ) {
+		mean->pa4_sum += sample->pressure_pa4;
+		mean->mpl_n++;
+	}
+}
+
+/**
+ * @brief      Mean HTU21D temperature and humidity, rounded half away from
+ *             zero.
+ *
+ * @return     false if no sample has been added.
+ */
+bool station_mean_htu( const STATION_MEAN_T *mean, int16_t *temp_c100, int16_t *humidity_c100 ) {
+	if ( 0 == mean->htu_n ) {
+		return false;
+	}
+	*temp_c100 = (int16_t) units_div_round( mean->temp_sum, mean->htu_n );
+	*humidity_c100 = (int16_t) units_div_round( mean->humidity_sum, mean->htu_n );
+	return true;
+}
+
+/**
+ * @brief      Mean pressure in Pa x 4, rounded half up.
+ *
+ * @return     false if no sample has been added.
+ */
+bool station_mean_pa4( const STATION_MEAN_T *mean, uint32_t *pa4 ) {
+	if ( 0 == mean->mpl_n ) {
+		return false;
+	}
+	*pa4 = ( mean->pa4_sum + mean->mpl_n / 2 ) / mean->mpl_n;
+	return true;
+}
+
+/**
+ * @brief      Empties a mean.
+ */
+void station_mean_reset( STATION_MEAN_T *mean ) {
+	*mean = STATION_MEAN_T();
+}
+
+/** @} end of addtogroup */
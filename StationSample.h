@@ -0,0 +1,133 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file StationSample.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      One snapshot of everything the station measures, and the
+ *             pipeline that carries it from the drivers to whatever reports
+ *             or stores it.
+ *
+ * @details    Producers publish a group of fields into the single
+ *             STATION_SAMPLE_T the pipeline owns - the wind and light at
+ *             each report, the rain each minute, the temperature, humidity
+ *             and pressure whenever an Acquisition sample completes - and
+ *             each group carries a valid bit and the millis() it was
+ *             captured at.  dispatch() then hands a const pointer to that
+ *             snapshot to every sink registered for a group published since
+ *             the last dispatch, so the serial framer, the EEPROM log and
+ *             the averaging all read the same values without going back to
+ *             a driver or copying the record.
+ *
+ *             Sinks run in the order they were added and must not publish
+ *             themselves.
+ */
+
+#ifndef STATION_SAMPLE_H
+#define STATION_SAMPLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Arduino.h"
+#include "WSA80422.h"
+#include "Acquisition.h"
+
+/* @brief      Sink slots */
+#define STATION_MAX_SINKS 4
+
+/* @brief      Field groups - STATION_SAMPLE_T::valid and ::fresh bits and
+ *             sink triggers */
+#define STATION_VALID_WIND      (0x01)
+#define STATION_VALID_RAIN      (0x02)
+#define STATION_VALID_HTU       (0x04)  /* temperature and humidity */
+#define STATION_VALID_MPL       (0x08)  /* pressure and temperature */
+#define STATION_VALID_LIGHT     (0x10)
+
+/**
+ * @brief      The station snapshot.  Wind speeds are mph x 1000, directions
+ *             degrees, rain thousandths of an inch, temperatures and
+ *             humidity hundredths.  A field is only meaningful while its
+ *             group's valid bit is set.
+ */
+typedef struct STATION_SAMPLE
+{
+	uint8_t valid;              /* groups holding data */
+	uint8_t fresh;              /* groups published since the last dispatch() */
+	uint32_t wind_ms;           /* millis() each group was captured */
+	uint32_t rain_ms;
+	uint32_t env_ms;            /* the Acquisition sample's start */
+	uint32_t light_ms;
+	/* STATION_VALID_WIND */
+	int16_t wind_x;             /* 5 s mean direction vector, x1000 */
+	int16_t wind_y;
+	uint32_t wind_spd;          /* 5 s mean */
+	uint32_t wind_spd_2m;
+	uint16_t wind_dir_2m;
+	uint32_t gust_spd;
+	WINDDIR_T gust_dir;
+	uint32_t gust_10m_spd;
+	WINDDIR_T gust_10m_dir;
+	uint32_t wind_now;
+	uint32_t gust_3s;
+	/* STATION_VALID_RAIN */
+	uint16_t rain_1m;
+	uint16_t rain_1hr;
+	uint16_t rain_day;
+	uint32_t rain_rate;
+	uint16_t pulse_overflows;
+	/* STATION_VALID_HTU */
+	int16_t temp_htu_c100;
+	int16_t humidity_c100;
+	/* STATION_VALID_MPL */
+	int16_t temp_mpl_c100;
+	uint32_t pressure_pa4;      /* Pa x 4 as read from the MPL3115A2 */
+	/* STATION_VALID_LIGHT */
+	uint16_t light_mv;
+} STATION_SAMPLE_T;
+
+/**
+ * @brief      Running sums for the mean of the temperature, humidity and
+ *             pressure over several samples.
+ */
+typedef struct STATION_MEAN
+{
+	int32_t temp_sum;
+	int32_t humidity_sum;
+	uint32_t pa4_sum;
+	uint8_t htu_n;
+	uint8_t mpl_n;
+} STATION_MEAN_T;
+
+typedef void (*STATION_SINK_FN)( const STATION_SAMPLE_T *sample );
+
+class StationPipeline {
+public:
+	StationPipeline();
+	int8_t addSink( STATION_SINK_FN fn, uint8_t triggers );
+	void publishWind( WSA80422 *ws );
+	void publishRain( WSA80422 *ws );
+	void publishLight( WSA80422 *ws );
+	void publishEnv( const ACQ_SAMPLE_T *env );
+	uint8_t dispatch( void );
+	const STATION_SAMPLE_T *sample( void );
+private:
+	void publish( uint8_t groups, uint8_t valid );
+	struct Sink {
+		STATION_SINK_FN fn;
+		uint8_t triggers;
+	};
+	STATION_SAMPLE_T snap;
+	Sink sink[STATION_MAX_SINKS];
+	uint8_t num_sinks;
+};
+
+void station_mean_add( STATION_MEAN_T *mean, const STATION_SAMPLE_T *sample );
+bool station_mean_htu( const STATION_MEAN_T *mean, int16_t *temp_c100, int16_t *humidity_c100 );
+bool station_mean_pa4( const STATION_MEAN_T *mean, uint32_t *pa4 );
+void station_mean_reset( STATION_MEAN_T *mean );
+
+#endif
+
+/** @} end of addtogroup */
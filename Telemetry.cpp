@@ -0,0 +1,122 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Telemetry.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "Telemetry.h"
+#include "cobs.h"
+#include "crc8.h"
+
+static uint8_t *put_u8( uint8_t *p, uint8_t v ) {
+	*p++ = v;
+	return p;
+}
+
+static uint8_t *put_u16( uint8_t *p, uint16_t v ) {
+	*p++ = (uint8_t) v;
+	*p++ = (uint8_t) ( v >> 8 );
+	return p;
+}
+
+static uint8_t *put_u32( uint8_t *p, uint32_t v ) {
+	p = put_u16( p, (uint16_t) v );
+	return put_u16( p, (uint16_t) ( v >> 16 ) );
+}
+
+static uint16_t get_u16( const uint8_t *p ) {
+	return (uint16_t) ( p[0] | ( p[1] << 8 ) );
+}
+
+static uint32_t get_u32( const uint8_t *p ) {
+	return get_u16( p ) | ( (uint32_t) get_u16( p + 2 ) << 16 );
+}
+
+/**
+ * @brief      Packs a record into TELEMETRY_PAYLOAD_LEN bytes.
+ */
+void telemetry_pack( const TELEMETRY_RECORD_T *rec, uint8_t *payload ) {
+	uint8_t *p = payload;
+
+	p = put_u8( p, TELEMETRY_VERSION );
+	p = put_u16( p, rec->seq );
+	p = put_u32( p, rec->time_ms );
+	p = put_u8( p, rec->valid );
+	p = put_u16( p, (uint16_t) rec->wind_x );
+	p = put_u16( p, (uint16_t) rec->wind_y );
+	p = put_u16( p, rec->wind_dir );
+	p = put_u32( p, rec->wind_spd );
+	p = put_u32( p, rec->wind_spd_2m );
+	p = put_u16( p, rec->wind_dir_2m );
+	p = put_u32( p, rec->gust_spd );
+	p = put_u16( p, rec->gust_dir );
+	p = put_u32( p, rec->gust_10m_spd );
+	p = put_u16( p, rec->gust_10m_dir );
+	p = put_u16( p, rec->rain_1m );
+	p = put_u16( p, rec->rain_1hr );
+	p = put_u16( p, rec->rain_day );
+	p = put_u16( p, (uint16_t) rec->temp_htu_c100 );
+	p = put_u16( p, rec->humidity_c100 );
+	p = put_u16( p, (uint16_t) rec->temp_mpl_c100 );
+	p = put_u32( p, rec->pressure_pa4 );
+	put_u16( p, rec->light_mv );
+}
+
+/**
+ * @brief      Unpacks a payload.
+ *
+ * @return     false if the length or version does not match.
+ */
+bool telemetry_unpack( const uint8_t *payload, size_t len, TELEMETRY_RECORD_T *rec ) {
+	const uint8_t *p = payload;
+
+	if ( ( TELEMETRY_PAYLOAD_LEN != len ) || ( TELEMETRY_VERSION != p[0] ) ) {
+		return false;
+	}
+	rec->seq = get_u16( p + 1 );
+	rec->time_ms = get_u32( p + 3 );
+	rec->valid = p[7];
+	rec->wind_x = (int16_t) get_u16( p + 8 );
+	rec->wind_y = (int16_t) get_u16( p + 10 );
+	rec->wind_dir = get_u16( p + 12 );
+	rec->wind_spd = get_u32( p + 14 );
+	rec->wind_spd_2m = get_u32( p + 18 );
+	rec->wind_dir_2m = get_u16( p + 22 );
+	rec->gust_spd = get_u32( p + 24 );
+	rec->gust_dir = get_u16( p + 28 );
+	rec->gust_10m_spd = get_u32( p + 30 );
+	rec->gust_10m_dir = get_u16( p + 34 );
+	rec->rain_1m = get_u16( p + 36 );
+	rec->rain_1hr = get_u16( p + 38 );
+	rec->rain_day = get_u16( p + 40 );
+	rec->temp_htu_c100 = (int16_t) get_u16( p + 42 );
+	rec->humidity_c100 = get_u16( p + 44 );
+	rec->temp_mpl_c100 = (int16_t) get_u16( p + 46 );
+	rec->pressure_pa4 = get_u32( p + 48 );
+	rec->light_mv = get_u16( p + 52 );
+	return true;
+}
+
+/**
+ * @brief      Builds the complete wire frame for a record.
+ *
+ * @param[out] frame  TELEMETRY_FRAME_LEN bytes.
+ *
+ * @return     TELEMETRY_FRAME_LEN.
+ */
+size_t telemetry_frame( const TELEMETRY_RECORD_T *rec, uint8_t *frame ) {
+	uint8_t payload[TELEMETRY_PAYLOAD_LEN + 1];
+
+	telemetry_pack( rec, payload );
+	payload[TELEMETRY_PAYLOAD_LEN] = crc8( payload, TELEMETRY_PAYLOAD_LEN );
+
+	frame[0] = 0;
+	size_t n = 1 + cobs_encode( payload, sizeof( payload ), frame + 1 );
+	frame[n++] = 0;
+	return n;
+}
+
+/** @} end of addtogroup */
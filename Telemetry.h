@@ -0,0 +1,81 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Telemetry.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Binary station snapshot sent over the serial link.
+ *
+ * @details    A frame on the wire is
+ *
+ *                 0x00 | COBS( payload | CRC-8 ) | 0x00
+ *
+ *             The payload is TELEMETRY_PAYLOAD_LEN bytes, little endian,
+ *             packed field by field in the order of TELEMETRY_RECORD_T (so
+ *             the layout does not depend on either compiler's struct
+ *             padding) and led by TELEMETRY_VERSION.  The CRC is crc8() of
+ *             the payload.  The leading delimiter lets a reader sync on the
+ *             first frame after any text output - back to back frames just
+ *             produce an empty frame, which readers skip.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define TELEMETRY_VERSION 2
+
+/* @brief      Bytes of packed record, version byte included */
+#define TELEMETRY_PAYLOAD_LEN 54
+
+/* @brief      Bytes of a whole frame: delimiters, COBS code and CRC */
+#define TELEMETRY_FRAME_LEN ( TELEMETRY_PAYLOAD_LEN + 4 )
+
+/* @brief      TELEMETRY_RECORD_T::valid bits - clear when the sensor had
+ *             nothing to report */
+#define TELEM_VALID_HTU         (0x01)
+#define TELEM_VALID_MPL_T       (0x02)
+#define TELEM_VALID_MPL_P       (0x04)
+
+/**
+ * @brief      One station snapshot.  Wind speeds are mph x 1000, directions
+ *             degrees, rain thousandths of an inch, temperatures and
+ *             humidity hundredths.
+ */
+typedef struct TELEMETRY_RECORD
+{
+	uint16_t seq;
+	uint32_t time_ms;
+	uint8_t valid;
+	int16_t wind_x;             /* 5 s mean direction vector, x1000 */
+	int16_t wind_y;
+	uint16_t wind_dir;          /* of the 5 s vector */
+	uint32_t wind_spd;          /* 5 s mean */
+	uint32_t wind_spd_2m;
+	uint16_t wind_dir_2m;
+	uint32_t gust_spd;
+	uint16_t gust_dir;
+	uint32_t gust_10m_spd;
+	uint16_t gust_10m_dir;
+	uint16_t rain_1m;
+	uint16_t rain_1hr;
+	uint16_t rain_day;
+	int16_t temp_htu_c100;
+	uint16_t humidity_c100;
+	int16_t temp_mpl_c100;
+	uint32_t pressure_pa4;      /* Pa x 4 as read from the MPL3115A2 */
+	uint16_t light_mv;
+} TELEMETRY_RECORD_T;
+
+void telemetry_pack( const TELEMETRY_RECORD_T *rec, uint8_t *payload );
+bool telemetry_unpack( const uint8_t *payload, size_t len, TELEMETRY_RECORD_T *rec );
+size_t telemetry_frame( const TELEMETRY_RECORD_T *rec, uint8_t *frame );
+
+#endif
+
+/** @} end of addtogroup */
@@ -10,10 +10,11 @@
  */
 
 #include "WSA80422.h"
+#include "units.h"
 extern void windIRQ( void );
 extern void rainIRQ( void );
 
-const int16_t wind_vector_ary[] =
+const int16_t wind_vector_ary[] PROGMEM =
 	{
 		(int16_t) WDIR_N,   0,     1000, /* Offset:  0 */
 		(int16_t) WDIR_NNW, 383,    924, /* Offset:  3 */
@@ -35,19 +36,71 @@ const int16_t wind_vector_ary[] =
 	};
 
 
+/**
+ * @brief      Direction reported by each ADC band, in ascending ADC order.
+ */
+const uint8_t wdir_band_dir[WDIR_NUM_BANDS] PROGMEM =
+	{
+		WDIR_ESE, /* 112.5 deg */
+		WDIR_ENE, /*  67.5 deg */
+		WDIR_E,   /*  90.0 deg */
+		WDIR_SSE, /* 157.5 deg */
+		WDIR_SE,  /* 135.0 deg */
+		WDIR_SSW, /* 202.5 deg */
+		WDIR_S,   /* 180.0 deg */
+		WDIR_NNE, /*  22.5 deg */
+		WDIR_NE,  /*  45.0 deg */
+		WDIR_WSW, /* 247.5 deg */
+		WDIR_SW,  /* 225.0 deg */
+		WDIR_NNW, /* 337.5 deg */
+		WDIR_N,   /*   0.0 deg */
+		WDIR_WNW, /* 292.5 deg */
+		WDIR_NW,  /* 315.0 deg */
+		WDIR_W,   /* 270.0 deg */
+	};
+
+/**
+ * @brief      Default upper ADC bound (exclusive) of each band - the SparkFun
+ *             Weather Shield values.  Anything at or above the last entry is
+ *             reported as WDIR_ERR.
+ */
+const uint16_t wdir_default_threshold[WDIR_NUM_BANDS] PROGMEM =
+	{ 380, 393, 414, 456, 508, 551, 615, 680, 746, 801, 833, 878, 913, 940, 967, 990 };
+
 WSA80422::WSA80422() {
-	rain_fall_acc = 0;
+	rain_tips = 0;
 	wind_count = 0;
+	rain_tips_taken = 0;
+	wind_count_taken = 0;
+	rain_this_hr = 0;
+	w_blocks_30s = 0;
 	winddir_pin = A0;
 	time_of_last_wind_read = 0;
 	time_of_last_rain_read = 0;
+	gust_5s_pls = 0;
+	gust_5s_dir = WDIR_ERR;
+	gust_30s_pls = 0;
+	gust_30s_dir = WDIR_ERR;
+	last_wind_us = 0;
+	wind_interval_us = 0;
+	wind_pulses_seen = 0;
+	wind_bin_start_us = 0;
+	wind_bin_count = 0;
+	gust_3s_peak = 0;
+	last_rain_us = 0;
+	rain_interval_us = 0;
+	rain_tips_seen = 0;
+	for ( uint8_t i = 0; i < WDIR_NUM_BANDS; i++ ) {
+		wdir_threshold[i] = pgm_read_word( &wdir_default_threshold[i] );
+	}
 }
 
 bool WSA80422::init ( uint8_t rain_pin, uint8_t wspd_pin, uint8_t wdir_pin ) {
 	bool config_success = true;
 
-	uint8_t wind_input_debounce_period = 10;
-	uint8_t rain_input_debounce_period = 10;
+	/* 5 ms still reads 298 mph, 10 ms topped out at 149 mph */
+	wind_input_debounce_period = 5;
+	rain_input_debounce_period = 10;
 	
 	pinMode(wspd_pin, INPUT_PULLUP);
 	pinMode(rain_pin, INPUT_PULLUP);
@@ -71,12 +124,14 @@ bool WSA80422::init ( uint8_t rain_pin, uint8_t wspd_pin, uint8_t wdir_pin ) {
 	else {
 		config_success = false;
 	}
-	rain_fall_acc = 0;
-	wind_count = 0;
+	/* the ISRs own the counters - start counting from wherever they are */
+	rain_tips_taken = snapshot( &rain_tips );
+	wind_count_taken = snapshot( &wind_count );
 	winddir_pin = wdir_pin;
 
-	time_of_last_rain_read = millis();
-	time_of_last_wind_read = millis();
+	time_of_last_rain_read = micros();
+	time_of_last_wind_read = micros();
+	wind_bin_start_us = time_of_last_wind_read;
 
 	interrupts();
 
@@ -84,76 +139,81 @@ bool WSA80422::init ( uint8_t rain_pin, uint8_t wspd_pin, uint8_t wdir_pin ) {
 }
 
 void WSA80422::wind_reset_arrays ( void ) {
-	uint8_t i;
+	w_dir_5s_x.clear();
+	w_dir_5s_y.clear();
+	w_spd_5s.clear();
+	w_dir_2m_x.clear();
+	w_dir_2m_y.clear();
+	w_spd_2m.clear();
+	w_spd_10m.clear();
+	w_blocks_30s = 0;
+	gust_2m.clear();
+	gust_10m.clear();
+	gust_5s_pls = 0;
+	gust_5s_dir = WDIR_ERR;
+	gust_30s_pls = 0;
+	gust_30s_dir = WDIR_ERR;
+}
 
-	for( i=0; i<5; i++) {
-		w_dir_5s_x[i] = 0;
-		w_dir_5s_y[i] = 0;	
-	}
-	
-	for( i=0; i<24; i++) {
-		w_dir_2m_x[i] = 0;
-		w_dir_2m_y[i] = 0;	
+WINDDIR_T WSA80422::getWindDir() {
+	return decodeWindDir( getWindDirRaw() );
+}
+
+/**
+ * @brief      Decodes a raw wind vane reading with a range check and a
+ *             fixed four step binary search of the threshold table.
+ *
+ * @param[in]  adc   reading from getWindDirRaw().
+ *
+ * @return     the direction, WDIR_ERR if above the last threshold.
+ */
+WINDDIR_T WSA80422::decodeWindDir( uint16_t adc ) {
+	uint8_t band = 0;
+
+	if ( adc >= wdir_threshold[WDIR_NUM_BANDS - 1] ) {
+		return WDIR_ERR;
 	}
+
+	/* band = number of thresholds <= adc, one compare per step */
+	if ( adc >= wdir_threshold[band + 7] ) { band += 8; }
+	if ( adc >= wdir_threshold[band + 3] ) { band += 4; }
+	if ( adc >= wdir_threshold[band + 1] ) { band += 2; }
+	if ( adc >= wdir_threshold[band] )     { band += 1; }
+
+	return (WINDDIR_T) pgm_read_byte( &wdir_band_dir[band] );
 }
 
-WINDDIR_T WSA80422::getWindDir() {
+/**
+ * @brief      Loads a decode table, e.g. one produced by WindVaneCalibration
+ *             or stored in EEPROM.
+ *
+ * @param[in]  thresholds  WDIR_NUM_BANDS upper band bounds in ascending ADC
+ *                         order (see wdir_band_dir for the band order).
+ *
+ * @return     false (table unchanged) if the thresholds are not strictly
+ *             ascending.
+ */
+bool WSA80422::setWindDirTable( const uint16_t *thresholds ) {
+	uint8_t i;
+	for ( i = 1; i < WDIR_NUM_BANDS; i++ ) {
+		if ( thresholds[i] <= thresholds[i-1] ) {
+			return false;
+		}
+	}
+	for ( i = 0; i < WDIR_NUM_BANDS; i++ ) {
+		wdir_threshold[i] = thresholds[i];
+	}
+	return true;
+}
 
-	uint16_t adc = getWindDirRaw();
-	WINDDIR_T direction;
-
-	// Direction Degrees: 113
-	if (adc < 380)
-		{ direction = WDIR_ESE;  }      
-	// Direction Degrees: 68
-	else if (adc < 393) 
-		{ direction = WDIR_ENE; }  
-	// Direction Degrees: 90
-	else if (adc < 414) 
-		{ direction = WDIR_E;  }   
-	// Direction Degrees: 158
-	else if (adc < 456) 
-		{ direction = WDIR_SSE;  } 
-	// Direction Degrees: 135
-	else if (adc < 508) 
-		{ direction = WDIR_SE;  }  
-	// Direction Degrees: 203
-	else if (adc < 551) 
-		{ direction = WDIR_SSW;  } 
-	// Direction Degrees: 180
-	else if (adc < 615) 
-		{ direction = WDIR_S; }    
-	// Direction Degrees: 23
-	else if (adc < 680) 
-		{ direction = WDIR_NNE; }  
-	// Direction Degrees: 45
-	else if (adc < 746) 
-		{ direction = WDIR_NE; }   
-	// Direction Degrees: 248
-	else if (adc < 801) 
-		{ direction = WDIR_WSW;  } 
-	// Direction Degrees: 225
-	else if (adc < 833) 
-		{ direction = WDIR_SW;  }   
-	// Direction Degrees: 338
-	else if (adc < 878) 
-		{ direction = WDIR_NNW;  } 
-	// Direction Degrees: 0
-	else if (adc < 913) 
-		{ direction = WDIR_N; }    
-	// Direction Degrees: 293
-	else if (adc < 940) 
-		{ direction = WDIR_WNW;  } 
-	// Direction Degrees: 315
-	else if (adc < 967) 
-		{ direction = WDIR_NW;  }  
-	// Direction Degrees: 270
-	else if (adc < 990) 
-		{ direction = WDIR_W;  }
-	else {
-		direction = WDIR_ERR;
-	}   
-	return (direction);
+/**
+ * @brief      Copies out the active decode table.
+ */
+void WSA80422::getWindDirTable( uint16_t *thresholds ) {
+	uint8_t i;
+	for ( i = 0; i < WDIR_NUM_BANDS; i++ ) {
+		thresholds[i] = wdir_threshold[i];
+	}
 }
 
 uint16_t WSA80422::getWindDirRaw( void ) {
@@ -161,46 +221,94 @@ uint16_t WSA80422::getWindDirRaw( void ) {
 }
 
 
+/**
+ * @brief      Reads a counter the ISR increments without masking interrupts.
+ *
+ * @details    The AVR reads the two bytes separately, so an increment that
+ *             lands in between can tear the value.  Reading until two reads
+ *             agree rules that out - the ISR would have to fire within a few
+ *             cycles twice in a row, and the debounce keeps pulses at least
+ *             milliseconds apart.
+ */
+uint16_t WSA80422::snapshot( volatile uint16_t *counter ) {
+	uint16_t n;
+	do {
+		n = *counter;
+	} while ( n != *counter );
+	return n;
+}
+
+/**
+ * @brief      Anemometer pulses since the last resetWindAcc().
+ */
 uint16_t WSA80422::getWindAcc( void ) {
-	return wind_count;
+	return snapshot( &wind_count ) - wind_count_taken;
 }
 
+/**
+ * @brief      Starts a new count.  Only the consumer's copy moves - the ISR
+ *             counter is never written outside the ISR.
+ */
 void WSA80422::resetWindAcc( void ) {
-	wind_count = 0;
+	wind_count_taken = snapshot( &wind_count );
 }
 
+/**
+ * @brief      Rain since the last resetRainFallAcc(), thousandths of an inch.
+ */
 uint16_t WSA80422::getRainFall( void ) {
-	return rain_fall_acc;
+	return (uint16_t) ( snapshot( &rain_tips ) - rain_tips_taken ) * RAIN_PER_TIP;
 }
 
 void WSA80422::resetRainFallAcc( void ) {
-	rain_fall_acc = 0;
+	rain_tips_taken = snapshot( &rain_tips );
 }
 
-void WSA80422::get_last_a5s_wind( int16_t *x, int16_t *y, uint32_t *spd) {
-	uint8_t previous_idx;
-    if ( idx2m == 0 ) {
-    	previous_idx = 23;
-    }
-    else {
-    	previous_idx = idx2m - 1;
-    }
+/**
+ * @brief      getWindAcc() and resetWindAcc() in one - a single snapshot is
+ *             both the end of this count and the start of the next, so no
+ *             pulse can fall between the two.
+ */
+uint16_t WSA80422::takeWindAcc( void ) {
+	uint16_t pulses = snapshot( &wind_count );
+	uint16_t n = pulses - wind_count_taken;
+	wind_count_taken = pulses;
+	return n;
+}
+
+/**
+ * @brief      getRainFall() and resetRainFallAcc() in one, see takeWindAcc().
+ */
+uint16_t WSA80422::takeRainFall( void ) {
+	uint16_t tips = snapshot( &rain_tips );
+	uint16_t n = tips - rain_tips_taken;
+	rain_tips_taken = tips;
+	return n * RAIN_PER_TIP;
+}
 
-    *x = w_dir_2m_x[previous_idx];
-    *y = w_dir_2m_y[previous_idx];
-    *spd = w_spd_2m[previous_idx];
+/**
+ * @brief      The most recent 5 second average wind vector and speed.
+ */
+void WSA80422::get_last_a5s_wind( int16_t *x, int16_t *y, uint32_t *spd) {
+    *x = w_dir_2m_x.newest();
+    *y = w_dir_2m_y.newest();
+    *spd = (uint32_t) w_spd_2m.newest() * 10;
 }
 
+/**
+ * @brief      Rain in the most recent complete minute (thousandths of an
+ *             inch).
+ */
 void WSA80422::get_last_a1m_rain( uint16_t *rain ) {
-	uint8_t previous_idx;
-    if ( rf_idx1m == 0 ) {
-    	previous_idx = 59;
-    }
-    else {
-    	previous_idx = rf_idx1m - 1;
-    }
+    *rain = acc_rain_1m.newest() * RAIN_PER_TIP;
+}
 
-    *rain = acc_rain_1m[previous_idx];
+/**
+ * @brief      Mean wind speed over the last 20 complete 30 s blocks - 10
+ *             minutes (mph x 1000).
+ */
+void WSA80422::get_a10m_wind_speed( uint32_t *spd ) {
+    *spd = w_spd_10m.mean() * 10;
 }
 
 bool WSA80422::init_light_sensor( uint8_t light_pin, uint8_t ref_pin ) {
@@ -208,125 +316,538 @@ bool WSA80422::init_light_sensor( uint8_t light_pin, uint8_t ref_pin ) {
 	REF_3V3_PIN = ref_pin;
 	pinMode(LIGHT_PIN, INPUT);
 	pinMode(REF_3V3_PIN, INPUT);
+	return true;
 }
 
 //Returns the voltage of the light sensor based on the 3.3V rail
 //This allows us to ignore what VCC might be (an Arduino plugged into USB has VCC of 4.5 to 5.2V)
 float WSA80422::get_light_level()
 {
-	float operatingVoltage = analogRead(REF_3V3_PIN);
+	return get_light_mv() / 1000.0f;
+}
 
-	float lightSensor = analogRead(LIGHT_PIN);
+/**
+ * @brief      Light sensor voltage in millivolts, measured against the 3.3 V
+ *             rail, in fixed point.
+ *
+ * @return     0xFFFF if the rail reads 0.
+ */
+uint16_t WSA80422::get_light_mv( void )
+{
+	uint16_t ref = analogRead(REF_3V3_PIN);
+	uint16_t light = analogRead(LIGHT_PIN);
+	return units_light_mv( light, ref );
+}
 
-	operatingVoltage = 3.3 / operatingVoltage; //The reference voltage is 3.3V
+/**
+ * @brief      Rain over the last 60 complete minutes, and over the last 24
+ *             complete hours plus the minutes of the hour under way
+ *             (thousandths of an inch).  The day always takes in every
+ *             minute of the hour, so it never reports less.
+ */
+void WSA80422::get_last_a1hr_24hr_rain( uint16_t *rain_1hr, uint16_t *rain_day ) {
+    *rain_1hr = acc_rain_1m.sum() * RAIN_PER_TIP;
+    *rain_day = (uint16_t) ( acc_rain_1hr.sum() + rain_this_hr );
+}
 
-	lightSensor = operatingVoltage * lightSensor;
 
-	return(lightSensor);
+/**
+ * @brief      2 minute average wind - the mean direction vector of the last
+ *             24 five second averages and their mean speed (mph x 1000).
+ */
+void WSA80422::get_a2m_wind( int16_t *x, int16_t *y, uint32_t *spd) {
+	*x = (int16_t) w_dir_2m_x.mean();
+	*y = (int16_t) w_dir_2m_y.mean();
+	*spd = w_spd_2m.mean() * 10;
 }
 
-void WSA80422::get_last_a1hr_24hr_rain( uint16_t *rain_1hr, uint16_t *rain_day ) {
-	uint8_t previous_idx;
-    if ( rf_idx1hr == 0 ) {
-    	previous_idx = 23;
-    }
-    else {
-    	previous_idx = rf_idx1hr - 1;
-    }
+/**
+ * @brief      2 minute vector averaged wind direction (winddir_avg2m).
+ *
+ * @return     degrees 0-359, 0 if there is no data yet.
+ */
+uint16_t WSA80422::get_a2m_wind_dir( void ) {
+	return wind_vector_degrees( w_dir_2m_x.sum(), w_dir_2m_y.sum() );
+}
 
-    *rain_1hr = acc_rain_1hr[previous_idx];
+/**
+ * @brief      Strongest 1 s wind over the last 2 minutes and the direction
+ *             it came from (windgustmph/windgustdir).  The window moves in
+ *             5 s steps.
+ */
+void WSA80422::get_wind_gust( uint32_t *spd, WINDDIR_T *dir ) {
+	uint8_t pls = gust_2m.max();
+	WINDDIR_T d = gust_2m.empty() ? WDIR_ERR : (WINDDIR_T) gust_2m.maxTag();
+
+	/* include the 5 s block still being filled */
+	if ( gust_5s_pls && ( gust_5s_pls >= pls ) ) {
+		pls = gust_5s_pls;
+		d = (WINDDIR_T) gust_5s_dir;
+	}
+	*spd = (uint32_t) pls * 1492;
+	*dir = d;
+}
 
-    uint8_t i;
-    uint16_t acc_daily_rain = 0;
-    for ( i=0; i<24; i++) {
-    	acc_daily_rain += acc_rain_1hr[i];
-    }
+/**
+ * @brief      Strongest 1 s wind over the last 10 minutes and its direction
+ *             (windgustmph_10m/windgustdir_10m).  The window moves in 30 s
+ *             steps.
+ */
+void WSA80422::get_a10m_wind_gust( uint32_t *spd, WINDDIR_T *dir ) {
+	uint8_t pls = gust_10m.max();
+	WINDDIR_T d = gust_10m.empty() ? WDIR_ERR : (WINDDIR_T) gust_10m.maxTag();
+
+	/* include the 30 s and 5 s blocks still being filled, newest last so
+	   a tie goes to the most recent */
+	if ( gust_30s_pls && ( gust_30s_pls >= pls ) ) {
+		pls = gust_30s_pls;
+		d = (WINDDIR_T) gust_30s_dir;
+	}
+	if ( gust_5s_pls && ( gust_5s_pls >= pls ) ) {
+		pls = gust_5s_pls;
+		d = (WINDDIR_T) gust_5s_dir;
+	}
+	*spd = (uint32_t) pls * 1492;
+	*dir = d;
+}
 
-    *rain_day = acc_daily_rain;
+/**
+ * @brief      Compass bearing of a vane position, rounded to whole degrees.
+ */
+uint16_t WSA80422::wind_dir_degrees( WINDDIR_T dir ) {
+	if ( dir >= WDIR_ERR ) {
+		return 0;
+	}
+	/* the enum runs anticlockwise from north in 22.5 degree steps */
+	return ( ( ( WDIR_NUM_BANDS - dir ) % WDIR_NUM_BANDS ) * 45 + 1 ) / 2;
 }
 
+/**
+ * @brief      Compass bearing of a wind vector in wind_vector_ary form (x
+ *             positive toward west, y toward north) without floating point.
+ *
+ * @details    Folds the vector into the first octant and uses
+ *             atan(z) ~= 45z + 15.6z(1 - z) degrees, within a degree after
+ *             rounding.
+ *
+ * @return     degrees 0-359, 0 for a zero vector.
+ */
+uint16_t WSA80422::wind_vector_degrees( int32_t x, int32_t y ) {
+	int32_t east = -x;
+	uint32_t ae = ( east < 0 ) ? -east : east;
+	uint32_t an = ( y < 0 ) ? -y : y;
+	uint32_t lo, hi, z;
+	int32_t tenths;
+
+	if ( !ae && !an ) {
+		return 0;
+	}
+	/* z = lo / hi in Q15 */
+	lo = ( ae < an ) ? ae : an;
+	hi = ( ae < an ) ? an : ae;
+	while ( hi > 0xFFFF ) {
+		lo >>= 1;
+		hi >>= 1;
+	}
+	z = ( lo << 15 ) / hi;
+	tenths = (int32_t) ( ( 450 * z + 156 * ( ( z * ( 32768 - z ) ) >> 15 ) ) >> 15 );
+	if ( ae > an ) {
+		tenths = 900 - tenths;
+	}
 
-void WSA80422::get_a2m_wind( int16_t *x, int16_t *y, uint32_t *spd) {
-	*x = 0;
-    *y = 0;
-    *spd = 0;
+	/* tenths is now the angle off the north/south axis */
+	if ( y < 0 ) {
+		tenths = 1800 - tenths;
+	}
+	if ( east < 0 ) {
+		tenths = 3600 - tenths;
+	}
+	return (uint16_t) ( ( ( tenths + 5 ) / 10 ) % 360 );
 }
 
+/**
+ * @brief      Closes out one minute of rain - call once a minute.  The
+ *             minute window feeds the hour window each time it completes a
+ *             cycle.
+ */
 void WSA80422::rain_calcs_per_minute ( void ) {
-	
-	noInterrupts();
-	acc_rain_1m[rf_idx1m] = getRainFall();
-	resetRainFallAcc();
-	interrupts();
-
-	rf_idx1m += 1;
-	if ( rf_idx1m == 60 ) {
-		uint8_t i;
-		uint16_t total_rf = 0;
-		for( i=0; i<60; i++ ){
-			total_rf += acc_rain_1m[i];
-			acc_rain_1m[i] = 0;	
-		}
-		rf_idx1hr += 1;
-		if ( 24 == rf_idx1hr ) {
-			rf_idx1hr = 0;
-		}
+	uint16_t rain_1m = takeRainFall();
+	uint16_t tips = rain_1m / RAIN_PER_TIP;
+
+	/* 255 tips is 2.8 in, past the heaviest minute on record */
+	acc_rain_1m.push( ( tips > 0xFF ) ? 0xFF : (uint8_t) tips );
+	rain_this_hr += rain_1m;
+	if ( acc_rain_1m.cycleComplete() ) {
+		acc_rain_1hr.push( acc_rain_1m.sum() * RAIN_PER_TIP );
+		rain_this_hr = 0;
 	}
 }
 
+/**
+ * @brief      Takes the one second wind sample - call once a second.  Every
+ *             5 samples the 5 second average is pushed into the 2 minute
+ *             window, and every 6 of those the mean of the newest six 5 s
+ *             averages in it goes into the 10 minute window.  Gusts block
+ *             the same way: the strongest second of each 5 s block goes into
+ *             the 2 minute gust window, and the strongest of each 30 s block
+ *             into the 10 minute one.
+ */
 void WSA80422::wind_calcs_per_second ( void ) {
-	int16_t x, y;
+	wind_calcs_per_second( 1 );
+}
+
+/**
+ * @brief      Takes the wind samples for the seconds since the last call,
+ *             when it comes late - the pulses are shared out evenly over
+ *             them, so a stall is neither read as one strong second nor
+ *             followed by calm ones.  The vane is read once for all of
+ *             them.
+ */
+void WSA80422::wind_calcs_per_second ( uint16_t seconds ) {
 	WINDDIR wind_dir = getWindDir();
-	
-	noInterrupts();
-	uint32_t wind_spd_pls = getWindAcc();
-	resetWindAcc();
-	interrupts();
-	uint32_t speed = wind_spd_pls * 1492;
-    x = wind_vector_ary[3*wind_dir+1];
-	y = wind_vector_ary[3*wind_dir+2];
-
-	w_dir_5s_x[idx5s] = x;
-	w_dir_5s_y[idx5s] = y;
-	w_spd_5s[idx5s] = speed;
-	idx5s += 1;
-	if ( idx5s == 5 ) {
-		int16_t avg_x;
-		int16_t avg_y;
-		uint32_t avg_spd;
-		uint8_t i;
-		for ( i = 0; i<5; i++ ) {
-			avg_y += w_dir_5s_y[i];
-			avg_x += w_dir_5s_x[i];
-			avg_spd += w_spd_5s[i];
+	uint32_t pulses = takeWindAcc();
+	uint32_t shared = 0;
+
+	if ( 0 == seconds ) {
+		seconds = 1;
+	}
+	for ( uint32_t i = 1; i <= seconds; i++ ) {
+		uint32_t upto = pulses * i / seconds;
+		wind_second( upto - shared, wind_dir );
+		shared = upto;
+	}
+}
+
+/**
+ * @brief      One second of wind into the windows.
+ */
+void WSA80422::wind_second( uint32_t wind_spd_pls, WINDDIR wind_dir ) {
+	int16_t x, y;
+	/* mph x 100, 1.492 mph a pulse per second */
+	uint32_t speed = ( wind_spd_pls * 1492 + 5 ) / 10;
+    x = (int16_t) pgm_read_word( &wind_vector_ary[3*wind_dir+1] );
+	y = (int16_t) pgm_read_word( &wind_vector_ary[3*wind_dir+2] );
+
+	uint8_t gust_pls = ( wind_spd_pls > 0xFF ) ? 0xFF : (uint8_t) wind_spd_pls;
+	if ( gust_pls >= gust_5s_pls ) {
+		gust_5s_pls = gust_pls;
+		gust_5s_dir = wind_dir;
+	}
+
+	w_dir_5s_x.push( x );
+	w_dir_5s_y.push( y );
+	w_spd_5s.push( ( speed > 0xFFFF ) ? 0xFFFF : (uint16_t) speed );
+	if ( w_spd_5s.cycleComplete() ) {
+		gust_2m.push( gust_5s_pls, gust_5s_dir );
+		if ( gust_5s_pls >= gust_30s_pls ) {
+			gust_30s_pls = gust_5s_pls;
+			gust_30s_dir = gust_5s_dir;
 		}
-		avg_y = avg_y/5;
-		avg_x = avg_x/5;
-		avg_spd = avg_spd/5;
-		w_dir_2m_x[idx2m] = avg_x;
-		w_dir_2m_y[idx2m] = avg_y;
-		w_spd_2m[idx2m] = avg_spd;
-		idx2m += 1;
-		if (idx2m == 24) {
-			idx2m = 0;
+		gust_5s_pls = 0;
+		gust_5s_dir = WDIR_ERR;
+		w_dir_2m_x.push( (int16_t) w_dir_5s_x.mean() );
+		w_dir_2m_y.push( (int16_t) w_dir_5s_y.mean() );
+		w_spd_2m.push( (uint16_t) w_spd_5s.mean() );
+		if ( ++w_blocks_30s == WIND_5S_PER_30S ) {
+			uint32_t sum = 0;
+			for ( uint8_t i = 0; i < WIND_5S_PER_30S; i++ ) {
+				sum += w_spd_2m.at( i );
+			}
+			w_spd_10m.push( (uint16_t) ( sum / WIND_5S_PER_30S ) );
+			gust_10m.push( gust_30s_pls, gust_30s_dir );
+			gust_30s_pls = 0;
+			gust_30s_dir = WDIR_ERR;
+			w_blocks_30s = 0;
 		}
-		//Serial.print("Wind Avgs: x=");Serial.print(avg_x);Serial.print(" y=");Serial.println(avg_y);
-		idx5s = 0;
 	}
 }
 
 void WSA80422::rainIRQ_CB( void ) {
-	if ( (millis() - time_of_last_rain_read) > rain_input_debounce_period) // Ignore switch-bounce glitches less than 10ms (142MPH max reading) after the reed switch closes
+	uint32_t now = micros();
+	if ( (now - time_of_last_rain_read) > rain_input_debounce_period * 1000UL) // Ignore switch-bounce glitches less than 10ms (142MPH max reading) after the reed switch closes
 	{
-		time_of_last_rain_read = millis(); //Grab the current time
-		rain_fall_acc += 11; //There is 11 thousands of an inch of rain for every tip of the bucket.
+		time_of_last_rain_read = now;
+		rain_tips++; //There is 11 thousands of an inch of rain for every tip of the bucket.
+		rain_pulses.push( now );
 	}
 }
 
 void WSA80422::windIRQ_CB( void ) {
-	if ( (millis() - time_of_last_wind_read) > wind_input_debounce_period) // Ignore switch-bounce glitches less than 10ms (142MPH max reading) after the reed switch closes
+	uint32_t now = micros();
+	if ( (now - time_of_last_wind_read) > wind_input_debounce_period * 1000UL) // Ignore switch-bounce glitches less than 5ms (298MPH max reading) after the reed switch closes
 	{
-		time_of_last_wind_read = millis(); //Grab the current time
+		time_of_last_wind_read = now;
 		wind_count++; //There is 1.492MPH for each click per second.
+		wind_pulses.push( now );
+	}
+}
+
+/*-----------------------------------------*/
+/* Pulse timing */
+
+/* pulses copied out of a ring per pass */
+#define PULSE_BATCH 8
+
+/**
+ * @brief      Drains the pulse rings in batches and updates the timing based
+ *             wind and rain figures - call from every pass of loop().  Never
+ *             masks interrupts.
+ */
+void WSA80422::service_pulses( void ) {
+	uint32_t batch[PULSE_BATCH];
+	uint8_t n, i;
+
+	while ( ( n = wind_pulses.pop( batch, PULSE_BATCH ) ) ) {
+		for ( i = 0; i < n; i++ ) {
+			wind_pulse( batch[i] );
+		}
+	}
+	while ( ( n = rain_pulses.pop( batch, PULSE_BATCH ) ) ) {
+		for ( i = 0; i < n; i++ ) {
+			rain_pulse( batch[i] );
+		}
+	}
+	/* close the gust bins that ended without a pulse */
+	wind_bins_advance( micros() );
+}
+
+/**
+ * @brief      Closes every 3 s gust bin that ended before t_us.
+ */
+void WSA80422::wind_bins_advance( uint32_t t_us ) {
+	uint8_t closed = 0;
+
+	while ( ( t_us - wind_bin_start_us ) >= WIND_GUST_BIN_US ) {
+		wind_3s_bins.push( wind_bin_count );
+		wind_bin_count = 0;
+		wind_bin_start_us += WIND_GUST_BIN_US;
+		if ( wind_3s_bins.full() && ( wind_3s_bins.sum() > gust_3s_peak ) ) {
+			gust_3s_peak = wind_3s_bins.sum();
+		}
+		if ( ++closed > WIND_GUST_3S_BINS ) {
+			/* a long calm - every bin is empty, skip ahead */
+			wind_bin_start_us = t_us;
+			break;
+		}
+	}
+}
+
+void WSA80422::wind_pulse( uint32_t t_us ) {
+	/* a stamp taken just before the bins were last advanced still counts */
+	if ( (int32_t) ( t_us - wind_bin_start_us ) >= 0 ) {
+		wind_bins_advance( t_us );
+	}
+	if ( wind_bin_count < 0xFF ) {
+		wind_bin_count++;
+	}
+	if ( wind_pulses_seen ) {
+		wind_interval_us = t_us - last_wind_us;
+	}
+	if ( wind_pulses_seen < 2 ) {
+		wind_pulses_seen++;
+	}
+	last_wind_us = t_us;
+}
+
+void WSA80422::rain_pulse( uint32_t t_us ) {
+	if ( rain_tips_seen ) {
+		rain_interval_us = t_us - last_rain_us;
+	}
+	if ( rain_tips_seen < 2 ) {
+		rain_tips_seen++;
+	}
+	last_rain_us = t_us;
+}
+
+/**
+ * @brief      Wind speed from the time between the last two pulses (mph x
+ *             1000).  Once the gap since the last pulse grows longer than
+ *             that the speed falls with it, and reads 0 after WIND_CALM_US.
+ */
+uint32_t WSA80422::get_instant_wind_speed( void ) {
+	service_pulses();
+	if ( wind_pulses_seen < 2 ) {
+		return 0;
+	}
+	uint32_t since = micros() - last_wind_us;
+	if ( since >= WIND_CALM_US ) {
+		return 0;
+	}
+	uint32_t dt = ( since > wind_interval_us ) ? since : wind_interval_us;
+	/* 1.492 mph at one pulse per second */
+	return 1492000000UL / dt;
+}
+
+/**
+ * @brief      Highest 3 s average wind (the WMO gust) since the previous
+ *             call, mph x 1000.  The average slides in 250 ms steps.
+ */
+void WSA80422::get_peak_3s_gust( uint32_t *spd ) {
+	service_pulses();
+	*spd = (uint32_t) gust_3s_peak * 1492 / 3;
+	gust_3s_peak = 0;
+}
+
+/**
+ * @brief      Rain rate from the time between the last two bucket tips, in
+ *             thousandths of an inch per hour.  Falls off like
+ *             get_instant_wind_speed() and reads 0 after RAIN_STOP_MS.
+ */
+uint32_t WSA80422::get_rain_rate( void ) {
+	service_pulses();
+	if ( rain_tips_seen < 2 ) {
+		return 0;
+	}
+	uint32_t since_ms = ( micros() - last_rain_us ) / 1000;
+	if ( since_ms >= RAIN_STOP_MS ) {
+		return 0;
+	}
+	uint32_t dt_ms = rain_interval_us / 1000;
+	if ( since_ms > dt_ms ) {
+		dt_ms = since_ms;
 	}
-}
\ No newline at end of file
+	/* 11 thousandths of an inch per tip, 3 600 000 ms per hour */
+	return 39600000UL / ( dt_ms ? dt_ms : 1 );
+}
+
+/**
+ * @brief      Pulses dropped because a ring was full - should stay 0 as long
+ *             as loop() calls service_pulses() often enough.
+ */
+uint16_t WSA80422::get_pulse_overflows( void ) {
+	return wind_pulses.overflows() + rain_pulses.overflows();
+}
+
+/*-----------------------------------------*/
+/* Wind vane calibration */
+
+/* a bin needs this many hits before it counts as part of a cluster */
+#define WDIR_CAL_MIN_HITS 2
+/* most separate runs of occupied bins tracked before merging */
+#define WDIR_CAL_MAX_RUNS 32
+
+WindVaneCalibration::WindVaneCalibration() {
+	reset();
+}
+
+/**
+ * @brief      Drops all samples.
+ */
+void WindVaneCalibration::reset( void ) {
+	for ( uint16_t i = 0; i < sizeof( hits ); i++ ) {
+		hits[i] = 0;
+	}
+	samples = 0;
+}
+
+uint8_t WindVaneCalibration::bin_hits( uint16_t adc ) {
+	return ( hits[adc >> 2] >> ( ( adc & 3 ) << 1 ) ) & 3;
+}
+
+/**
+ * @brief      Records one raw vane reading in a saturating 2 bit counter per
+ *             ADC code (256 bytes for the whole 10 bit range).
+ */
+void WindVaneCalibration::addSample( uint16_t adc ) {
+	adc &= 0x3FF;
+	uint8_t n = bin_hits( adc );
+	if ( n < 3 ) {
+		hits[adc >> 2] += 1 << ( ( adc & 3 ) << 1 );
+	}
+	if ( samples < 0xFFFF ) {
+		samples++;
+	}
+}
+
+uint16_t WindVaneCalibration::sampleCount( void ) {
+	return samples;
+}
+
+/**
+ * @brief      Finds the cluster centres - runs of occupied ADC codes, with
+ *             the closest neighbouring runs merged until no more than
+ *             WDIR_NUM_BANDS remain.  Each centre is the hit weighted mean
+ *             of its run.
+ *
+ * @param[out] centres  up to WDIR_NUM_BANDS centres in ascending order.
+ *
+ * @return     the number of clusters found.
+ */
+uint8_t WindVaneCalibration::clusters( uint16_t *centres ) {
+	uint16_t first[WDIR_CAL_MAX_RUNS];
+	uint16_t last[WDIR_CAL_MAX_RUNS];
+	uint8_t runs = 0;
+	uint8_t i;
+
+	for ( uint16_t adc = 0; adc < 1024; adc++ ) {
+		if ( bin_hits( adc ) < WDIR_CAL_MIN_HITS ) {
+			continue;
+		}
+		if ( runs && ( last[runs-1] + 1 == adc ) ) {
+			last[runs-1] = adc;
+		}
+		else if ( runs < WDIR_CAL_MAX_RUNS ) {
+			first[runs] = adc;
+			last[runs] = adc;
+			runs++;
+		}
+		else {
+			/* out of slots, fold into the last run */
+			last[runs-1] = adc;
+		}
+	}
+
+	while ( runs > WDIR_NUM_BANDS ) {
+		uint8_t closest = 0;
+		for ( i = 1; i < runs - 1; i++ ) {
+			if ( ( first[i+1] - last[i] ) < ( first[closest+1] - last[closest] ) ) {
+				closest = i;
+			}
+		}
+		last[closest] = last[closest+1];
+		for ( i = closest + 1; i < runs - 1; i++ ) {
+			first[i] = first[i+1];
+			last[i] = last[i+1];
+		}
+		runs--;
+	}
+
+	for ( i = 0; i < runs; i++ ) {
+		uint32_t sum = 0;
+		uint16_t weight = 0;
+		for ( uint16_t adc = first[i]; adc <= last[i]; adc++ ) {
+			uint8_t n = bin_hits( adc );
+			if ( n >= WDIR_CAL_MIN_HITS ) {
+				sum += (uint32_t) adc * n;
+				weight += n;
+			}
+		}
+		centres[i] = (uint16_t) ( ( sum + weight / 2 ) / weight );
+	}
+	return runs;
+}
+
+/**
+ * @brief      Builds a decode table from the learned centres - each
+ *             threshold sits half way between neighbouring centres and the
+ *             last one as far above the top centre as the one before it is
+ *             below.
+ *
+ * @param[out] thresholds  WDIR_NUM_BANDS entries for setWindDirTable().
+ *
+ * @return     false unless all WDIR_NUM_BANDS positions have been seen.
+ */
+bool WindVaneCalibration::compute( uint16_t *thresholds ) {
+	uint16_t c[WDIR_NUM_BANDS];
+	uint8_t i;
+
+	if ( WDIR_NUM_BANDS != clusters( c ) ) {
+		return false;
+	}
+	for ( i = 0; i < WDIR_NUM_BANDS - 1; i++ ) {
+		thresholds[i] = ( c[i] + c[i+1] + 1 ) / 2;
+	}
+	uint16_t last = c[WDIR_NUM_BANDS-1] + ( c[WDIR_NUM_BANDS-1] - thresholds[WDIR_NUM_BANDS-2] );
+	thresholds[WDIR_NUM_BANDS-1] = ( last > 1024 ) ? 1024 : last;
+	return true;
+}
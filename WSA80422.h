@@ -70,6 +70,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "Arduino.h"
+#include "RingAccumulator.h"
+#include "MonotonicMaxDeque.h"
+#include "PulseRing.h"
 
 typedef enum WINDDIR
 {
@@ -92,6 +95,37 @@ typedef enum WINDDIR
 	WDIR_ERR
 } WINDDIR_T;
 
+/* @brief      Number of resistor positions the wind vane can report */
+#define WDIR_NUM_BANDS 16
+
+/* @brief      Gust window reported as windgustmph/windgustdir, in 5 s
+ *             blocks - each block keeps its strongest 1 s sample */
+#define WIND_GUST_2M_BLOCKS 24
+
+/* @brief      windgustmph_10m window, in 30 s blocks - each keeps the
+ *             strongest of its six 5 s blocks */
+#define WIND_GUST_10M_BLOCKS 20
+
+/* @brief      10 minute mean speed window, in 30 s blocks of six 5 s means */
+#define WIND_SPD_10M_BLOCKS 20
+#define WIND_5S_PER_30S 6
+
+/* @brief      Pulse timestamp ring sizes - the wind ring holds about 300 ms
+ *             of pulses at 150 mph */
+#define WIND_PULSE_RING_SIZE 32
+#define RAIN_PULSE_RING_SIZE 8
+
+/* @brief      3 s gust bins - WIND_GUST_3S_BINS bins of WIND_GUST_BIN_US */
+#define WIND_GUST_3S_BINS 12
+#define WIND_GUST_BIN_US 250000UL
+
+/* @brief      No pulse for this long reads as calm / no rain */
+#define WIND_CALM_US 3000000UL
+#define RAIN_STOP_MS 900000UL
+
+/* @brief      Rain one bucket tip measures, thousandths of an inch */
+#define RAIN_PER_TIP 11
+
 /* @brief      Rain Fall Report Type */
 typedef enum RAIN_FALL_REPORT_PERIOD
 {
@@ -100,48 +134,125 @@ typedef enum RAIN_FALL_REPORT_PERIOD
 	RF_DAY
 } RF_PERIOD_T;
 
+/**
+ * @brief      Learns the ADC cluster centre of each wind vane position from
+ *             observed samples and turns them into a decode threshold table
+ *             for WSA80422::setWindDirTable().
+ *
+ *             Rotate the vane through all 16 positions while feeding raw
+ *             readings.  The clusters are found from the readings alone, so
+ *             the result is right for whatever divider and reference voltage
+ *             the board has.
+ */
+class WindVaneCalibration {
+public:
+	WindVaneCalibration();
+	void reset( void );
+	void addSample( uint16_t adc );
+	uint16_t sampleCount( void );
+	uint8_t clusters( uint16_t *centres );
+	bool compute( uint16_t *thresholds );
+private:
+	uint8_t bin_hits( uint16_t adc );
+	uint8_t hits[256];
+	uint16_t samples;
+};
+
 class WSA80422 {
 public:
 	WSA80422();
 	bool init ( uint8_t rain_pin, uint8_t wspd_pin, uint8_t wdir_pin );
 	bool init_light_sensor( uint8_t light_pin, uint8_t ref_pin );
 	WINDDIR_T getWindDir();
+	WINDDIR_T decodeWindDir( uint16_t adc );
+	bool setWindDirTable( const uint16_t *thresholds );
+	void getWindDirTable( uint16_t *thresholds );
 	uint16_t getWindDirRaw();
 	uint16_t getWindAcc();
 	void resetWindAcc( void );
 	uint16_t getRainFall( void );
 	void resetRainFallAcc( void );
+	uint16_t takeWindAcc( void );
+	uint16_t takeRainFall( void );
 	void rain_calcs_per_minute( void );
 	void rainIRQ_CB( void );
 	void windIRQ_CB( void );
 	void wind_reset_arrays( void );
 	void wind_calcs_per_second( void );
+	void wind_calcs_per_second( uint16_t seconds );
 	void get_last_a5s_wind( int16_t *x, int16_t *y, uint32_t *spd);
 	void get_a2m_wind( int16_t *x, int16_t *y, uint32_t *spd);
+	uint16_t get_a2m_wind_dir( void );
+	void get_wind_gust( uint32_t *spd, WINDDIR_T *dir );
+	void get_a10m_wind_gust( uint32_t *spd, WINDDIR_T *dir );
+	void service_pulses( void );
+	uint32_t get_instant_wind_speed( void );
+	void get_peak_3s_gust( uint32_t *spd );
+	uint32_t get_rain_rate( void );
+	uint16_t get_pulse_overflows( void );
+	static uint16_t wind_dir_degrees( WINDDIR_T dir );
+	static uint16_t wind_vector_degrees( int32_t x, int32_t y );
 	void get_last_a1hr_24hr_rain( uint16_t *rain_1hr, uint16_t *rain_day );
 	void get_last_a1m_rain( uint16_t *rain );
+	void get_a10m_wind_speed( uint32_t *spd );
 	float get_light_level( void );
+	uint16_t get_light_mv( void );
 private:
-	uint16_t rain_fall_acc;
-	uint16_t acc_rain_1m[60];
-	uint16_t acc_rain_1hr[24];
-	uint16_t wind_count;
+	/* free running pulse counters - only the ISRs write these, the
+	   consumer keeps the value it last took and works in deltas */
+	volatile uint16_t rain_tips;
+	volatile uint16_t wind_count;
+	uint16_t rain_tips_taken;
+	uint16_t wind_count_taken;
+	static uint16_t snapshot( volatile uint16_t *counter );
+	/* rain per minute in bucket tips, and per hour in thousandths of an
+	   inch */
+	RingAccumulator<uint8_t, 60, uint16_t> acc_rain_1m;
+	RingAccumulator<uint16_t, 24, uint32_t> acc_rain_1hr;
+	uint16_t rain_this_hr;      /* rain since acc_rain_1hr was last fed */
 	uint8_t winddir_pin;
 	uint32_t time_of_last_wind_read;
 	uint32_t time_of_last_rain_read;
 	uint8_t wind_input_debounce_period;
 	uint8_t rain_input_debounce_period;
-	int16_t w_dir_5s_x[5];
-	int16_t w_dir_5s_y[5];
-	int16_t w_dir_2m_x[24];
-	int16_t w_dir_2m_y[24];
-	uint32_t w_spd_5s[5];
-	uint32_t w_spd_2m[24];
-	uint8_t idx5s;
-	uint8_t idx2m;
-	uint8_t rf_idx1m;
-	uint8_t rf_idx1hr;
+	/* 1 s samples, 5 s averages and 30 s averages - speeds in mph x 100,
+	   reported as mph x 1000 */
+	RingAccumulator<int16_t, 5> w_dir_5s_x;
+	RingAccumulator<int16_t, 5> w_dir_5s_y;
+	RingAccumulator<uint16_t, 5, uint32_t> w_spd_5s;
+	RingAccumulator<int16_t, 24> w_dir_2m_x;
+	RingAccumulator<int16_t, 24> w_dir_2m_y;
+	RingAccumulator<uint16_t, 24, uint32_t> w_spd_2m;
+	RingAccumulator<uint16_t, WIND_SPD_10M_BLOCKS, uint32_t> w_spd_10m;
+	uint8_t w_blocks_30s;       /* 5 s means since w_spd_10m was last fed */
+	/* gusts - the strongest 1 s pulse count of each block, tagged with the
+	   direction at the time, and the blocks still being filled */
+	MonotonicMaxDeque<uint8_t, WIND_GUST_2M_BLOCKS> gust_2m;
+	MonotonicMaxDeque<uint8_t, WIND_GUST_10M_BLOCKS> gust_10m;
+	uint8_t gust_5s_pls;
+	uint8_t gust_5s_dir;
+	uint8_t gust_30s_pls;
+	uint8_t gust_30s_dir;
+	void wind_second( uint32_t wind_spd_pls, WINDDIR wind_dir );
+	/* pulse timestamps, micros() - filled by the ISRs, drained by service_pulses() */
+	PulseRing<WIND_PULSE_RING_SIZE> wind_pulses;
+	PulseRing<RAIN_PULSE_RING_SIZE> rain_pulses;
+	void wind_pulse( uint32_t t_us );
+	void rain_pulse( uint32_t t_us );
+	void wind_bins_advance( uint32_t t_us );
+	/* consumer side pulse state */
+	uint32_t last_wind_us;
+	uint32_t wind_interval_us;
+	uint8_t wind_pulses_seen;
+	RingAccumulator<uint8_t, WIND_GUST_3S_BINS, uint16_t> wind_3s_bins;
+	uint32_t wind_bin_start_us;
+	uint8_t wind_bin_count;
+	uint16_t gust_3s_peak;
+	uint32_t last_rain_us;
+	uint32_t rain_interval_us;
+	uint8_t rain_tips_seen;
 	uint8_t LIGHT_PIN;
 	uint8_t REF_3V3_PIN;
+	uint16_t wdir_threshold[WDIR_NUM_BANDS];
 };
 #endif
\ No newline at end of file
@@ -74,6 +74,15 @@
 #include "drv_htu21d.h" // need the hut21 driver we are testing.
 #include "MPL3115A2.h"
 #include "WSA80422.h"
+#include "Scheduler.h"
+#include "Acquisition.h"
+#include "StationSample.h"
+#include "Telemetry.h"
+#include "RingLog.h"
+#include "PowerSave.h"
+#include "Profile.h"
+#include "units.h"
+#include "SramBudget.h"
 
 /*-------------------------------------------------*/
 // Hardware pin definitions
@@ -84,6 +93,30 @@
 #define STAT1_PIN		7
 #define STAT2_PIN 		8
 
+// 1: the 5 s report goes out as a binary telemetry frame (decode with
+// host/telemetry_dump), 0: human readable text
+#ifndef TELEMETRY_BINARY
+#define TELEMETRY_BINARY 1
+#endif
+
+// 1: the barometer converts on its own timer in event mode and its group is
+// published only when pressure or temperature moves past a window - the
+// reports, minute means and log then carry it only when it moved.  0: a
+// one-shot conversion with every report
+#ifndef BARO_EVENTS
+#define BARO_EVENTS 0
+#endif
+#define BARO_EVENT_PERIOD_LOG2	2	// a conversion every 4 s
+#define BARO_EVENT_PA			10
+#define BARO_EVENT_C			1
+
+// longest sleep while the EEPROM log is writing or dumping - each pass only
+// moves it on by a byte or a frame
+#define BUSY_SLEEP_US	1000
+
+// free transmit buffer a profile dump line waits for (PROFILE_ENABLE builds)
+#define PROFILE_LINE_ROOM	48
+
 // analog I/O pins
 #define REF_3V3_PIN 	A3
 #define LIGHT_PIN 		A1
@@ -94,19 +127,49 @@ DRV_HTU21D hum_sensor = DRV_HTU21D();
 MPL3115A2 baro = MPL3115A2();
 WSA80422 wStation = WSA80422();
 
-/* define some timers required to handle the weather station
-function calls in a "timely" fashion */
+/* temperature, humidity and pressure, the two sensors' conversions
+overlapped - started by each report, collected from loop() */
+Acquisition env_acq = Acquisition( &hum_sensor, &baro );
+
+/* the station snapshot every producer publishes into and every report,
+log and mean reads from */
+StationPipeline station = StationPipeline();
+
+/* temperature, humidity and pressure over the minute the log records */
+STATION_MEAN_T env_mean;
+
+/* the periodic work, run by the scheduler in priority order - the wind
+and rain windows must keep an exact period, the report can wait */
+Scheduler sched = Scheduler();
 
-long timer_1s_millis;
-long timer_5s_millis;
-long timer_60s_millis;
+/* one record a minute in the EEPROM, for a host that missed the live
+reports - "D<seq>\n" on the serial port dumps it from seq on */
+RingLog station_log = RingLog();
 
-const long timer_1s_preset = 1000;
-const long timer_5s_preset = 5000;
-const long timer_60s_preset = 60000;
+/* idles the core between ticks, conversions and pulses, and keeps count
+of the time it was awake */
+PowerSave power = PowerSave();
 
+/* the globals must leave the core its buffers and the stack its reserve -
+host/bench_sram runs the same sum off the board */
+#if defined(__AVR__)
+static_assert( SRAM_GLOBALS_BYTES <= SRAM_GLOBALS_BUDGET, "sketch globals over the SRAM budget" );
+#endif
 
-const char *wind_name_ary[] =
+int8_t task_wind_1s;
+int8_t task_rain_60s;
+int8_t task_report_5s;
+
+void wind_task( void );
+void rain_task( void );
+void report_task( void );
+void mean_sink( const STATION_SAMPLE_T *s );
+void report_sink( const STATION_SAMPLE_T *s );
+void minute_sink( const STATION_SAMPLE_T *s );
+
+
+/* direction names, kept in flash - print with (const __FlashStringHelper *) */
+const char wind_name_ary[][4] PROGMEM =
 	{
 		"N", /* WDIR_N,   Offset:  0 */
 		"NNW", /* WDIR_NNW, Offset:  3 */
@@ -128,54 +191,48 @@ const char *wind_name_ary[] =
 	};
 
 void rainIRQ( void ) {
+	PROFILE_SCOPE( PROF_ISR_RAIN );
 	wStation.rainIRQ_CB();
+	power.wake();
 }
 
 void windIRQ( void ) {
+	PROFILE_SCOPE( PROF_ISR_WIND );
 	wStation.windIRQ_CB();
+	power.wake();
 }
 
 
-void timer_reset( long *timer_value ) {
-	*timer_value = millis();
-}
-
-bool is_timer_done( long *timer_value, long preset) {
-	long current_time = millis();
-	if ( (current_time - *timer_value) > preset) {
-		*timer_value = current_time;
-		return true;
-	}
-	return false;
-}
-
 void setup() {
     Serial.begin(9600);
 
     if ( hum_sensor.init() ) {
-        Serial.println("\n\nHumidity Sensor Init'd!");
+        Serial.println(F("\n\nHumidity Sensor Init'd!"));
     }
     else {
-        Serial.println("\n\nERR: Hum Sensor FAILED Init!");
+        Serial.println(F("\n\nERR: Hum Sensor FAILED Init!"));
         while(1);
     }
 
-    Serial.println("MPL3115A2.c test!");
+    Serial.println(F("MPL3115A2.c test!"));
     if ( baro.init( true ) ){
-        Serial.println("MPL3115A2 init'd!");
+        Serial.println(F("MPL3115A2 init'd!"));
         baro.setPressure_Mode();
+#if BARO_EVENTS
+        baro.startEvents( BARO_EVENT_PERIOD_LOG2, BARO_EVENT_PA, BARO_EVENT_C );
+#endif
     }
     else {
-    	Serial.println("\n\nERR: MPL3115A2 Sensor FAILED Init!");
+    	Serial.println(F("\n\nERR: MPL3115A2 Sensor FAILED Init!"));
         while(1);
     }
 
-    Serial.println("WSA80422.c test!");
+    Serial.println(F("WSA80422.c test!"));
     if ( wStation.init( 2, 3, A0 ) ){
-        Serial.println("WSA80422 init'd!");
+        Serial.println(F("WSA80422 init'd!"));
     }
     else {
-    	Serial.println("\n\nERR: WSA80422 Sensor FAILED Init!");
+    	Serial.println(F("\n\nERR: WSA80422 Sensor FAILED Init!"));
         while(1);
     }
 
@@ -186,98 +243,373 @@ void setup() {
 	//pinMode(REF_3V3_PIN, INPUT);
 	//pinMode(LIGHT_PIN, INPUT);
 
-	timer_reset(&timer_1s_millis);
-	timer_reset(&timer_5s_millis);
-	timer_reset(&timer_60s_millis);
-
 	wStation.wind_reset_arrays();
+
+	station_log.begin( 0, EEPROM.length() );
+#if !TELEMETRY_BINARY
+	Serial.print(F("Log resumes at "));
+	Serial.println(station_log.nextSeq());
+#endif
+
+	task_wind_1s = sched.addTask(wind_task, 1000, 0);
+	/* a late wind tick shares its pulses over the seconds it missed -
+	back to back catch-up runs would read them as one gusty second */
+	sched.setCatchUp(task_wind_1s, false);
+	task_rain_60s = sched.addTask(rain_task, 60000, 1);
+	task_report_5s = sched.addTask(report_task, 5000, 2);
+	sched.start();
+
+	station_mean_reset( &env_mean );
+	station.addSink( mean_sink, STATION_VALID_HTU | STATION_VALID_MPL );
+	station.addSink( report_sink, STATION_VALID_WIND );
+	station.addSink( minute_sink, STATION_VALID_RAIN );
+	env_acq.start();
+	power.resetStats();
 }
 
 
 
-//Returns the voltage of the light sensor based on the 3.3V rail
-//This allows us to ignore what VCC might be (an Arduino plugged into USB has VCC of 4.5 to 5.2V)
-float get_light_level()
-{
-	return wStation.get_light_level();
+/* prints v / 10^decimals with a fixed number of decimals, no float */
+void print_fixed( int32_t v, uint8_t decimals ) {
+	uint32_t scale = 1;
+	for ( uint8_t i = 0; i < decimals; i++ ) {
+		scale *= 10;
+	}
+	if ( v < 0 ) {
+		Serial.print('-');
+		v = -v;
+	}
+	Serial.print( (uint32_t) v / scale );
+	if ( decimals ) {
+		Serial.print('.');
+		uint32_t frac = (uint32_t) v % scale;
+		for ( scale /= 10; scale > 1 && frac < scale; scale /= 10 ) {
+			Serial.print('0');
+		}
+		Serial.print( frac );
+	}
 }
 
 void test_MPL3115A2( void ) {
-	Serial.println("--------  MPL3115A2  -----------");
-    Serial.print(baro.getPressure_Pa());Serial.println(" pascals.");
-    Serial.print(baro.getPressure_InHg()); Serial.println(" Inches (Hg)");
-    Serial.print(baro.getTemperature()); Serial.println("*C");
+	Serial.println(F("--------  MPL3115A2  -----------"));
+    Serial.print(baro.getPressure_Pa());Serial.println(F(" pascals."));
+    Serial.print(baro.getPressure_InHg()); Serial.println(F(" Inches (Hg)"));
+    Serial.print(baro.getTemperature()); Serial.println(F("*C"));
 }
 
 void test_HTU21D( void ) {
-	Serial.println("-----------   HTU21D    --------");
-    Serial.print(hum_sensor.getTemp_C()); Serial.print(" *C\t");
-    Serial.print(hum_sensor.getTemp_F()); Serial.println(" *F");
-    Serial.print(hum_sensor.getHumidity());Serial.println("%");
+	Serial.println(F("-----------   HTU21D    --------"));
+    Serial.print(hum_sensor.getTemp_C()); Serial.print(F(" *C\t"));
+    Serial.print(hum_sensor.getTemp_F()); Serial.println(F(" *F"));
+    Serial.print(hum_sensor.getHumidity());Serial.println(F("%"));
 }
 
 void test_WSA80422( void ) {
-	Serial.println("-------   BOARD LEVEL   --------");
-    Serial.print("Light: ");
-    Serial.print(get_light_level()); Serial.println(" (lumens ?)\t");
+	Serial.println(F("-------   BOARD LEVEL   --------"));
+    Serial.print(F("Light: "));
+    print_fixed(wStation.get_light_mv(), 3); Serial.println(F(" V\t"));
 
-    Serial.print("Wind: ");
+    Serial.print(F("Wind: "));
     uint16_t wind_counts = wStation.getWindAcc();
-    Serial.print(wind_counts); Serial.print(" counts,\t");
+    Serial.print(wind_counts); Serial.print(F(" counts,\t"));
     
-    Serial.print(", dir: ");
-    Serial.print(wStation.getWindDirRaw()); Serial.println(" raw dir\t");
+    Serial.print(F(", dir: "));
+    Serial.print(wStation.getWindDirRaw()); Serial.println(F(" raw dir\t"));
     
 }
 
-void print_temperatures( void ) {
-	float c1, c2, c_avg, f_avg, h;
-	c1 = baro.getTemperature();
-	c2 = hum_sensor.getTemp_C();
-	c_avg = (c1 + c2)/2;
-	f_avg = (9.0/5.0)*c_avg + 32.0;
-	Serial.println("Temperatures:");
-	Serial.print(c1); Serial.print("*C, ");
-	Serial.print(c2); Serial.println("*C");
-	Serial.print("  Averages:");
-	Serial.print(c_avg); Serial.print("*C / ");Serial.print(f_avg); Serial.println("*F");
+void print_temperatures( const STATION_SAMPLE_T *s ) {
+	bool htu = ( 0 != ( s->valid & STATION_VALID_HTU ) );
+	bool mpl = ( 0 != ( s->valid & STATION_VALID_MPL ) );
+	int16_t c1 = s->temp_mpl_c100;
+	int16_t c2 = s->temp_htu_c100;
+	Serial.println(F("Temperatures:"));
+	if ( mpl ) { print_fixed(c1, 2); } else { Serial.print(F("--")); }
+	Serial.print(F("*C, "));
+	if ( htu ) { print_fixed(c2, 2); } else { Serial.print(F("--")); }
+	Serial.println(F("*C"));
+	if ( htu || mpl ) {
+		int16_t c_avg = ( htu && mpl ) ? (int16_t) units_div_round( (int32_t) c1 + c2, 2 )
+		                               : ( htu ? c2 : c1 );
+		Serial.print(F("  Averages:"));
+		print_fixed(c_avg, 2); Serial.print(F("*C / "));
+		print_fixed(units_c100_to_f100( c_avg ), 2); Serial.println(F("*F"));
+	}
+	Serial.print(F("Humidity: "));
+	if ( htu ) { print_fixed(s->humidity_c100, 2); } else { Serial.print(F("--")); }
+	Serial.println(F("%"));
 }
 
-void print_wind_data( void ) {
-	int16_t x, y;
-	uint32_t spd;
-	wStation.get_last_a5s_wind( &x, &y, &spd);
-	Serial.println("Wind x, y, speed:");
-	Serial.print(x);Serial.print(", ");
-	Serial.print(y);Serial.print(", ");
-	Serial.println(spd);
+void print_wind_data( const STATION_SAMPLE_T *s ) {
+	Serial.println(F("Wind x, y, speed:"));
+	Serial.print(s->wind_x);Serial.print(F(", "));
+	Serial.print(s->wind_y);Serial.print(F(", "));
+	Serial.println(s->wind_spd);
+
+	Serial.print(F("2 min avg: "));
+	Serial.print(s->wind_spd_2m); Serial.print(F(" @ "));
+	Serial.println(s->wind_dir_2m);
+	Serial.print(F("Gust: "));
+	Serial.print(s->gust_spd); Serial.print(F(" @ "));
+	Serial.println((const __FlashStringHelper *) wind_name_ary[s->gust_dir]);
+	Serial.print(F("10 min gust: "));
+	Serial.print(s->gust_10m_spd); Serial.print(F(" @ "));
+	Serial.println((const __FlashStringHelper *) wind_name_ary[s->gust_10m_dir]);
+	Serial.print(F("Now: "));
+	Serial.print(s->wind_now);
+	Serial.print(F(", 3 s gust: "));
+	Serial.println(s->gust_3s);
 }
 
-void print_rain_data( void ) {
-	uint16_t r_min, r_hr, r_day;
-	wStation.get_last_a1m_rain( &r_min );
-	Serial.println("Rain last minute:");
-	Serial.println(r_min);
-	Serial.println("Rain last hour, Daily total:");
-	wStation.get_last_a1hr_24hr_rain( r_hr, r_day );
-	Serial.print(r_min);Serial.print(", ");Serial.print(r_day);
+void print_rain_data( const STATION_SAMPLE_T *s ) {
+	Serial.println(F("Rain last minute:"));
+	Serial.println(s->rain_1m);
+	Serial.println(F("Rain last hour, Daily total:"));
+	Serial.print(s->rain_1hr);Serial.print(F(", "));Serial.println(s->rain_day);
+	Serial.print(F("Rain rate: "));
+	Serial.println(s->rain_rate);
+	if ( s->pulse_overflows ) {
+		Serial.print(F("ERR: pulses dropped: "));
+		Serial.println(s->pulse_overflows);
+	}
 }
 
-void loop() {
-	
-	if ( is_timer_done( &timer_5s_millis, timer_5s_preset ) ) {
-		Serial.println("\n---------------\n");
-		print_wind_data();
-		print_temperatures();
-		Serial.print("Light Level: ");Serial.println(get_light_level());
+void print_sched_task( const __FlashStringHelper *name, int8_t id ) {
+	SCHED_STATS_T st;
+	if ( !sched.getStats( id, &st ) ) {
+		return;
+	}
+	Serial.print(name);
+	Serial.print(F(" runs "));Serial.print(st.runs);
+	Serial.print(F(", late mean/max "));Serial.print(sched.meanLateUs( id ));
+	Serial.print(F("/"));Serial.print(st.late_max_us);
+	Serial.print(F(" us, exec max "));Serial.print(st.exec_max_us);
+	Serial.print(F(" us, overruns "));Serial.print(st.overruns);
+	Serial.print(F(", skipped "));Serial.println(st.skipped);
+}
+
+void print_sched_stats( void ) {
+	Serial.println(F("Scheduler:"));
+	print_sched_task(F("  wind 1s:  "), task_wind_1s);
+	print_sched_task(F("  rain 60s: "), task_rain_60s);
+	print_sched_task(F("  report 5s:"), task_report_5s);
+}
+
+void print_power_stats( void ) {
+	POWER_STATS_T st;
+	power.getStats( &st );
+	Serial.print(F("Awake: "));print_fixed(power.awakePermille(), 1);
+	Serial.print(F("% of "));Serial.print(st.elapsed_ms / 1000);
+	Serial.print(F(" s, sleeps "));Serial.print(st.sleeps);
+	Serial.print(F(", woken early "));Serial.println(st.early_wakes);
+}
+
+void wind_task( void ) {
+	PROFILE_ADD( PROF_LATE_WIND, sched.lateUs() );
+	PROFILE_SCOPE( PROF_TASK_WIND );
+	wStation.wind_calcs_per_second( sched.runTicks() );
+}
+
+void send_telemetry( const STATION_SAMPLE_T *s ) {
+	static uint16_t seq = 0;
+	TELEMETRY_RECORD_T rec;
+	uint8_t frame[TELEMETRY_FRAME_LEN];
+
+	rec.seq = seq++;
+	rec.time_ms = s->wind_ms;
+	rec.valid = 0;
+	rec.wind_x = s->wind_x;
+	rec.wind_y = s->wind_y;
+	rec.wind_spd = s->wind_spd;
+	rec.wind_dir = WSA80422::wind_vector_degrees( s->wind_x, s->wind_y );
+	rec.wind_spd_2m = s->wind_spd_2m;
+	rec.wind_dir_2m = s->wind_dir_2m;
+	rec.gust_spd = s->gust_spd;
+	rec.gust_dir = WSA80422::wind_dir_degrees( s->gust_dir );
+	rec.gust_10m_spd = s->gust_10m_spd;
+	rec.gust_10m_dir = WSA80422::wind_dir_degrees( s->gust_10m_dir );
+	rec.rain_1m = s->rain_1m;
+	rec.rain_1hr = s->rain_1hr;
+	rec.rain_day = s->rain_day;
+
+	rec.temp_htu_c100 = 0;
+	rec.humidity_c100 = 0;
+	rec.temp_mpl_c100 = 0;
+	rec.pressure_pa4 = 0;
+	if ( s->valid & STATION_VALID_HTU ) {
+		rec.temp_htu_c100 = s->temp_htu_c100;
+		rec.humidity_c100 = (uint16_t) s->humidity_c100;
+		rec.valid |= TELEM_VALID_HTU;
 	}
+	if ( s->valid & STATION_VALID_MPL ) {
+		rec.temp_mpl_c100 = s->temp_mpl_c100;
+		rec.pressure_pa4 = s->pressure_pa4;
+		rec.valid |= TELEM_VALID_MPL_T | TELEM_VALID_MPL_P;
+	}
+	rec.light_mv = s->light_mv;
+
+	size_t n = telemetry_frame( &rec, frame );
+	Serial.write( frame, n );
+}
 
-	if ( is_timer_done( &timer_1s_millis, timer_1s_preset ) ) {
-		wStation.wind_calcs_per_second();
+/* the minute's record for the EEPROM log - the temperature, humidity and
+pressure are the means of the minute's samples */
+void log_minute( const STATION_SAMPLE_T *s ) {
+	RINGLOG_RECORD_T rec;
+	int16_t c, h;
+	uint32_t pa4;
+
+	rec.valid = RINGLOG_VALID_VANE;
+	rec.wind_mph10 = (uint16_t) ( ( s->wind_spd_2m + 50 ) / 100 );
+	rec.wind_dir = s->wind_dir_2m;
+	rec.gust_dir = s->gust_dir;
+	rec.gust_mph10 = (uint16_t) ( ( s->gust_spd + 50 ) / 100 );
+	rec.rain_tips = ( s->rain_1m / 11 > 255 ) ? 255 : (uint8_t) ( s->rain_1m / 11 );
+
+	rec.temp_c100 = 0;
+	rec.humidity_x2 = 0;
+	rec.pressure_pa = 0;
+	if ( station_mean_htu( &env_mean, &c, &h ) ) {
+		rec.temp_c100 = c;
+		rec.humidity_x2 = ( h < 0 ) ? 0 : (uint8_t) ( ( h + 25 ) / 50 );
+		rec.valid |= RINGLOG_VALID_HTU;
+	}
+	if ( station_mean_pa4( &env_mean, &pa4 ) ) {
+		rec.pressure_pa = ( pa4 + 2 ) / 4;
+		rec.valid |= RINGLOG_VALID_BARO;
 	}
+	station_mean_reset( &env_mean );
+	station_log.append( &rec );
+}
 
-	if ( is_timer_done( &timer_60s_millis, timer_60s_preset ) ) {
-		wStation.rain_calcs_per_minute();
+/* host requests, one per line: "D<seq>" dumps the log from seq on, "P"
+dumps and clears the profile (PROFILE_ENABLE builds) */
+void poll_commands( void ) {
+	static char cmd = 0;
+	static uint32_t arg = 0;
+
+	while ( Serial.available() > 0 ) {
+		int c = Serial.read();
+		if ( ( c >= '0' ) && ( c <= '9' ) ) {
+			arg = arg * 10 + ( c - '0' );
+		}
+		else if ( ( '\n' == c ) || ( '\r' == c ) ) {
+			if ( 'D' == cmd ) {
+				station_log.startDump( arg );
+			}
+#if PROFILE_ENABLE
+			else if ( 'P' == cmd ) {
+				profile_dump_start();
+			}
+#endif
+			cmd = 0;
+			arg = 0;
+		}
+		else {
+			cmd = (char) c;
+			arg = 0;
+		}
 	}
+}
+
+/* one dumped record per pass, and only when it fits in the serial buffer */
+void send_log_dump( void ) {
+	uint8_t image[RINGLOG_RECORD_LEN];
+	uint8_t frame[RINGLOG_FRAME_LEN];
+
+	if ( station_log.dumping() && ( Serial.availableForWrite() >= RINGLOG_FRAME_LEN ) &&
+	     station_log.dumpNext( image ) ) {
+		size_t n = RingLog::frame( image, frame );
+		Serial.write( frame, n );
+	}
+}
+
+/* one profile line per pass, once most of the serial buffer is free -
+between telemetry frames the decoder takes the text for a bad frame */
+void send_profile_dump( void ) {
+#if PROFILE_ENABLE
+	if ( Serial.availableForWrite() >= PROFILE_LINE_ROOM ) {
+		profile_dump_next( &Serial );
+	}
+#endif
+}
+
+/* sinks - each reads the one snapshot */
+void mean_sink( const STATION_SAMPLE_T *s ) {
+	station_mean_add( &env_mean, s );
+}
 
+void report_sink( const STATION_SAMPLE_T *s ) {
+#if TELEMETRY_BINARY
+	send_telemetry( s );
+#else
+	Serial.println(F("\n---------------\n"));
+	print_wind_data( s );
+	print_temperatures( s );
+	Serial.print(F("Light Level: "));print_fixed(s->light_mv, 3);Serial.println(F(" V"));
+#endif
+}
+
+void minute_sink( const STATION_SAMPLE_T *s ) {
+	log_minute( s );
+#if !TELEMETRY_BINARY
+	print_rain_data( s );
+	print_sched_stats();
+	print_power_stats();
+#endif
+}
+
+void rain_task( void ) {
+	PROFILE_SCOPE( PROF_TASK_RAIN );
+	wStation.rain_calcs_per_minute();
+	station.publishRain( &wStation );
+	station.dispatch();
+}
+
+void report_task( void ) {
+	PROFILE_SCOPE( PROF_TASK_REPORT );
+	station.publishWind( &wStation );
+	station.publishLight( &wStation );
+	station.dispatch();
+	env_acq.start();
+}
+
+void loop() {
+	{
+		PROFILE_SCOPE( PROF_LOOP );
+		{
+			/* never blocks - only touches the bus once a conversion time is up */
+			PROFILE_SCOPE( PROF_ACQ );
+			if ( env_acq.service() ) {
+				ACQ_SAMPLE_T env;
+				env_acq.getSample( &env );
+				station.publishEnv( &env );
+				station.dispatch();
+			}
+		}
+		{
+			PROFILE_SCOPE( PROF_PULSES );
+			wStation.service_pulses();
+		}
+		{
+			PROFILE_SCOPE( PROF_LOG );
+			station_log.service();
+		}
+		poll_commands();
+		send_log_dump();
+		send_profile_dump();
+
+		sched.run();
+	}
+
+	/* sleep to the next tick or conversion - a pulse or a command wakes it */
+	uint32_t idle_us = sched.usUntilNext();
+	uint32_t acq_ms = env_acq.msUntilDue();
+	if ( ( ACQ_NOT_DUE != acq_ms ) && ( acq_ms < idle_us / 1000 ) ) {
+		idle_us = acq_ms * 1000;
+	}
+	if ( station_log.busy() || station_log.dumping() || PROFILE_DUMPING() ) {
+		idle_us = ( idle_us < BUSY_SLEEP_US ) ? idle_us : BUSY_SLEEP_US;
+	}
+	power.sleepUntil( idle_us );
 }
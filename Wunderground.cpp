@@ -0,0 +1,158 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Wunderground.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "Wunderground.h"
+#include "units.h"
+
+/* output cursor, stops writing (but keeps counting) once the buffer is full */
+typedef struct WU_OUT
+{
+	char *p;
+	char *end;
+	bool full;
+} WU_OUT_T;
+
+static void put_char( WU_OUT_T *o, char c ) {
+	if ( o->p < o->end ) {
+		*o->p++ = c;
+	}
+	else {
+		o->full = true;
+	}
+}
+
+static void put_str( WU_OUT_T *o, const char *s ) {
+	while ( *s ) {
+		put_char( o, *s++ );
+	}
+}
+
+/**
+ * @brief      Percent-encodes everything but the RFC 3986 unreserved
+ *             characters.
+ */
+static void put_escaped( WU_OUT_T *o, const char *s ) {
+	static const char hex[] = "0123456789ABCDEF";
+	for ( ; *s; s++ ) {
+		char c = *s;
+		if ( ( ( c >= 'A' ) && ( c <= 'Z' ) ) || ( ( c >= 'a' ) && ( c <= 'z' ) ) ||
+		     ( ( c >= '0' ) && ( c <= '9' ) ) || ( '-' == c ) || ( '_' == c ) ||
+		     ( '.' == c ) || ( '~' == c ) ) {
+			put_char( o, c );
+		}
+		else {
+			put_char( o, '%' );
+			put_char( o, hex[( (uint8_t) c ) >> 4] );
+			put_char( o, hex[c & 0x0F] );
+		}
+	}
+}
+
+/**
+ * @brief      Prints v / 10^decimals with exactly that many decimals.
+ */
+static void put_fixed( WU_OUT_T *o, int32_t v, uint8_t decimals ) {
+	char digits[11];
+	uint8_t n = 0;
+	uint32_t u;
+
+	if ( v < 0 ) {
+		put_char( o, '-' );
+		u = (uint32_t) ( -( v + 1 ) ) + 1;
+	}
+	else {
+		u = (uint32_t) v;
+	}
+	do {
+		digits[n++] = (char) ( '0' + u % 10 );
+		u /= 10;
+	} while ( u || ( n <= decimals ) );
+
+	while ( n ) {
+		if ( n == decimals ) {
+			put_char( o, '.' );
+		}
+		put_char( o, digits[--n] );
+	}
+}
+
+static void put_field( WU_OUT_T *o, const char *name, int32_t v, uint8_t decimals ) {
+	put_char( o, '&' );
+	put_str( o, name );
+	put_char( o, '=' );
+	put_fixed( o, v, decimals );
+}
+
+/**
+ * @brief      Builds the query string (everything after the '?').
+ *
+ * @param[out] buf      output, NUL terminated.
+ * @param[in]  cap      size of buf, WU_QUERY_MAX is always enough.
+ * @param[in]  station  credentials.
+ * @param[in]  dateutc  "YYYY-MM-DD HH:MM:SS" in UTC, or "now".
+ * @param[in]  rec      the snapshot.
+ *
+ * @return     length without the NUL, 0 if it did not fit.
+ */
+size_t wu_build_query( char *buf, size_t cap, const WU_STATION_T *station,
+                       const char *dateutc, const TELEMETRY_RECORD_T *rec ) {
+	WU_OUT_T o;
+
+	if ( 0 == cap ) {
+		return 0;
+	}
+	o.p = buf;
+	o.end = buf + cap - 1;
+	o.full = false;
+
+	put_str( &o, "ID=" );
+	put_escaped( &o, station->id );
+	put_str( &o, "&PASSWORD=" );
+	put_escaped( &o, station->password );
+	put_str( &o, "&dateutc=" );
+	put_escaped( &o, dateutc );
+
+	/* mph x 1000 -> one decimal */
+	put_field( &o, "winddir", rec->wind_dir, 0 );
+	put_field( &o, "windspeedmph", units_div_round( rec->wind_spd, 100 ), 1 );
+	put_field( &o, "windgustmph", units_div_round( rec->gust_spd, 100 ), 1 );
+	put_field( &o, "windgustdir", rec->gust_dir, 0 );
+	put_field( &o, "windspdmph_avg2m", units_div_round( rec->wind_spd_2m, 100 ), 1 );
+	put_field( &o, "winddir_avg2m", rec->wind_dir_2m, 0 );
+	put_field( &o, "windgustmph_10m", units_div_round( rec->gust_10m_spd, 100 ), 1 );
+	put_field( &o, "windgustdir_10m", rec->gust_10m_dir, 0 );
+
+	/* thousandths of an inch print as they are */
+	put_field( &o, "rainin", rec->rain_1hr, 3 );
+	put_field( &o, "dailyrainin", rec->rain_day, 3 );
+
+	if ( rec->valid & TELEM_VALID_HTU ) {
+		/* hundredths C -> tenths F */
+		int32_t f100 = units_c100_to_f100( rec->temp_htu_c100 );
+		put_field( &o, "tempf", units_div_round( f100, 10 ), 1 );
+		put_field( &o, "humidity", units_div_round( rec->humidity_c100, 10 ), 1 );
+	}
+	if ( rec->valid & TELEM_VALID_MPL_P ) {
+		/* Pa x 4 -> thousandths of inHg */
+		put_field( &o, "baromin", (int32_t) units_pa4_to_inhg1000( rec->pressure_pa4 ), 3 );
+	}
+
+	put_str( &o, "&softwaretype=" );
+	put_escaped( &o, station->software ? station->software : "WeatherStation" );
+	put_str( &o, "&action=updateraw" );
+
+	*o.p = '\0';
+	if ( o.full ) {
+		buf[0] = '\0';
+		return 0;
+	}
+	return (size_t) ( o.p - buf );
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,48 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file Wunderground.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Renders a station snapshot as the query string of a
+ *             Wunderground updateweatherstation.php request.
+ *
+ * @details    Writes straight into the caller's buffer - no heap, no
+ *             String, no float formatting.  Every figure is scaled to an
+ *             integer and printed with a fixed number of decimals, so the
+ *             output is identical on the AVR and the host.  Fields whose
+ *             sensor is marked invalid in the record are left out.
+ *
+ *             dewptf is not sent: it needs a logarithm, and the station does
+ *             not keep one.  dailyrainin is the last 24 complete hours and
+ *             the hour under way, as the station has no clock for local
+ *             midnight.
+ */
+
+#ifndef WUNDERGROUND_H
+#define WUNDERGROUND_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Telemetry.h"
+
+/* @brief      Buffer that always holds a full query with a 32 character
+ *             station ID and password */
+#define WU_QUERY_MAX 512
+
+/* @brief      Station credentials and identity */
+typedef struct WU_STATION
+{
+	const char *id;
+	const char *password;
+	const char *software;   /* softwaretype, may be 0 */
+} WU_STATION_T;
+
+size_t wu_build_query( char *buf, size_t cap, const WU_STATION_T *station,
+                       const char *dateutc, const TELEMETRY_RECORD_T *rec );
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,78 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file cobs.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "cobs.h"
+
+/**
+ * @brief      Stuffs a block.
+ *
+ * @param[in]  in    data, may contain zeros.
+ * @param[in]  len   bytes of data, at most COBS_MAX_BLOCK.
+ * @param[out] out   COBS_ENCODED_LEN(len) bytes, none of them zero.  The
+ *                   caller adds the 0x00 delimiter.
+ *
+ * @return     bytes written, 0 if len is too long.
+ */
+size_t cobs_encode( const uint8_t *in, size_t len, uint8_t *out ) {
+	size_t code_at = 0;
+	size_t o = 1;
+	uint8_t code = 1;
+
+	if ( len > COBS_MAX_BLOCK ) {
+		return 0;
+	}
+	for ( size_t i = 0; i < len; i++ ) {
+		if ( in[i] ) {
+			out[o++] = in[i];
+			code++;
+		}
+		else {
+			out[code_at] = code;
+			code_at = o++;
+			code = 1;
+		}
+	}
+	out[code_at] = code;
+	return o;
+}
+
+/**
+ * @brief      Restores a stuffed block.
+ *
+ * @param[in]  in    encoded bytes without the delimiter.
+ * @param[in]  len   number of encoded bytes.
+ * @param[out] out   at least len - 1 bytes.  May be the same buffer as in.
+ *
+ * @return     decoded length, 0 if the block is malformed (a zero byte or a
+ *             code running past the end).
+ */
+size_t cobs_decode( const uint8_t *in, size_t len, uint8_t *out ) {
+	size_t i = 0;
+	size_t o = 0;
+
+	while ( i < len ) {
+		uint8_t code = in[i++];
+		if ( ( 0 == code ) || ( i + code - 1 > len ) ) {
+			return 0;
+		}
+		for ( uint8_t k = 1; k < code; k++ ) {
+			uint8_t b = in[i++];
+			if ( 0 == b ) {
+				return 0;
+			}
+			out[o++] = b;
+		}
+		if ( ( code < 0xFF ) && ( i < len ) ) {
+			out[o++] = 0;
+		}
+	}
+	return o;
+}
+
+/** @} end of addtogroup */
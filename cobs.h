@@ -0,0 +1,36 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file cobs.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Consistent Overhead Byte Stuffing.
+ *
+ * @details    Rewrites a block so it contains no zero bytes, which leaves 0x00
+ *             free to mark frame boundaries on a byte stream.  Each zero is
+ *             replaced by the distance to the next one, plus one leading code
+ *             byte - an overhead of one byte per 254 bytes of data.  Blocks
+ *             here are limited to 254 bytes so there is always exactly one
+ *             byte of overhead.
+ */
+
+#ifndef COBS_H
+#define COBS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* @brief      Longest block cobs_encode() accepts */
+#define COBS_MAX_BLOCK 254
+
+/* @brief      Encoded size of a block of n bytes */
+#define COBS_ENCODED_LEN(n) ( (n) + 1 )
+
+size_t cobs_encode( const uint8_t *in, size_t len, uint8_t *out );
+size_t cobs_decode( const uint8_t *in, size_t len, uint8_t *out );
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,65 @@
+//------------------------------------------------------------------------------
+/// @addtogroup htu21d_driver HUT21D Driver
+///
+/// @file crc8.cpp
+///
+/// @date       16-OCT-2026
+///
+//------------------------------------------------------------------------------
+#include "crc8.h"
+
+#define CRC8_E(n)    crc8_shift( (uint8_t) (n), 8 )
+#define CRC8_R4(n)   CRC8_E(n), CRC8_E((n) + 1), CRC8_E((n) + 2), CRC8_E((n) + 3)
+#define CRC8_R16(n)  CRC8_R4(n), CRC8_R4((n) + 4), CRC8_R4((n) + 8), CRC8_R4((n) + 12)
+#define CRC8_R64(n)  CRC8_R16(n), CRC8_R16((n) + 16), CRC8_R16((n) + 32), CRC8_R16((n) + 48)
+
+/** @brief crc8_table[i] is the CRC of the single byte i. */
+const uint8_t crc8_table[256] PROGMEM = {
+    CRC8_R64(0), CRC8_R64(64), CRC8_R64(128), CRC8_R64(192)
+};
+
+/**
+ * @brief      Continues a CRC over a buffer of any length.
+ *
+ * @param[in]  crc   the CRC of the data so far (0 to start).
+ * @param[in]  buf   the next data bytes.
+ * @param[in]  len   number of bytes in buf.
+ *
+ * @return     the CRC including buf.
+ */
+uint8_t crc8_update( uint8_t crc, const uint8_t *buf, size_t len ) {
+    while ( len-- ) {
+        crc = crc8_byte( crc, *buf++ );
+    }
+    return crc;
+}
+
+/**
+ * @brief      CRC of a buffer.
+ */
+uint8_t crc8( const uint8_t *buf, size_t len ) {
+    return crc8_update( 0, buf, len );
+}
+
+/**
+ * @brief      Checks a frame whose last byte is the CRC of the bytes before
+ *             it, as sent by the HTU21D.
+ *
+ * @return     true if the frame is intact.
+ */
+bool crc8_verify( const uint8_t *frame, size_t len ) {
+    return ( 0 == crc8_update( 0, frame, len ) );
+}
+
+/**
+ * @brief      Remainder of the 24 bit value (data << 8 | check) divided by the
+ *             polynomial - the same result the old bitwise division in
+ *             DRV_HTU21D::check_crc8 produced.
+ *
+ * @return     0 if the check passes, non-zero if the check fails.
+ */
+uint8_t crc8_check_word( uint16_t data, uint8_t check ) {
+    uint8_t crc = crc8_byte( 0, (uint8_t) ( data >> 8 ) );
+    crc = crc8_byte( crc, (uint8_t) data );
+    return crc ^ check;
+}
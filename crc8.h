@@ -0,0 +1,52 @@
+//------------------------------------------------------------------------------
+/// @addtogroup htu21d_driver HUT21D Driver
+///
+/// @file crc8.h
+///
+/// @date       16-OCT-2026
+///
+/// @brief      Table driven CRC-8 used by the HTU21D frames.
+///
+///             Polynomial x^8 + x^5 + x^4 + 1 (0x131), initial value 0, no
+///             reflection and no final XOR.  The 256 entry table is
+///             generated at compile time and placed in program memory on
+///             the AVR, so a byte costs one table lookup and an XOR instead
+///             of eight shift/compare/XOR steps.
+///
+//------------------------------------------------------------------------------
+#ifndef CRC8_H
+#define CRC8_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Arduino.h"
+
+/* poly:  x^8 + x^5 + x^4 + 1, the x^8 term is implicit in the table */
+#define CRC8_POLY_LOW (0x31)
+
+/**
+ * @brief      Shifts one byte through the polynomial bit by bit, used only
+ *             to build the lookup table at compile time.
+ */
+constexpr uint8_t crc8_shift( uint8_t crc, uint8_t bits ) {
+    return ( 0 == bits ) ? crc :
+        crc8_shift( ( crc & 0x80 ) ? (uint8_t) ( ( crc << 1 ) ^ CRC8_POLY_LOW )
+                                   : (uint8_t) ( crc << 1 ),
+                    (uint8_t) ( bits - 1 ) );
+}
+
+extern const uint8_t crc8_table[256] PROGMEM;
+
+/**
+ * @brief      Feeds one byte into a running CRC.
+ */
+static inline uint8_t crc8_byte( uint8_t crc, uint8_t data ) {
+    return pgm_read_byte( &crc8_table[crc ^ data] );
+}
+
+uint8_t crc8_update( uint8_t crc, const uint8_t *buf, size_t len );
+uint8_t crc8( const uint8_t *buf, size_t len );
+bool crc8_verify( const uint8_t *frame, size_t len );
+uint8_t crc8_check_word( uint16_t data, uint8_t check );
+
+#endif
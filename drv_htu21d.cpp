@@ -38,6 +38,8 @@
 #include "Arduino.h"    
 
 #include "drv_htu21d.h"
+#include "crc8.h"
+#include "units.h"
 
 #if defined(__AVR__)
     #include <util/delay.h>
@@ -58,10 +60,10 @@
 #define DRV_HTU21D_READ_USR_REG    (0xE7)
 #define DRV_HTU21D_SOFTRESET       (0xFE)
 
-#define DRV_HTU21D_MAXRES          0
-#define DRV_HTU21D_LORES           1
-#define DRV_HTU21D_MIDRES          2
-#define DRV_HTU21D_HIRES           3
+/* user register after a soft reset - MAXRES, heater off, OTP reload off */
+#define DRV_HTU21D_USR_REG_DEFAULT (0x02)
+/* resolution bits 7 and 0 of the user register */
+#define DRV_HTU21D_USR_REG_RES     (0x81)
 
 #define DRV_HTU21D_READ_TEMP_LEN 3
 #define DRV_HTU21D_READ_HUMD_LEN 3
@@ -69,15 +71,62 @@
 #define DRV_HTU21D_EXPECTED_TEMP_BYTES (DRV_HTU21D_READ_TEMP_LEN - 1)
 #define DRV_HTU21D_EXPECTED_HUMD_BYTES (DRV_HTU21D_READ_HUMD_LEN - 1)
 
-/* poly:  x^8 + x^5 + x^4 + 1 */    
-#define CRC8_POLYNOMINAL (0b100110001)
+/* measurement status bit - set for humidity, clear for temperature */
+#define DRV_HTU21D_STATUS_HUMIDITY (0x02)
+
+/* the bottom two bits of every measurement are status, not data */
+#define DRV_HTU21D_STATUS_MASK     (0x0003)
+
+#define DRV_HTU21D_DEFAULT_SAMPLE_INTERVAL_MS (1000)
+
+/* no-hold-master pipeline states */
+#define DRV_HTU21D_NHM_IDLE        0
+#define DRV_HTU21D_NHM_TEMP        1
+#define DRV_HTU21D_NHM_HUMD        2
+
+/** @brief      Data bits and maximum conversion time of each measurement at
+ *              one resolution setting. */
+typedef struct DRV_HTU21D_RES_INFO {
+    uint8_t temp_bits;
+    uint8_t hum_bits;
+    uint8_t temp_ms;
+    uint8_t hum_ms;
+} DRV_HTU21D_RES_INFO_T;
+
+/**
+ * @brief      Resolution settings from the datasheet, indexed by
+ *             DRV_HTU21D_MAXRES .. DRV_HTU21D_HIRES.
+ */
+const DRV_HTU21D_RES_INFO_T drv_htu21d_res_info[DRV_HTU21D_HIRES + 1] PROGMEM = {
+    { 14, 12, 50, 16 },     /* MAXRES */
+    { 12,  8, 13,  3 },     /* LORES */
+    { 13, 10, 25,  5 },     /* MIDRES */
+    { 11, 11,  7,  8 }      /* HIRES */
+};
+
+/**
+ * @brief      Resolution option selected by the bits of a user register.
+ */
+static uint8_t res_of_register( uint8_t reg ) {
+    return (uint8_t) ( ( ( reg >> 6 ) & 0x02 ) | ( reg & 0x01 ) );
+}
 
 /**
  * @brief      Constructs the HTU21D Driver
  */
 DRV_HTU21D::DRV_HTU21D() {
     config_changed = false;
-    user_register = 0x02;
+    user_register = DRV_HTU21D_USR_REG_DEFAULT;
+    sensor_res = DRV_HTU21D_MAXRES;
+    nhm_state = DRV_HTU21D_NHM_IDLE;
+    nhm_res = DRV_HTU21D_MAXRES;
+    nhm_start_ms = 0;
+    nhm_pair_ms = 0;
+    sample_interval_ms = DRV_HTU21D_DEFAULT_SAMPLE_INTERVAL_MS;
+    latest_temp_raw = 0;
+    latest_hum_raw = 0;
+    latest_temp_valid = false;
+    latest_hum_valid = false;
 }
 
 /**
@@ -94,16 +143,28 @@ bool DRV_HTU21D::init(void) {
     Wire.write(DRV_HTU21D_READ_USR_REG);
     Wire.endTransmission();
     Wire.requestFrom(DRV_HTU21D_I2CADDR, 1);
-    return (Wire.read() == 0x2); // after reset should be 0x2
+    if ( Wire.read() != DRV_HTU21D_USR_REG_DEFAULT ) {
+        return false;
+    }
+    /* a resolution asked for before init() goes out now */
+    setConfig();
+    return true;
 }
 
 /**
- * @brief      Reset the Humidity Sensor
+ * @brief      Reset the Humidity Sensor.  The sensor comes back at MAXRES;
+ *             a different configuration is written again by the next
+ *             setConfig() or pass through service().
  */
 void DRV_HTU21D::reset(void) {
     Wire.beginTransmission(DRV_HTU21D_I2CADDR);
     Wire.write(DRV_HTU21D_SOFTRESET);
     Wire.endTransmission();
+    nhm_state = DRV_HTU21D_NHM_IDLE;
+    sensor_res = DRV_HTU21D_MAXRES;
+    if ( DRV_HTU21D_USR_REG_DEFAULT != user_register ) {
+        config_changed = true;
+    }
     delay(15);
 }
 
@@ -115,12 +176,15 @@ void DRV_HTU21D::reset(void) {
 float DRV_HTU21D::getTemp_C(void) {
     uint8_t bytes_rxd;
     float tempC_f = -999;
+    /* a new command aborts any no-hold-master conversion in flight */
+    nhm_state = DRV_HTU21D_NHM_IDLE;
+    setConfig();
     // OK lets ready!
     Wire.beginTransmission(DRV_HTU21D_I2CADDR);
     Wire.write(DRV_HTU21D_READTEMP);
     Wire.endTransmission();
 
-    delay(50);
+    delay( conversionTime_ms( false, sensor_res ) );
 
     bytes_rxd = Wire.requestFrom(DRV_HTU21D_I2CADDR, 3);
     /* if les than bytes have not been RXD then the data is not valid */
@@ -138,9 +202,8 @@ float DRV_HTU21D::getTemp_C(void) {
                 tempC_f = -990;
             }
             else {
-                raw_tempC &= ~(0x03);
-                tempC_f = (float) raw_tempC;
-                tempC_f = ((175.72*tempC_f)/65536) - 46.85;
+                raw_tempC &= data_mask( false, sensor_res );
+                tempC_f = units_htu_temp_c100( raw_tempC ) / 100.0f;
             }
         }
     }
@@ -167,12 +230,15 @@ float DRV_HTU21D::getTemp_F(void) {
 float DRV_HTU21D::getHumidity(void) {
     uint8_t rxd_bytes;
     float hum_f = -999;
+    /* a new command aborts any no-hold-master conversion in flight */
+    nhm_state = DRV_HTU21D_NHM_IDLE;
+    setConfig();
 
     Wire.beginTransmission(DRV_HTU21D_I2CADDR);
     Wire.write(DRV_HTU21D_READHUM);
     Wire.endTransmission();
 
-    delay(50);
+    delay( conversionTime_ms( true, sensor_res ) );
 
     rxd_bytes = Wire.requestFrom(DRV_HTU21D_I2CADDR, 3);
     /* if les than bytes have not been RXD then the data is not valid */
@@ -191,15 +257,187 @@ float DRV_HTU21D::getHumidity(void) {
         if ( 0 == check_crc8(raw_hum, crc) ) {
             hum_f = -990;
             if ( raw_hum & 0x02 ) {
-                raw_hum &= ~(0x03);
-                hum_f = (float) raw_hum;
-                hum_f = ((125.0*hum_f)/65536) - 6;
+                raw_hum &= data_mask( true, sensor_res );
+                hum_f = units_htu_humidity_c100( raw_hum ) / 100.0f;
             }
         } 
     }
     return hum_f;
 }
 
+/**
+ * @brief      Starts a no-hold-master temperature conversion and returns
+ *             without waiting.  Collect the result with fetchMeasurement().
+ *
+ * @return     true if the sensor accepted the command.
+ */
+bool DRV_HTU21D::triggerTemp( void ) {
+    Wire.beginTransmission(DRV_HTU21D_I2CADDR);
+    Wire.write(DRV_HTU21D_READTEMP_NHM);
+    return ( 0 == Wire.endTransmission() );
+}
+
+/**
+ * @brief      Starts a no-hold-master humidity conversion and returns
+ *             without waiting.  Collect the result with fetchMeasurement().
+ *
+ * @return     true if the sensor accepted the command.
+ */
+bool DRV_HTU21D::triggerHumidity( void ) {
+    Wire.beginTransmission(DRV_HTU21D_I2CADDR);
+    Wire.write(DRV_HTU21D_READHUM_NHM);
+    return ( 0 == Wire.endTransmission() );
+}
+
+/**
+ * @brief      Attempts to read the result of a triggered conversion.  The
+ *             sensor NACKs its address while the conversion is running, so
+ *             this never blocks.
+ *
+ * @param[in]  humidity  true if a humidity conversion was triggered.
+ * @param[out] raw       the measurement word, the status bits and those unused
+ *                       at the active resolution cleared - valid if
+ *                       HTU21D_FETCH_OK is returned.
+ *
+ * @return     HTU21D_FETCH_BUSY if the conversion has not finished yet.
+ */
+HTU21D_FETCH_T DRV_HTU21D::fetchMeasurement( bool humidity, uint16_t *raw ) {
+    uint8_t bytes_rxd = Wire.requestFrom(DRV_HTU21D_I2CADDR, DRV_HTU21D_READ_TEMP_LEN);
+    if ( DRV_HTU21D_READ_TEMP_LEN > bytes_rxd ) {
+        return HTU21D_FETCH_BUSY;
+    }
+
+    uint16_t value = Wire.read();
+    value <<= 8;
+    value |= Wire.read();
+    uint8_t crc = Wire.read();
+
+    if ( 0 != check_crc8( value, crc ) ) {
+        return HTU21D_FETCH_CRC_ERR;
+    }
+    if ( humidity != ( 0 != ( value & DRV_HTU21D_STATUS_HUMIDITY ) ) ) {
+        return HTU21D_FETCH_STATUS_ERR;
+    }
+    *raw = value & data_mask( humidity, sensor_res );
+    return HTU21D_FETCH_OK;
+}
+
+/**
+ * @brief      Runs the background measurement pipeline - call it every pass
+ *             through the main loop.  Temperature and humidity conversions
+ *             are triggered alternately with the no-hold-master commands and
+ *             a pair is taken every sample interval.  The bus is only used to
+ *             trigger and, once the conversion time of the active resolution
+ *             has passed, to fetch.  A configuration change is written
+ *             between pairs, never under a conversion.
+ */
+void DRV_HTU21D::service( void ) {
+    uint32_t now = millis();
+    uint16_t raw;
+    HTU21D_FETCH_T result;
+
+    switch ( nhm_state ) {
+        case DRV_HTU21D_NHM_IDLE:
+            if ( ( now - nhm_pair_ms ) >= sample_interval_ms ||
+                 !( latest_temp_valid || latest_hum_valid ) ) {
+                setConfig();
+                if ( triggerTemp() ) {
+                    nhm_res = sensor_res;
+                    nhm_pair_ms = now;
+                    nhm_start_ms = now;
+                    nhm_state = DRV_HTU21D_NHM_TEMP;
+                }
+            }
+            break;
+
+        case DRV_HTU21D_NHM_TEMP:
+            if ( ( now - nhm_start_ms ) <= conversionTime_ms( false, nhm_res ) ) {
+                break;
+            }
+            result = fetchMeasurement( false, &raw );
+            if ( HTU21D_FETCH_BUSY == result ) {
+                break;
+            }
+            if ( HTU21D_FETCH_OK == result ) {
+                latest_temp_raw = raw;
+                latest_temp_valid = true;
+            }
+            if ( triggerHumidity() ) {
+                nhm_start_ms = millis();
+                nhm_state = DRV_HTU21D_NHM_HUMD;
+            }
+            else {
+                nhm_state = DRV_HTU21D_NHM_IDLE;
+            }
+            break;
+
+        case DRV_HTU21D_NHM_HUMD:
+            if ( ( now - nhm_start_ms ) <= conversionTime_ms( true, nhm_res ) ) {
+                break;
+            }
+            result = fetchMeasurement( true, &raw );
+            if ( HTU21D_FETCH_BUSY == result ) {
+                break;
+            }
+            if ( HTU21D_FETCH_OK == result ) {
+                latest_hum_raw = raw;
+                latest_hum_valid = true;
+            }
+            nhm_state = DRV_HTU21D_NHM_IDLE;
+            break;
+
+        default:
+            nhm_state = DRV_HTU21D_NHM_IDLE;
+            break;
+    }
+}
+
+/**
+ * @brief      Returns the most recent valid temperature/humidity pair taken
+ *             by service().  Never touches the bus.
+ *
+ * @param[out] temp_c    temperature in Celsius.
+ * @param[out] humidity  relative humidity in %.
+ *
+ * @return     true once both values have been measured at least once.
+ */
+bool DRV_HTU21D::getLatest( float *temp_c, float *humidity ) {
+    int16_t t_c100, rh_c100;
+    if ( !getLatest_c100( &t_c100, &rh_c100 ) ) {
+        return false;
+    }
+    *temp_c = t_c100 / 100.0f;
+    *humidity = rh_c100 / 100.0f;
+    return true;
+}
+
+/**
+ * @brief      getLatest() in fixed point, for code that never needs a
+ *             float.  Never touches the bus.
+ *
+ * @param[out] temp_c100      temperature in hundredths of a degree C.
+ * @param[out] humidity_c100  relative humidity in hundredths of a %.
+ *
+ * @return     true once both values have been measured at least once.
+ */
+bool DRV_HTU21D::getLatest_c100( int16_t *temp_c100, int16_t *humidity_c100 ) {
+    if ( !( latest_temp_valid && latest_hum_valid ) ) {
+        return false;
+    }
+    *temp_c100 = units_htu_temp_c100( latest_temp_raw );
+    *humidity_c100 = units_htu_humidity_c100( latest_hum_raw );
+    return true;
+}
+
+/**
+ * @brief      Sets how often service() takes a temperature/humidity pair.
+ *
+ * @param[in]  interval_ms  time between the starts of consecutive pairs.
+ */
+void DRV_HTU21D::setSampleInterval( uint16_t interval_ms ) {
+    sample_interval_ms = interval_ms;
+}
+
 /**
  * @brief      Sets the sensor resolution.
  *
@@ -211,13 +449,25 @@ float DRV_HTU21D::getHumidity(void) {
  *   |   1   |   0   | 10 bits | 13 bits |  MIDRES   |
  *   |   1   |   1   | 11 bits | 11 bits |  HIRES    |
  *   |-----------------------------------------------|
- *   
- * @param[in]  opt   the resolution option.
- * 
- * @warning This feature is not tested and its unclear if the temperature and humidity calculations require changes based on the expected resolution.  Its best to leave this at the default MAX resolution.  Plus what gains are there for the reduced resolution?
+ *
+ * @details    The gain is speed: a LORES pair converts in 16 ms against
+ *             66 ms at MAXRES.  The sensor sends every measurement left
+ *             aligned in the same 16 bit word, so the conversion formulas do
+ *             not change with resolution - only the unused low bits, which
+ *             are masked off along with the status bits.  The new setting
+ *             goes out with setConfig(), which init(), service() (between
+ *             pairs) and the blocking reads call for it, so it is safe to
+ *             call before init().  host/bench_htu21d measures the rate and
+ *             quantization error of each option.
+ *
+ * @param[in]  opt   the resolution option, DRV_HTU21D_MAXRES to
+ *                   DRV_HTU21D_HIRES - anything else is ignored.
  */
 void DRV_HTU21D::setResolution( uint8_t opt ) {
-    user_register &= 0b01111110;
+    if ( DRV_HTU21D_HIRES < opt ) {
+        return;
+    }
+    user_register &= (uint8_t) ~DRV_HTU21D_USR_REG_RES;
     if( DRV_HTU21D_LORES == opt ) {
         user_register |= 1;
     }
@@ -230,6 +480,48 @@ void DRV_HTU21D::setResolution( uint8_t opt ) {
     config_changed = true;
 }
 
+/**
+ * @brief      The resolution option the sensor is converting at - the last
+ *             one written to it, not one still waiting for setConfig().
+ */
+uint8_t DRV_HTU21D::getResolution( void ) {
+    return sensor_res;
+}
+
+/**
+ * @brief      Number of data bits in a measurement at a resolution option.
+ */
+uint8_t DRV_HTU21D::resolutionBits( bool humidity, uint8_t opt ) {
+    if ( DRV_HTU21D_HIRES < opt ) {
+        opt = DRV_HTU21D_MAXRES;
+    }
+    const DRV_HTU21D_RES_INFO_T *info = &drv_htu21d_res_info[opt];
+    return pgm_read_byte( humidity ? &info->hum_bits : &info->temp_bits );
+}
+
+/**
+ * @brief      Maximum conversion time of a measurement at a resolution
+ *             option.  The pipeline waits until more than this many millis()
+ *             ticks have passed so the first fetch is not NACKed because of
+ *             tick granularity.
+ */
+uint8_t DRV_HTU21D::conversionTime_ms( bool humidity, uint8_t opt ) {
+    if ( DRV_HTU21D_HIRES < opt ) {
+        opt = DRV_HTU21D_MAXRES;
+    }
+    const DRV_HTU21D_RES_INFO_T *info = &drv_htu21d_res_info[opt];
+    return pgm_read_byte( humidity ? &info->hum_ms : &info->temp_ms );
+}
+
+/**
+ * @brief      Mask that keeps the data bits of a measurement word at a
+ *             resolution option and clears the status and unused bits.
+ */
+uint16_t DRV_HTU21D::data_mask( bool humidity, uint8_t opt ) {
+    uint16_t mask = (uint16_t) ( 0xFFFF << ( 16 - resolutionBits( humidity, opt ) ) );
+    return mask & (uint16_t) ~DRV_HTU21D_STATUS_MASK;
+}
+
 /**
  * @brief      Turns the Heater ON  / OFF
  *
@@ -262,6 +554,7 @@ void DRV_HTU21D::setConfig( void ) {
         Wire.write(user_register);
         if ( 0 == Wire.endTransmission() ) {
             config_changed = false;
+            sensor_res = res_of_register( user_register );
         }
     }
 }
@@ -299,6 +592,8 @@ bool DRV_HTU21D::read_HUT_Config( void ) {
     tmp_cfg = Wire.read();
     //if ( 0 == Wire.endTransmission() ) {
         user_register = tmp_cfg;
+        sensor_res = res_of_register( tmp_cfg );
+        config_changed = false;
         success = true;
     //}
     return success;
@@ -312,42 +607,11 @@ bool DRV_HTU21D::read_HUT_Config( void ) {
  * @param[in]  check    the CRC check value (the remainder to insure a zero
  *                      division - if the data is valid.)
  *
- * @todo this routine could stand for optimizations and refactoring.
+ * @note       Uses the lookup table in crc8.cpp - two table reads instead of
+ *             a 24 step polynomial division on 32 bit values.
  *
  * @return     0 if the check passes, non-zero if the check fails.
  */
 uint8_t DRV_HTU21D::check_crc8 ( uint16_t in_data, uint8_t check ) {
-    const uint16_t crc_bit_len = 8;
-    const uint32_t term_bit_pos = 1<<(crc_bit_len-1);
-    uint32_t polynominal = CRC8_POLYNOMINAL;
-    
-    /* pad the data with the crc length.
-     * @note       that the in_data bit length is also changed required so data
-     *             was not lost due to the shift, but orginally the input
-     *             parameter was a 32bit number, however if a 32 value was
-     *             passed to the function (as allowed) then this shift would
-     *             destroy some of the in_data - not good so by forcing the
-     *             input parameter to a 16 bit value, this shift will not
-     *             destroy data without the users knowledge (or at least he
-     *             should know.) */
-    uint32_t data = ( (uint32_t) in_data ) << crc_bit_len;
-    data |= check;
-
-    /* shift the polynomial to align with the bit position */
-    polynominal <<= (32-9);
-
-    /* iterate the XOR division */
-    for ( uint32_t bit_pos=0x80000000; 
-          ( bit_pos > term_bit_pos );  ) 
-    {
-        /* XOR performed if next bit position is a 1 */
-        if ( bit_pos & data ) {
-            data ^= polynominal;
-        }
-        /* shift the bit position marker and polynomial for the next check */
-        bit_pos >>= 1;
-        polynominal >>= 1;
-    }
-
-    return data;
+    return crc8_check_word( in_data, check );
 }
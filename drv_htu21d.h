@@ -34,10 +34,29 @@
 ///
 ///
 //------------------------------------------------------------------------------
+#ifndef DRV_HTU21D_H
+#define DRV_HTU21D_H
+
 #include "Arduino.h"
 #include <stdint.h>
 #include <stdbool.h>
 
+/** @brief      Resolution options for DRV_HTU21D::setResolution(),
+ *              RH / temperature bits. */
+#define DRV_HTU21D_MAXRES          0    /* 12 / 14 */
+#define DRV_HTU21D_LORES           1    /*  8 / 12 */
+#define DRV_HTU21D_MIDRES          2    /* 10 / 13 */
+#define DRV_HTU21D_HIRES           3    /* 11 / 11 */
+
+/** @brief      Result of fetching a no-hold-master measurement. */
+typedef enum HTU21D_FETCH
+{
+    HTU21D_FETCH_OK,
+    HTU21D_FETCH_BUSY,
+    HTU21D_FETCH_CRC_ERR,
+    HTU21D_FETCH_STATUS_ERR
+} HTU21D_FETCH_T;
+
 class DRV_HTU21D {
     public:
         DRV_HTU21D();
@@ -49,10 +68,33 @@ class DRV_HTU21D {
         float getTemp_F(void);
         float getHumidity(void);
         void setResolution( uint8_t );
+        uint8_t getResolution( void );
+        static uint8_t resolutionBits( bool humidity, uint8_t opt );
+        static uint8_t conversionTime_ms( bool humidity, uint8_t opt );
         void setHeater( bool );
+        bool triggerTemp( void );
+        bool triggerHumidity( void );
+        HTU21D_FETCH_T fetchMeasurement( bool humidity, uint16_t *raw );
+        void service( void );
+        bool getLatest( float *temp_c, float *humidity );
+        bool getLatest_c100( int16_t *temp_c100, int16_t *humidity_c100 );
+        void setSampleInterval( uint16_t interval_ms );
     private:
         bool read_HUT_Config(void);
         uint8_t check_crc8(uint16_t, uint8_t);
+        static uint16_t data_mask( bool humidity, uint8_t opt );
         uint8_t user_register;
         bool config_changed;
-};
\ No newline at end of file
+        uint8_t sensor_res;
+        uint8_t nhm_state;
+        uint8_t nhm_res;
+        uint32_t nhm_start_ms;
+        uint32_t nhm_pair_ms;
+        uint16_t sample_interval_ms;
+        uint16_t latest_temp_raw;
+        uint16_t latest_hum_raw;
+        bool latest_temp_valid;
+        bool latest_hum_valid;
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file Arduino.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Linux-native stand-in for the Arduino core used by the weather
+ *             station drivers.  Only the subset of the core the sketch and
+ *             the drivers actually use is provided.  All timing is driven by
+ *             the virtual clock in sim.h, so millis(), micros() and delay()
+ *             never touch the wall clock.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH            (0x1)
+#define LOW             (0x0)
+
+#define INPUT           (0x0)
+#define OUTPUT          (0x1)
+#define INPUT_PULLUP    (0x2)
+
+#define CHANGE          (1)
+#define FALLING         (2)
+#define RISING          (3)
+
+#define DEC             (10)
+#define HEX             (16)
+#define OCT             (8)
+#define BIN             (2)
+
+/* ATmega328P analog pin numbering (A0 == digital 14) */
+#define A0              (14)
+#define A1              (15)
+#define A2              (16)
+#define A3              (17)
+#define A4              (18)
+#define A5              (19)
+#define A6              (20)
+#define A7              (21)
+
+#define NUM_DIGITAL_PINS        (22)
+#define digitalPinToInterrupt(p) ((p) == 2 ? 0 : ((p) == 3 ? 1 : -1))
+
+#ifndef F_CPU
+#define F_CPU           (16000000UL)
+#endif
+
+/* no program memory on the host - plain const data is used.  F() still
+   yields a __FlashStringHelper pointer so the sketch picks the same print
+   overloads it does on the board. */
+#define PROGMEM
+#define pgm_read_byte(addr)     (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)     (*(const uint16_t *)(addr))
+class __FlashStringHelper;
+#define F(str)                  (reinterpret_cast<const __FlashStringHelper *>(str))
+
+unsigned long millis( void );
+unsigned long micros( void );
+void delay( unsigned long ms );
+void delayMicroseconds( unsigned int us );
+
+void pinMode( uint8_t pin, uint8_t mode );
+void digitalWrite( uint8_t pin, uint8_t value );
+int digitalRead( uint8_t pin );
+int analogRead( uint8_t pin );
+
+void attachInterrupt( uint8_t irq, void (*isr)( void ), int mode );
+void detachInterrupt( uint8_t irq );
+void interrupts( void );
+void noInterrupts( void );
+
+/**
+ * @brief      Minimal copy of the Arduino Print class - formats integers and
+ *             floats exactly like the AVR core so captured serial output
+ *             matches the board.
+ */
+class Print {
+public:
+	virtual ~Print() {}
+	virtual size_t write( uint8_t c ) = 0;
+	virtual size_t write( const uint8_t *buf, size_t len );
+	size_t write( const char *str );
+
+	size_t print( const __FlashStringHelper *str );
+	size_t print( const char *str );
+	size_t print( char c );
+	size_t print( unsigned char n, int base = DEC );
+	size_t print( int n, int base = DEC );
+	size_t print( unsigned int n, int base = DEC );
+	size_t print( long n, int base = DEC );
+	size_t print( unsigned long n, int base = DEC );
+	size_t print( double n, int digits = 2 );
+
+	size_t println( void );
+	size_t println( const __FlashStringHelper *str );
+	size_t println( const char *str );
+	size_t println( char c );
+	size_t println( unsigned char n, int base = DEC );
+	size_t println( int n, int base = DEC );
+	size_t println( unsigned int n, int base = DEC );
+	size_t println( long n, int base = DEC );
+	size_t println( unsigned long n, int base = DEC );
+	size_t println( double n, int digits = 2 );
+private:
+	size_t print_number( unsigned long n, uint8_t base );
+	size_t print_float( double n, uint8_t digits );
+};
+
+/**
+ * @brief      Serial port model.  Output is charged at the configured baud
+ *             rate through a 64 byte transmit buffer, so a full buffer blocks
+ *             the caller the same way the AVR core does.  Input is whatever
+ *             the host queued with sim::serial_input().
+ */
+class HardwareSerial : public Print {
+public:
+	HardwareSerial();
+	void begin( unsigned long baud );
+	void end( void );
+	int available( void );
+	int read( void );
+	int availableForWrite( void );
+	void flush( void );
+	size_t write( uint8_t c );
+	using Print::write;
+	operator bool() { return true; }
+private:
+	unsigned long baud_rate;
+	uint64_t tx_queue_end_ns;
+};
+
+extern HardwareSerial Serial;
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,31 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file EEPROM.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Host replacement for the Arduino EEPROM library - the byte
+ *             access subset, on top of avr/eeprom.h.
+ */
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <stdint.h>
+#include <avr/eeprom.h>
+
+class EEPROMClass {
+public:
+	uint8_t read( int idx ) { return eeprom_read_byte( (const uint8_t *) (uintptr_t) idx ); }
+	void write( int idx, uint8_t val ) { eeprom_write_byte( (uint8_t *) (uintptr_t) idx, val ); }
+	void update( int idx, uint8_t val ) { eeprom_update_byte( (uint8_t *) (uintptr_t) idx, val ); }
+	uint16_t length( void ) { return E2END + 1; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,59 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file Wire.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Host replacement for the Arduino TwoWire (I2C master) library.
+ *             Transactions are routed to the simulated devices registered
+ *             with sim::attach_i2c() and each one is charged its bus time
+ *             (START, address, data, ACK and STOP bits at the configured SCL
+ *             rate, plus any clock stretching by the slave) on the virtual
+ *             clock.
+ */
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 32
+
+class TwoWire {
+public:
+	TwoWire();
+	void begin( void );
+	void end( void );
+	void setClock( uint32_t clock_hz );
+	void beginTransmission( uint8_t address );
+	void beginTransmission( int address ) { beginTransmission( (uint8_t) address ); }
+	uint8_t endTransmission( void ) { return endTransmission( (uint8_t) true ); }
+	uint8_t endTransmission( uint8_t send_stop );
+	uint8_t requestFrom( uint8_t address, uint8_t quantity, uint8_t send_stop );
+	uint8_t requestFrom( uint8_t address, uint8_t quantity ) { return requestFrom( address, quantity, (uint8_t) true ); }
+	uint8_t requestFrom( int address, int quantity ) { return requestFrom( (uint8_t) address, (uint8_t) quantity, (uint8_t) true ); }
+	uint8_t requestFrom( int address, int quantity, int send_stop ) { return requestFrom( (uint8_t) address, (uint8_t) quantity, (uint8_t) send_stop ); }
+	size_t write( uint8_t data );
+	size_t write( const uint8_t *data, size_t quantity );
+	size_t write( int data ) { return write( (uint8_t) data ); }
+	int available( void );
+	int read( void );
+	int peek( void );
+	void flush( void ) {}
+private:
+	uint8_t tx_address;
+	uint8_t tx_buffer[BUFFER_LENGTH];
+	uint8_t tx_length;
+	uint8_t rx_buffer[BUFFER_LENGTH];
+	uint8_t rx_length;
+	uint8_t rx_index;
+	bool transmitting;
+};
+
+extern TwoWire Wire;
+
+#endif
+
+/** @} end of addtogroup */
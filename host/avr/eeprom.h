@@ -0,0 +1,31 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file eeprom.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Host replacement for the avr-libc EEPROM routines, backed by
+ *             the simulated EEPROM in sim_eeprom.cpp.  Like the real ones,
+ *             every call first waits for a byte write still in progress.
+ */
+
+#ifndef HOST_AVR_EEPROM_H
+#define HOST_AVR_EEPROM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ATmega328P */
+#define E2END           (0x3FF)
+
+bool eeprom_is_ready( void );
+void eeprom_busy_wait( void );
+uint8_t eeprom_read_byte( const uint8_t *addr );
+void eeprom_write_byte( uint8_t *addr, uint8_t value );
+void eeprom_update_byte( uint8_t *addr, uint8_t value );
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,30 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file sleep.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Host replacement for the avr-libc sleep routines.  sleep_cpu()
+ *             moves the simulated clock on to whatever would wake the core
+ *             - the next timer0 overflow or pulse edge - and runs its ISR,
+ *             so the time a sketch spends asleep shows up in the simulation
+ *             statistics.  Only idle mode is modelled.
+ */
+
+#ifndef HOST_AVR_SLEEP_H
+#define HOST_AVR_SLEEP_H
+
+#include <stdint.h>
+
+#define SLEEP_MODE_IDLE     (0)
+
+void set_sleep_mode( uint8_t mode );
+void sleep_enable( void );
+void sleep_disable( void );
+void sleep_cpu( void );
+
+#endif
+
+/** @} end of addtogroup */
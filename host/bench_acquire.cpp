@@ -0,0 +1,238 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_acquire.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Time to a full environmental sample - HTU21D temperature and
+ *             humidity, MPL3115A2 pressure and temperature - taken one
+ *             sensor after the other with the blocking getters and with the
+ *             conversions overlapped by the Acquisition coordinator, for a
+ *             spread of barometer oversampling ratios and both ends of the
+ *             humidity sensor's resolution range.
+ *
+ *             The overlapped sample must take no longer than the slower of
+ *             the barometer conversion and the HTU21D pair, plus the
+ *             millis() tick each step waits past its conversion time, and
+ *             less than the sequential one.  Every value must match what the
+ *             sensors were given, within a count or the barometer's noise.
+ *
+ *             A sample is then taken the way loop() takes it, sleeping
+ *             msUntilDue() between service() calls, with the barometer's
+ *             ratio lowered as soon as its conversion has started.  It must
+ *             still take the few passes the conversions need, not wake
+ *             early for the new ratio's shorter time.
+ *
+ *             Last, the barometer is put in event mode: the first sample
+ *             must carry its reading, a quiet one must be marked held and
+ *             a step past the window must come through.
+ *
+ *             usage: bench_acquire [--samples N]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "sim.h"
+#include "sim_htu21d.h"
+#include "sim_mpl3115a2.h"
+#include "../drv_htu21d.h"
+#include "../MPL3115A2.h"
+#include "../Acquisition.h"
+
+/* each conversion step ends up to a tick past its time, then the collecting
+   pass and the bus - the HTU21D pair has two steps */
+#define BENCH_STEP_SLACK_MS         (3)
+
+/* event mode pressure window, Pa */
+#define BENCH_EVENT_PA              (10)
+
+/* service() passes a sample may take when driven by msUntilDue(): the two
+   HTU21D steps and the barometer, and a spare each for a result not in */
+#define BENCH_MAX_PASSES            (6)
+
+typedef struct BENCH_CASE {
+	MPL3115A2_OVERSAMPLE_T os;
+	uint8_t res;
+} BENCH_CASE_T;
+
+static SimHTU21D sim_htu;
+static SimMPL3115A2 sim_mpl;
+static DRV_HTU21D htu;
+static MPL3115A2 mpl;
+static Acquisition acq( &htu, &mpl );
+
+/**
+ * @brief      The values an ACQ_SAMPLE_T holds are what the sensors were
+ *             given - a count of the HTU21D, six sigma of the barometer.
+ */
+static bool sample_ok( const ACQ_SAMPLE_T &s, MPL3115A2_OVERSAMPLE_T os, uint8_t res ) {
+	const sim::Environment &e = sim::env();
+	double t_step = 175.72 / ( 1 << DRV_HTU21D::resolutionBits( false, res ) ) + 0.005;
+	double rh_step = 125.0 / ( 1 << DRV_HTU21D::resolutionBits( true, res ) ) + 0.005;
+	double pa_noise = SimMPL3115A2::pressure_noise_pa( (uint8_t) ( os << 3 ) );
+	/* the model's temperature noise is 0.02 C at OS128, scaled like the
+	   pressure, and a count is 1/16 C */
+	double c_tol = 6.0 * 0.02 * pa_noise / 1.5 + 0.0625;
+
+	return ( ( ACQ_VALID_HTU_T | ACQ_VALID_HTU_RH | ACQ_VALID_MPL ) == s.valid ) &&
+	       ( fabs( s.temp_htu_c100 / 100.0 - e.temp_c ) <= t_step ) &&
+	       ( fabs( s.humidity_c100 / 100.0 - e.humidity_pct ) <= rh_step ) &&
+	       ( fabs( s.pressure_pa4 / 4.0 - e.pressure_pa ) <= 6.0 * pa_noise + 0.5 ) &&
+	       ( fabs( s.temp_mpl_c100 / 100.0 - e.temp_c ) <= c_tol );
+}
+
+/**
+ * @brief      One sample the way the sketch read the sensors before: each
+ *             blocking getter in turn.
+ */
+static bool sequential_sample( ACQ_SAMPLE_T *s ) {
+	s->valid = 0;
+	if ( mpl.getPressure( &s->pressure_pa4 ) ) {
+		s->valid |= ACQ_VALID_MPL;
+	}
+	float c = mpl.getTemperature();
+	s->temp_mpl_c100 = (int16_t) lrintf( c * 100.0f );
+	c = htu.getTemp_C();
+	if ( c > -900 ) {
+		s->temp_htu_c100 = (int16_t) lrintf( c * 100.0f );
+		s->valid |= ACQ_VALID_HTU_T;
+	}
+	float rh = htu.getHumidity();
+	if ( rh > -900 ) {
+		s->humidity_c100 = (int16_t) lrintf( rh * 100.0f );
+		s->valid |= ACQ_VALID_HTU_RH;
+	}
+	return true;
+}
+
+int main( int argc, char **argv ) {
+	uint32_t samples = 20;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( !strcmp( argv[i], "--samples" ) && has_arg ) {
+			samples = (uint32_t) strtoul( argv[++i], 0, 0 );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--samples N]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	static const BENCH_CASE_T cases[] = {
+		{ MPL3115A2_OS1, DRV_HTU21D_LORES },
+		{ MPL3115A2_OS1, DRV_HTU21D_MAXRES },
+		{ MPL3115A2_OS8, DRV_HTU21D_MAXRES },
+		{ MPL3115A2_OS16, DRV_HTU21D_MAXRES },
+		{ MPL3115A2_OS32, DRV_HTU21D_MAXRES },
+		{ MPL3115A2_OS128, DRV_HTU21D_LORES },
+		{ MPL3115A2_OS128, DRV_HTU21D_MAXRES }
+	};
+
+	sim::env().temp_c = 18.25;
+	sim::env().humidity_pct = 61.0;
+	sim::env().pressure_pa = 100900.0;
+	sim::attach_i2c( &sim_htu );
+	sim::attach_i2c( &sim_mpl );
+	bool ok = htu.init() && mpl.init( false );
+
+	printf( "bench_acquire: %u samples each, one sensor after the other vs overlapped\n",
+	        samples );
+	printf( "  %-6s %-6s %7s %7s %7s %12s %12s %8s %6s\n", "baro", "htu", "mpl ms",
+	        "htu ms", "sum ms", "sequential", "overlapped", "bound", "saved" );
+	for ( const BENCH_CASE_T &c : cases ) {
+		mpl.setOversampling( c.os );
+		htu.setResolution( c.res );
+		htu.setConfig();
+
+		uint32_t mpl_ms = MPL3115A2::conversionTime_ms( c.os );
+		uint32_t htu_ms = DRV_HTU21D::conversionTime_ms( false, c.res ) +
+		                  DRV_HTU21D::conversionTime_ms( true, c.res );
+		uint32_t bound_ms = ( ( mpl_ms > htu_ms ) ? mpl_ms : htu_ms ) + 2 * BENCH_STEP_SLACK_MS;
+		uint64_t seq_ns = 0, acq_ns = 0, worst_ns = 0;
+		uint32_t bad = 0;
+
+		for ( uint32_t i = 0; i < samples; i++ ) {
+			ACQ_SAMPLE_T s;
+			uint64_t t0 = sim::now_ns();
+			sequential_sample( &s );
+			seq_ns += sim::now_ns() - t0;
+			bad += sample_ok( s, c.os, c.res ) ? 0 : 1;
+
+			t0 = sim::now_ns();
+			bool got = acq.acquire( &s );
+			uint64_t ns = sim::now_ns() - t0;
+			acq_ns += ns;
+			worst_ns = ( ns > worst_ns ) ? ns : worst_ns;
+			bad += ( got && sample_ok( s, c.os, c.res ) ) ? 0 : 1;
+			delay( 10 );
+		}
+
+		double seq_ms = seq_ns / 1e6 / samples;
+		double acq_ms = acq_ns / 1e6 / samples;
+		bool good = !bad && ( worst_ns <= bound_ms * 1000000ULL ) && ( acq_ms < seq_ms );
+		printf( "  OS%-4u %2u/%-2u %7u %7u %7u %9.2f ms %9.2f ms %5u ms %5.1f%%%s\n",
+		        1u << c.os, DRV_HTU21D::resolutionBits( false, c.res ),
+		        DRV_HTU21D::resolutionBits( true, c.res ), mpl_ms, htu_ms, mpl_ms + htu_ms,
+		        seq_ms, acq_ms, bound_ms, 100.0 * ( 1.0 - acq_ms / seq_ms ),
+		        good ? "" : "  <- FAIL" );
+		if ( bad ) {
+			printf( "    %u samples wrong or incomplete\n", bad );
+		}
+		ok = ok && good;
+	}
+	printf( "  bound: the slower conversion plus %u ms\n", 2 * BENCH_STEP_SLACK_MS );
+
+	/* the ratio changed under a running conversion */
+	mpl.setOversampling( MPL3115A2_OS128 );
+	htu.setResolution( DRV_HTU21D_MAXRES );
+	acq.start();
+	mpl.setOversampling( MPL3115A2_OS1 );
+	uint64_t t0 = sim::now_ns();
+	uint32_t passes = 0;
+	while ( acq.busy() && ( passes < 1000 ) ) {
+		delay( acq.msUntilDue() );
+		acq.service();
+		passes++;
+	}
+	ACQ_SAMPLE_T s;
+	uint32_t took_ms = (uint32_t) ( ( sim::now_ns() - t0 ) / 1000000ULL );
+	bool got = acq.getSample( &s ) && sample_ok( s, MPL3115A2_OS128, DRV_HTU21D_MAXRES );
+	uint32_t bound_ms = MPL3115A2::conversionTime_ms( MPL3115A2_OS128 ) + 2 * BENCH_STEP_SLACK_MS;
+	bool good = got && ( passes <= BENCH_MAX_PASSES ) && ( took_ms <= bound_ms );
+	printf( "  OS128 lowered to OS1 mid-conversion: %u passes, %u ms%s\n", passes, took_ms,
+	        good ? "" : "  <- FAIL" );
+	ok = ok && good;
+
+	/* event mode - the barometer is read through pollEvents(), and only a
+	   change is taken.  OS128, so its noise stays well inside the window */
+	mpl.setOversampling( MPL3115A2_OS128 );
+	good = mpl.startEvents( 0, BENCH_EVENT_PA, 1 );
+	delay( 1100 );
+	ACQ_SAMPLE_T first, quiet, moved;
+	good = good && acq.acquire( &first ) && ( first.valid & ACQ_VALID_MPL ) &&
+	       ( fabs( first.pressure_pa4 / 4.0 - sim::env().pressure_pa ) <= BENCH_EVENT_PA );
+	delay( 1000 );
+	good = good && acq.acquire( &quiet ) &&
+	       ( ACQ_MPL_HELD == ( quiet.valid & ( ACQ_VALID_MPL | ACQ_MPL_HELD ) ) );
+	sim::env().pressure_pa += 5 * BENCH_EVENT_PA;
+	delay( 2000 );
+	good = good && acq.acquire( &moved ) && ( moved.valid & ACQ_VALID_MPL ) &&
+	       ( fabs( moved.pressure_pa4 / 4.0 - sim::env().pressure_pa ) <= BENCH_EVENT_PA );
+	mpl.stopEvents();
+	printf( "  event mode: first sample published, quiet one held, %u Pa step published%s\n",
+	        5 * BENCH_EVENT_PA, good ? "" : "  <- FAIL" );
+	ok = ok && good;
+
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
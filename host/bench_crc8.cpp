@@ -0,0 +1,100 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_crc8.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Compares the table driven HTU21D CRC check against the bitwise
+ *             polynomial division it replaced.  Every one of the 2^24
+ *             (data, check) inputs is run through both and must give the
+ *             same remainder before the timings are reported.
+ */
+
+#include <stdio.h>
+#include <chrono>
+
+#include "../crc8.h"
+
+#define CRC8_POLYNOMINAL (0b100110001)
+
+/**
+ * @brief      The original DRV_HTU21D::check_crc8 bitwise division.
+ */
+static uint8_t legacy_check_crc8( uint16_t in_data, uint8_t check ) {
+	const uint16_t crc_bit_len = 8;
+	const uint32_t term_bit_pos = 1 << ( crc_bit_len - 1 );
+	uint32_t polynominal = CRC8_POLYNOMINAL;
+	uint32_t data = ( (uint32_t) in_data ) << crc_bit_len;
+	data |= check;
+
+	polynominal <<= ( 32 - 9 );
+	for ( uint32_t bit_pos = 0x80000000; ( bit_pos > term_bit_pos ); ) {
+		if ( bit_pos & data ) {
+			data ^= polynominal;
+		}
+		bit_pos >>= 1;
+		polynominal >>= 1;
+	}
+	return data;
+}
+
+typedef uint8_t (*check_fn)( uint16_t, uint8_t );
+
+/**
+ * @brief      Runs a check routine over all 2^24 inputs.
+ *
+ * @return     nanoseconds per call.
+ */
+static double time_all( check_fn fn, uint32_t *sink ) {
+	auto t0 = std::chrono::steady_clock::now();
+	uint32_t acc = 0;
+	for ( uint32_t v = 0; v < ( 1UL << 24 ); v++ ) {
+		acc += fn( (uint16_t) ( v >> 8 ), (uint8_t) v );
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	*sink += acc;
+	return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / ( 1UL << 24 );
+}
+
+int main( void ) {
+	uint32_t mismatches = 0;
+	uint32_t passes = 0;
+
+	for ( uint32_t v = 0; v < ( 1UL << 24 ); v++ ) {
+		uint16_t data = (uint16_t) ( v >> 8 );
+		uint8_t check = (uint8_t) v;
+		uint8_t expect = legacy_check_crc8( data, check );
+		if ( crc8_check_word( data, check ) != expect ) {
+			if ( mismatches++ < 10 ) {
+				printf( "mismatch: data=0x%04X check=0x%02X\n", data, check );
+			}
+		}
+		/* the streaming verify must agree on every frame as well */
+		uint8_t frame[3] = { (uint8_t) ( data >> 8 ), (uint8_t) data, check };
+		if ( crc8_verify( frame, 3 ) != ( 0 == expect ) ) {
+			if ( mismatches++ < 10 ) {
+				printf( "verify mismatch: data=0x%04X check=0x%02X\n", data, check );
+			}
+		}
+		passes += ( 0 == expect );
+	}
+
+	printf( "equivalence: %lu inputs, %lu valid frames, %lu mismatches\n",
+	        1UL << 24, (unsigned long) passes, (unsigned long) mismatches );
+	if ( mismatches ) {
+		return 1;
+	}
+
+	uint32_t sink = 0;
+	double legacy_ns = time_all( legacy_check_crc8, &sink );
+	double table_ns = time_all( crc8_check_word, &sink );
+	printf( "bitwise division : %6.2f ns/check\n", legacy_ns );
+	printf( "table lookup     : %6.2f ns/check\n", table_ns );
+	printf( "speedup          : %6.2fx  (sink %lu)\n", legacy_ns / table_ns,
+	        (unsigned long) sink );
+	return 0;
+}
+
+/** @} end of addtogroup */
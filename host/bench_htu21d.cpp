@@ -0,0 +1,222 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_htu21d.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Sample rate against quantization error for each HTU21D
+ *             resolution option.  Runs the driver's no-hold-master pipeline
+ *             back to back at every setting and reports the pairs it takes
+ *             a second, the step of one count and the error of each reading
+ *             against the value the sensor was given.
+ *
+ *             The static run holds a random temperature and humidity for
+ *             two pair times at a stretch, so every reading read back is
+ *             the quantization error alone - it must stay within one count
+ *             of the setting.  The ramp run sweeps both quickly and
+ *             compares the latest pair with the true value every
+ *             millisecond, which adds the age of the reading to the count
+ *             error - the figure that decides what to run during rapid
+ *             changes.  No fetch may be NACKed (the wait matches the mode)
+ *             and the rate must be what the datasheet conversion times
+ *             allow.
+ *
+ *             usage: bench_htu21d [--windows N]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "sim.h"
+#include "sim_htu21d.h"
+#include "../drv_htu21d.h"
+
+/* main loop pass */
+#define BENCH_POLL_MS               (1)
+/* per pair on top of the conversions: two millis() ticks each and the bus */
+#define BENCH_PAIR_SLACK_MS         (5)
+
+/* ramp run: a shielded sensor brought out of a warm house */
+#define BENCH_RAMP_MS               (20000UL)
+#define BENCH_RAMP_C_PER_S          (1.0)
+#define BENCH_RAMP_RH_PER_S         (2.0)
+
+typedef struct BENCH_RES {
+	const char *name;
+	uint8_t opt;
+	double pairs_per_s;
+	double temp_step_c;
+	double rh_step_pct;
+	double temp_worst_c;
+	double rh_worst_pct;
+	double temp_rms_c;      /* ramp run, age included */
+	double rh_rms_pct;
+	uint64_t nacks;
+} BENCH_RES_T;
+
+static SimHTU21D sim_htu;
+static DRV_HTU21D htu;
+
+static void run_ms( uint32_t ms ) {
+	for ( uint32_t t = 0; t < ms; t += BENCH_POLL_MS ) {
+		delay( BENCH_POLL_MS );
+		htu.service();
+	}
+}
+
+static double rand_between( double lo, double hi ) {
+	return lo + ( hi - lo ) * ( rand() / (double) RAND_MAX );
+}
+
+/**
+ * @brief      Fixed values held for two pair times, so the latest pair was
+ *             taken entirely while they held.
+ */
+static bool bench_static( BENCH_RES_T *r, uint32_t windows ) {
+	uint32_t pair_ms = DRV_HTU21D::conversionTime_ms( false, r->opt ) +
+	                   DRV_HTU21D::conversionTime_ms( true, r->opt ) + BENCH_PAIR_SLACK_MS;
+	uint32_t conversions = sim_htu.conversions();
+	uint32_t t0 = millis();
+	bool ok = true;
+
+	for ( uint32_t w = 0; w < windows; w++ ) {
+		double c = rand_between( -20.0, 45.0 );
+		double rh = rand_between( 5.0, 95.0 );
+		sim::env().temp_c = c;
+		sim::env().humidity_pct = rh;
+		run_ms( 2 * pair_ms );
+
+		int16_t c100, rh100;
+		if ( !htu.getLatest_c100( &c100, &rh100 ) ) {
+			return false;
+		}
+		double dc = fabs( c100 / 100.0 - c );
+		double drh = fabs( rh100 / 100.0 - rh );
+		r->temp_worst_c = ( dc > r->temp_worst_c ) ? dc : r->temp_worst_c;
+		r->rh_worst_pct = ( drh > r->rh_worst_pct ) ? drh : r->rh_worst_pct;
+	}
+	r->pairs_per_s = ( sim_htu.conversions() - conversions ) / 2.0 * 1000.0 / ( millis() - t0 );
+
+	/* truncation to a count, then rounding to hundredths */
+	ok = ok && ( r->temp_worst_c <= r->temp_step_c + 0.005 );
+	ok = ok && ( r->rh_worst_pct <= r->rh_step_pct + 0.005 );
+	ok = ok && ( r->pairs_per_s >= 1000.0 / pair_ms );
+	return ok;
+}
+
+/**
+ * @brief      Both quantities ramping, the latest pair checked against the
+ *             true value every pass of the loop.
+ */
+static void bench_ramp( BENCH_RES_T *r ) {
+	double sum_c = 0, sum_rh = 0;
+	uint32_t n = 0;
+
+	/* settle on the starting values first */
+	sim::env().temp_c = 25.0;
+	sim::env().humidity_pct = 30.0;
+	run_ms( 200 );
+	uint32_t t0 = millis();
+
+	for ( uint32_t t = 0; t < BENCH_RAMP_MS; t += BENCH_POLL_MS ) {
+		double s = ( millis() - t0 ) / 1000.0;
+		sim::env().temp_c = 25.0 - BENCH_RAMP_C_PER_S * s;
+		sim::env().humidity_pct = 30.0 + BENCH_RAMP_RH_PER_S * s;
+		delay( BENCH_POLL_MS );
+		htu.service();
+
+		int16_t c100, rh100;
+		if ( htu.getLatest_c100( &c100, &rh100 ) ) {
+			double dc = c100 / 100.0 - sim::env().temp_c;
+			double drh = rh100 / 100.0 - sim::env().humidity_pct;
+			sum_c += dc * dc;
+			sum_rh += drh * drh;
+			n++;
+		}
+	}
+	r->temp_rms_c = n ? sqrt( sum_c / n ) : 0;
+	r->rh_rms_pct = n ? sqrt( sum_rh / n ) : 0;
+}
+
+int main( int argc, char **argv ) {
+	uint32_t windows = 200;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( !strcmp( argv[i], "--windows" ) && has_arg ) {
+			windows = (uint32_t) strtoul( argv[++i], 0, 0 );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--windows N]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	BENCH_RES_T res[] = {
+		{ "MAXRES", DRV_HTU21D_MAXRES, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ "MIDRES", DRV_HTU21D_MIDRES, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ "HIRES", DRV_HTU21D_HIRES, 0, 0, 0, 0, 0, 0, 0, 0 },
+		{ "LORES", DRV_HTU21D_LORES, 0, 0, 0, 0, 0, 0, 0, 0 }
+	};
+
+	srand( 21 );
+	sim::env().temp_c = 21.5;
+	sim::env().humidity_pct = 45.0;
+	sim::attach_i2c( &sim_htu );
+	/* asked for before init() - written by it */
+	htu.setResolution( DRV_HTU21D_LORES );
+	bool ok = htu.init();
+	ok = ok && ( DRV_HTU21D_LORES == htu.getResolution() ) &&
+	     ( 8 == SimHTU21D::humidity_bits( sim_htu.user_register() ) );
+	htu.setSampleInterval( 0 );
+
+	printf( "bench_htu21d: no-hold-master pairs back to back, %u static windows each\n",
+	        windows );
+	printf( "  %-7s %5s %5s %8s %8s %9s %9s %9s %9s\n", "mode", "T/RH", "pair",
+	        "pairs/s", "T step", "T worst", "RH step", "RH worst", "ramp rms" );
+	for ( BENCH_RES_T &r : res ) {
+		/* changed while the pipeline runs - written between pairs */
+		htu.setResolution( r.opt );
+		run_ms( 100 );
+		bool set = ( r.opt == htu.getResolution() ) &&
+		           ( DRV_HTU21D::resolutionBits( false, r.opt ) ==
+		             SimHTU21D::temp_bits( sim_htu.user_register() ) ) &&
+		           ( DRV_HTU21D::resolutionBits( true, r.opt ) ==
+		             SimHTU21D::humidity_bits( sim_htu.user_register() ) );
+
+		r.temp_step_c = 175.72 / ( 1 << DRV_HTU21D::resolutionBits( false, r.opt ) );
+		r.rh_step_pct = 125.0 / ( 1 << DRV_HTU21D::resolutionBits( true, r.opt ) );
+		uint64_t nacks = sim::stats().i2c_nacks;
+		bool good = set && bench_static( &r, windows );
+		bench_ramp( &r );
+		r.nacks = sim::stats().i2c_nacks - nacks;
+		good = good && ( 0 == r.nacks );
+
+		printf( "  %-7s %2u/%-2u %3u ms %8.1f %6.3f C %6.3f C %7.3f %% %7.3f %% "
+		        "%.3f C %.3f %%%s\n",
+		        r.name, DRV_HTU21D::resolutionBits( false, r.opt ),
+		        DRV_HTU21D::resolutionBits( true, r.opt ),
+		        DRV_HTU21D::conversionTime_ms( false, r.opt ) +
+		        DRV_HTU21D::conversionTime_ms( true, r.opt ),
+		        r.pairs_per_s, r.temp_step_c, r.temp_worst_c, r.rh_step_pct, r.rh_worst_pct,
+		        r.temp_rms_c, r.rh_rms_pct, good ? "" : "  <- FAIL" );
+		if ( r.nacks ) {
+			printf( "    %llu fetches NACKed\n", (unsigned long long) r.nacks );
+		}
+		ok = ok && good;
+	}
+	printf( "  ramp: %.1f C/s and %.1f %%RH/s for %lu s, error of the latest pair "
+	        "every %u ms\n", BENCH_RAMP_C_PER_S, BENCH_RAMP_RH_PER_S,
+	        BENCH_RAMP_MS / 1000UL, BENCH_POLL_MS );
+
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,181 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_ingest.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Floods a fleet of PTY stations into the ingest server with 1,
+ *             2, 4 ... workers (up to the number of CPUs) and reports the
+ *             records per second, how well that scales with the workers and
+ *             the lag from read to aggregate.  A last run with tiny water
+ *             marks keeps every station paused most of the time.  Every run
+ *             must deliver every record of every station in order, with no
+ *             CRC errors and none missed.
+ *
+ *             usage: bench_ingest [--stations N] [--records N]
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <thread>
+
+#include "ingest_server.h"
+#include "pty_fleet.h"
+
+#define BENCH_TIMEOUT_MS            (120000)
+
+typedef struct BENCH_RESULT {
+	double records_s;
+	uint64_t lag_hist[INGEST_LAG_BUCKETS];
+	uint64_t lag_max_ns;
+	uint64_t pauses;
+	double stall_ms;
+	bool ok;
+} BENCH_RESULT_T;
+
+static uint64_t now_ms( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void run( unsigned stations, uint64_t records, const IngestServer::Config &cfg,
+                 BENCH_RESULT_T *res ) {
+	memset( res, 0, sizeof( *res ) );
+	PtyFleet fleet;
+	if ( !fleet.open( stations ) ) {
+		perror( "  fleet" );
+		return;
+	}
+	IngestServer srv( cfg );
+	for ( unsigned i = 0; i < fleet.size(); i++ ) {
+		int fd = open( fleet.path( i ).c_str(), O_RDONLY | O_NOCTTY );
+		if ( fd < 0 ) {
+			perror( "  open" );
+			return;
+		}
+		srv.add_stream( fd, fleet.path( i ) );
+	}
+	srv.start();
+
+	PtyFleet::Config fc;
+	fc.flood = true;
+	fc.records = records;
+	uint64_t want = (uint64_t) stations * records;
+	uint64_t start = now_ms();
+	fleet.start( fc );
+	while ( ( srv.records() < want ) && ( now_ms() - start < BENCH_TIMEOUT_MS ) ) {
+		usleep( 1000 );
+	}
+	uint64_t ms = now_ms() - start;
+	fleet.wait();
+	/* everything is in by now - hanging up must not lose anything */
+	fleet.hang_up();
+	while ( !srv.finished() && ( now_ms() - start < BENCH_TIMEOUT_MS ) ) {
+		usleep( 1000 );
+	}
+	srv.stop();
+
+	res->records_s = srv.records() * 1000.0 / ( ms ? ms : 1 );
+	res->stall_ms = fleet.stall_ns() / 1e6;
+	res->ok = ( srv.records() == want );
+	if ( !res->ok ) {
+		printf( "  %llu of %llu records in %llu ms\n", (unsigned long long) srv.records(),
+		        (unsigned long long) want, (unsigned long long) ms );
+	}
+
+	IngestServer::StationView v;
+	for ( size_t i = 0; i < srv.stations(); i++ ) {
+		srv.snapshot( i, &v );
+		if ( ( v.agg.records != records ) || v.agg.missed || v.agg.restarts ||
+		     v.link.crc_errors || v.link.bad_frames || v.open ) {
+			printf( "  station %zu: %llu records, %llu missed, %llu restarts, %llu CRC errors, "
+			        "%llu bad%s\n", i, (unsigned long long) v.agg.records,
+			        (unsigned long long) v.agg.missed, (unsigned long long) v.agg.restarts,
+			        (unsigned long long) v.link.crc_errors,
+			        (unsigned long long) v.link.bad_frames, v.open ? ", still open" : "" );
+			res->ok = false;
+		}
+		for ( unsigned b = 0; b < INGEST_LAG_BUCKETS; b++ ) {
+			res->lag_hist[b] += v.lag_hist[b];
+		}
+		if ( v.lag_max_ns > res->lag_max_ns ) {
+			res->lag_max_ns = v.lag_max_ns;
+		}
+		res->pauses += v.pauses;
+	}
+}
+
+static void report( const char *label, const BENCH_RESULT_T &r, double base_s, unsigned workers ) {
+	printf( "  %-12s %10.0f records/s  x%.2f (%3.0f%%)  lag p50 %6llu us p99 %6llu us "
+	        "max %6.1f ms  %6llu pauses  writers stalled %7.1f ms\n",
+	        label, r.records_s, r.records_s / base_s,
+	        100.0 * r.records_s / ( base_s * workers ),
+	        (unsigned long long) IngestServer::lag_percentile_us( r.lag_hist, 50 ),
+	        (unsigned long long) IngestServer::lag_percentile_us( r.lag_hist, 99 ),
+	        r.lag_max_ns / 1e6, (unsigned long long) r.pauses, r.stall_ms );
+}
+
+int main( int argc, char **argv ) {
+	unsigned stations = 64;
+	uint64_t records = 10000;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( !strcmp( argv[i], "--stations" ) && has_arg ) {
+			stations = (unsigned) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--records" ) && has_arg ) {
+			records = strtoull( argv[++i], 0, 0 );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--stations N] [--records N]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	unsigned cpus = std::thread::hardware_concurrency();
+	unsigned max_workers = ( cpus > 2 ) ? cpus : 2;
+	printf( "bench_ingest: %u stations x %llu records, %u CPUs\n", stations,
+	        (unsigned long long) records, cpus );
+
+	bool ok = true;
+	double base_s = 0;
+	BENCH_RESULT_T r;
+	char label[32];
+	for ( unsigned w = 1; w <= max_workers; w *= 2 ) {
+		IngestServer::Config cfg;
+		cfg.workers = w;
+		run( stations, records, cfg, &r );
+		if ( 1 == w ) {
+			base_s = r.records_s;
+		}
+		snprintf( label, sizeof( label ), "%u workers", w );
+		report( label, r, base_s, w );
+		ok = ok && r.ok;
+	}
+
+	/* a few frames per station in flight at most */
+	IngestServer::Config cfg;
+	cfg.workers = max_workers;
+	cfg.chunk_bytes = 256;
+	cfg.high_water = 512;
+	cfg.low_water = 128;
+	run( stations, records, cfg, &r );
+	report( "back-pressure", r, base_s, max_workers );
+	ok = ok && r.ok && r.pauses;
+
+	if ( cpus < 2 ) {
+		printf( "  (one CPU - the workers share it, so no scaling is expected here)\n" );
+	}
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
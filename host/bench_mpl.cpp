@@ -0,0 +1,619 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_mpl.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Bus cost of taking MPL3115A2 samples.  Runs one-shot
+ *             conversions through the driver, which picks each result up
+ *             with a single STATUS/OUT_P/OUT_T burst, and through the
+ *             register at a time reads it used before (a STATUS read, then
+ *             OUT_P and OUT_T separately), and reports the transactions,
+ *             bytes and bus time each sample costs, the OST write that
+ *             starts it included.  Every result the driver
+ *             decodes must match the output registers read back on their
+ *             own, and the burst must cost fewer transactions.
+ *
+ *             Then measures latency, bus cost and pressure noise for each
+ *             oversampling ratio, and runs the device in batch mode, sampling once a second
+ *             into its FIFO while the pressure follows a steep ramp, and
+ *             drains it every 30 s and once after it has wrapped.  Every
+ *             drained sample must read what the ramp held at its timestamp,
+ *             and the per sample bus cost is set against the one-shot burst.
+ *
+ *             Last it runs event mode through a calm day and a front,
+ *             checking that what was published stays within the windows of
+ *             what the sensor measured, and counts the bus traffic against
+ *             a one-shot sample every report.
+ *
+ *             usage: bench_mpl [--samples N]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "sim.h"
+#include "sim_mpl3115a2.h"
+#include "../MPL3115A2.h"
+#include "../units.h"
+
+#define BENCH_MPL_ADDRESS           (0x60)
+#define BENCH_MPL_STATUS            (0x00)
+#define BENCH_MPL_OUT_P_MSB         (0x01)
+#define BENCH_MPL_OUT_T_MSB         (0x04)
+#define BENCH_MPL_CTRL_REG1         (0x26)
+#define BENCH_MPL_STATUS_PTDR       (0x08)
+/* OS128 | OST, barometer mode */
+#define BENCH_MPL_ONE_SHOT          (0x3A)
+#define BENCH_MPL_CONV_MS           (512)
+/* main loop pass while waiting on a conversion */
+#define BENCH_POLL_MS               (10)
+/* OS128 RMS noise is 1.5 Pa */
+#define BENCH_PRESSURE_TOL_PA       (15.0)
+
+#define BENCH_OS_SAMPLES            (400)
+
+/* batch run: 40 Pa/s ramp, so a sample stamped a second out is 40 Pa off */
+#define BENCH_RAMP_BASE_PA          (95000.0)
+#define BENCH_RAMP_PA_PER_S         (40.0)
+#define BENCH_RAMP_HALF_MS          (200000UL)
+#define BENCH_DRAIN_MS              (30000UL)
+#define BENCH_BATCH_DRAINS          (20)
+/* long enough for the FIFO to wrap */
+#define BENCH_OVERFLOW_MS           (45000UL)
+
+/* event run: 3 h polled at the sketch's report rate, a front after 2 h */
+#define BENCH_EVENT_RUN_MS          (3 * 3600000UL)
+#define BENCH_REPORT_MS             (5000UL)
+#define BENCH_FRONT_S               (7200.0)
+#define BENCH_EVENT_PA              (10)
+#define BENCH_EVENT_C               (1)
+/* noise, target rounding and up to a second of drift in the front */
+#define BENCH_EVENT_PA_SLACK        (12.0)
+#define BENCH_EVENT_C_SLACK         (0.6)
+
+typedef struct BENCH_COST {
+	const char *name;
+	uint32_t samples;
+	uint64_t transactions;
+	uint64_t messages;
+	uint64_t bytes;
+	uint64_t bus_ns;
+	uint64_t read_ns;       /* time spent in the calls that touch the bus */
+} BENCH_COST_T;
+
+static SimMPL3115A2 sim_mpl;
+static MPL3115A2 mpl;
+
+static void charge( BENCH_COST_T *c, const sim::Stats &before, uint64_t t0 ) {
+	const sim::Stats &st = sim::stats();
+	c->transactions += st.i2c_transactions - before.i2c_transactions;
+	c->messages += st.i2c_messages - before.i2c_messages;
+	c->bytes += st.i2c_bytes - before.i2c_bytes;
+	c->bus_ns += st.i2c_ns - before.i2c_ns;
+	c->read_ns += sim::now_ns() - t0;
+}
+
+static bool read_regs( uint8_t reg, uint8_t *data, uint8_t len ) {
+	Wire.beginTransmission( BENCH_MPL_ADDRESS );
+	Wire.write( reg );
+	Wire.endTransmission( false );
+	if ( len != Wire.requestFrom( (uint8_t) BENCH_MPL_ADDRESS, len ) ) {
+		return false;
+	}
+	for ( uint8_t i = 0; i < len; i++ ) {
+		data[i] = (uint8_t) Wire.read();
+	}
+	return true;
+}
+
+/**
+ * @brief      One sample the way the driver took it before the burst read:
+ *             STATUS polls of one register each, then OUT_P and OUT_T.
+ */
+static bool legacy_sample( BENCH_COST_T *c, uint32_t *p_raw, uint16_t *t_raw ) {
+	sim::Stats started = sim::stats();
+	uint64_t t_start = sim::now_ns();
+	Wire.beginTransmission( BENCH_MPL_ADDRESS );
+	Wire.write( BENCH_MPL_CTRL_REG1 );
+	Wire.write( BENCH_MPL_ONE_SHOT );
+	Wire.endTransmission();
+	charge( c, started, t_start );
+	uint32_t start = millis();
+
+	for ( ;; ) {
+		delay( BENCH_POLL_MS );
+		if ( ( millis() - start ) < BENCH_MPL_CONV_MS ) {
+			continue;
+		}
+		sim::Stats before = sim::stats();
+		uint64_t t0 = sim::now_ns();
+		uint8_t sta;
+		uint8_t p[3];
+		uint8_t t[2];
+		bool ok = read_regs( BENCH_MPL_STATUS, &sta, 1 );
+		bool ready = ok && ( sta & BENCH_MPL_STATUS_PTDR );
+		if ( ready ) {
+			ok = read_regs( BENCH_MPL_OUT_P_MSB, p, 3 ) && read_regs( BENCH_MPL_OUT_T_MSB, t, 2 );
+		}
+		charge( c, before, t0 );
+		if ( !ok ) {
+			return false;
+		}
+		if ( ready ) {
+			*p_raw = ( ( (uint32_t) p[0] << 16 ) | ( (uint32_t) p[1] << 8 ) | p[2] ) >> 4;
+			*t_raw = ( (uint16_t) t[0] << 8 ) | t[1];
+			c->samples++;
+			return true;
+		}
+	}
+}
+
+/**
+ * @brief      One sample through the driver as the sketch takes it.
+ */
+static bool driver_sample( BENCH_COST_T *c, uint32_t *p_raw, int16_t *t_c100 ) {
+	sim::Stats before = sim::stats();
+	uint64_t t0 = sim::now_ns();
+	mpl.startConversion();
+	charge( c, before, t0 );
+	uint32_t start = millis();
+
+	for ( ;; ) {
+		delay( BENCH_POLL_MS );
+		bool due = ( ( millis() - start ) >= BENCH_MPL_CONV_MS );
+		sim::Stats before = sim::stats();
+		uint64_t t0 = sim::now_ns();
+		bool ready = mpl.conversionReady();
+		if ( due ) {
+			charge( c, before, t0 );
+		}
+		if ( ready ) {
+			c->samples++;
+			return mpl.collectPressure( p_raw ) && mpl.collectTemperature_c100( t_c100 );
+		}
+		if ( MPL3115A2_CONV_ERROR == mpl.conversionState() ) {
+			return false;
+		}
+	}
+}
+
+static void report( const BENCH_COST_T &c ) {
+	double n = c.samples ? c.samples : 1;
+	printf( "  %-8s %5u samples  %.2f transactions  %.2f messages  %5.1f bytes  "
+	        "%7.1f us bus  %7.1f us awake  per sample\n",
+	        c.name, c.samples, c.transactions / n, c.messages / n, c.bytes / n,
+	        c.bus_ns / n / 1e3, c.read_ns / n / 1e3 );
+}
+
+/**
+ * @brief      One-shot samples through the driver's burst read and through
+ *             the register at a time reads, checked against a read back of
+ *             the output registers.
+ */
+static bool bench_one_shot( uint32_t samples, BENCH_COST_T *burst ) {
+	BENCH_COST_T legacy = { "legacy", 0, 0, 0, 0, 0, 0 };
+	uint32_t mismatches = 0;
+	uint32_t failures = 0;
+	double worst_pa = 0;
+
+	for ( uint32_t i = 0; i < samples; i++ ) {
+		/* walk the weather about so the registers change every sample */
+		sim::env().temp_c = -20.0 + ( i % 97 ) * 0.6;
+		sim::env().pressure_pa = 95000.0 + ( i % 89 ) * 123.0;
+
+		uint32_t p_raw;
+		uint16_t t_raw;
+		if ( !legacy_sample( &legacy, &p_raw, &t_raw ) ) {
+			failures++;
+		}
+
+		int16_t t_c100;
+		if ( !driver_sample( burst, &p_raw, &t_c100 ) ) {
+			failures++;
+			continue;
+		}
+		/* the registers hold until the next conversion - read them back */
+		uint8_t p[3];
+		uint8_t t[2];
+		if ( !read_regs( BENCH_MPL_OUT_P_MSB, p, 3 ) || !read_regs( BENCH_MPL_OUT_T_MSB, t, 2 ) ) {
+			failures++;
+			continue;
+		}
+		uint32_t p_back = ( ( (uint32_t) p[0] << 16 ) | ( (uint32_t) p[1] << 8 ) | p[2] ) >> 4;
+		int16_t t_back = units_mpl_temp_c100( ( (uint16_t) t[0] << 8 ) | t[1] );
+		if ( ( p_back != p_raw ) || ( t_back != t_c100 ) ) {
+			if ( mismatches < 3 ) {
+				printf( "  sample %u: burst %u Pa/4 %d c100, registers %u Pa/4 %d c100\n",
+				        i, p_raw, t_c100, p_back, t_back );
+			}
+			mismatches++;
+		}
+		double err = p_raw / 4.0 - sim::env().pressure_pa;
+		err = ( err < 0 ) ? -err : err;
+		worst_pa = ( err > worst_pa ) ? err : worst_pa;
+	}
+
+	printf( "bench_mpl: %u one-shot conversions at OS128, %lu Hz bus\n",
+	        samples, (unsigned long) ( 1000000000ULL / sim::i2c_bit_ns() ) );
+	report( legacy );
+	report( *burst );
+	printf( "  burst saves %.1fx transactions, %.1fx bus time, %.1fx awake time\n",
+	        (double) legacy.transactions / ( burst->transactions ? burst->transactions : 1 ),
+	        (double) legacy.bus_ns / ( burst->bus_ns ? burst->bus_ns : 1 ),
+	        (double) legacy.read_ns / ( burst->read_ns ? burst->read_ns : 1 ) );
+	printf( "  %u decode mismatches, %u failed samples, pressure within %.2f Pa\n",
+	        mismatches, failures, worst_pa );
+
+	return !mismatches && !failures && ( burst->samples == samples ) &&
+	       ( worst_pa < BENCH_PRESSURE_TOL_PA ) && ( burst->transactions < legacy.transactions );
+}
+
+/*----------------------------------------------------------------------------*/
+/* oversampling */
+
+/**
+ * @brief      Takes BENCH_OS_SAMPLES one-shot samples at every oversampling
+ *             ratio with the pressure held still, from a main loop polling
+ *             every millisecond and through the blocking getter.  Reports
+ *             latency, bus cost and the measured noise: the driver must
+ *             poll the device just once a sample, at the ratio's conversion
+ *             time, and the noise must fall with each step.
+ */
+static bool bench_oversampling( void ) {
+	bool ok = true;
+	double last_noise = 1e9;
+
+	sim::env().pressure_pa = 101325.0;
+	sim::env().temp_c = 20.0;
+	printf( "bench_mpl: oversampling, %u samples each, pressure held at %.0f Pa\n",
+	        BENCH_OS_SAMPLES, sim::env().pressure_pa );
+	printf( "  ratio  table ms  latency ms  blocking ms  transactions  bus us  "
+	        "noise Pa  model Pa\n" );
+
+	for ( int os = MPL3115A2_OS1; os <= MPL3115A2_OS128; os++ ) {
+		BENCH_COST_T c = { "", 0, 0, 0, 0, 0, 0 };
+		double sum = 0;
+		double sum_sq = 0;
+		uint64_t latency_ns = 0;
+		uint64_t worst_ns = 0;
+		uint32_t failures = 0;
+
+		mpl.setOversampling( (MPL3115A2_OVERSAMPLE_T) os );
+		uint16_t table_ms = MPL3115A2::conversionTime_ms( (MPL3115A2_OVERSAMPLE_T) os );
+
+		for ( uint32_t i = 0; i < BENCH_OS_SAMPLES; i++ ) {
+			uint64_t t_start = sim::now_ns();
+			sim::Stats before = sim::stats();
+			mpl.startConversion();
+			while ( !mpl.conversionReady() &&
+			        ( MPL3115A2_CONV_BUSY == mpl.conversionState() ) ) {
+				delay( 1 );
+			}
+			uint32_t p_raw;
+			if ( !mpl.collectPressure( &p_raw ) ) {
+				failures++;
+				continue;
+			}
+			charge( &c, before, t_start );
+			c.samples++;
+			uint64_t ns = sim::now_ns() - t_start;
+			latency_ns += ns;
+			worst_ns = ( ns > worst_ns ) ? ns : worst_ns;
+			double pa = p_raw / 4.0;
+			sum += pa;
+			sum_sq += pa * pa;
+		}
+
+		uint64_t t_block = sim::now_ns();
+		uint32_t p_raw;
+		failures += mpl.getPressure( &p_raw ) ? 0 : 1;
+		double blocking_ms = ( sim::now_ns() - t_block ) / 1e6;
+
+		double n = c.samples ? c.samples : 1;
+		double mean = sum / n;
+		double noise = sqrt( fmax( sum_sq / n - mean * mean, 0.0 ) );
+		double model = SimMPL3115A2::pressure_noise_pa( (uint8_t) ( os << 3 ) );
+		printf( "  OS%-4u %8u %11.2f %12.2f %13.2f %7.1f %9.2f %9.2f\n",
+		        1u << os, table_ms, latency_ns / n / 1e6, blocking_ms,
+		        c.transactions / n, c.bus_ns / n / 1e3, noise, model );
+
+		/* polled once, when due (millis() steps whole ms, so a ms past
+		   the table), and picked up within a loop pass and the bus time */
+		ok = ok && !failures && ( c.transactions == 2 * c.samples );
+		ok = ok && ( worst_ns < ( table_ms + 3 ) * 1000000ULL );
+		ok = ok && ( blocking_ms < table_ms + 3 );
+		ok = ok && ( noise < last_noise ) && ( fabs( noise / model - 1.0 ) < 0.25 );
+		last_noise = noise;
+	}
+	mpl.setOversampling( MPL3115A2_OS128 );
+	return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+/* batch mode */
+
+/**
+ * @brief      Pressure the batch run feeds the sensor at a given time: a
+ *             triangle wave of BENCH_RAMP_PA_PER_S, steep enough that a
+ *             sample stamped a period out reads far off its expected value.
+ */
+static double ramp_pa( uint32_t ms ) {
+	uint32_t phase = ms % ( 2 * BENCH_RAMP_HALF_MS );
+	if ( phase >= BENCH_RAMP_HALF_MS ) {
+		phase = 2 * BENCH_RAMP_HALF_MS - phase;
+	}
+	return BENCH_RAMP_BASE_PA + BENCH_RAMP_PA_PER_S * phase / 1000.0;
+}
+
+/**
+ * @brief      Lets time pass in main loop sized steps, keeping the simulated
+ *             weather on the ramp.
+ */
+static void run_ms( uint32_t ms ) {
+	for ( uint32_t t = 0; t < ms; t += BENCH_POLL_MS ) {
+		delay( BENCH_POLL_MS );
+		sim::env().pressure_pa = ramp_pa( millis() );
+	}
+}
+
+typedef struct BENCH_BATCH {
+	uint32_t samples;
+	uint32_t lost;
+	uint32_t drains;
+	uint32_t bad_time;      /* value does not fit its timestamp */
+	uint32_t bad_step;      /* not one period after the one before */
+	uint32_t last_ms;
+	double worst_pa;
+} BENCH_BATCH_T;
+
+static void drain( BENCH_BATCH_T *b, BENCH_COST_T *c, uint32_t period_ms ) {
+	MPL3115A2_SAMPLE_T s[MPL3115A2_FIFO_DEPTH];
+	uint16_t lost;
+	sim::Stats before = sim::stats();
+	uint64_t t0 = sim::now_ns();
+	uint8_t n = mpl.drainBatch( s, MPL3115A2_FIFO_DEPTH, &lost );
+	charge( c, before, t0 );
+	c->samples += n;
+	b->drains++;
+	b->lost += lost;
+
+	for ( uint8_t i = 0; i < n; i++ ) {
+		double err = s[i].pressure / 4.0 - ramp_pa( s[i].time_ms );
+		err = ( err < 0 ) ? -err : err;
+		b->worst_pa = ( err > b->worst_pa ) ? err : b->worst_pa;
+		if ( err > BENCH_PRESSURE_TOL_PA ) {
+			b->bad_time++;
+		}
+		if ( b->samples && ( s[i].time_ms != b->last_ms + period_ms * ( 1 + ( i ? 0 : lost ) ) ) ) {
+			b->bad_step++;
+		}
+		b->last_ms = s[i].time_ms;
+		b->samples++;
+	}
+}
+
+/**
+ * @brief      Samples once a second into the FIFO and drains it every
+ *             BENCH_DRAIN_MS, then lets it overflow once.  Every sample must
+ *             fit the pressure ramp at its timestamp and the overflow must be
+ *             reported as the samples it cost.
+ */
+static bool bench_batch( const BENCH_COST_T &one_shot ) {
+	BENCH_COST_T batch = { "batch", 0, 0, 0, 0, 0, 0 };
+	BENCH_BATCH_T b = { 0, 0, 0, 0, 0, 0, 0 };
+	bool ok = true;
+
+	sim::env().temp_c = 15.0;
+	sim::env().pressure_pa = ramp_pa( millis() );
+	ok = ok && mpl.startBatch( 0 );
+	ok = ok && !mpl.startConversion();
+	uint32_t period_ms = mpl.samplePeriod_ms();
+	uint32_t start = millis();
+
+	for ( uint32_t i = 0; i < BENCH_BATCH_DRAINS; i++ ) {
+		run_ms( BENCH_DRAIN_MS );
+		drain( &b, &batch, period_ms );
+	}
+	uint32_t lost_before = b.lost;
+	run_ms( BENCH_OVERFLOW_MS );
+	drain( &b, &batch, period_ms );
+	uint32_t overflow_lost = b.lost - lost_before;
+	run_ms( BENCH_DRAIN_MS );
+	drain( &b, &batch, period_ms );
+
+	/* samples due by now: one a period from one conversion time in */
+	uint32_t due = ( millis() - start - BENCH_MPL_CONV_MS ) / period_ms + 1;
+	uint32_t want_lost = BENCH_OVERFLOW_MS / period_ms - MPL3115A2_FIFO_DEPTH;
+	mpl.stopBatch();
+	uint32_t p_raw;
+	ok = ok && mpl.getPressure( &p_raw );
+
+	printf( "bench_mpl: batch mode, 1 s FIFO samples drained every %u s\n",
+	        (unsigned) ( BENCH_DRAIN_MS / 1000 ) );
+	report( one_shot );
+	report( batch );
+	printf( "  batch saves %.1fx transactions, %.1fx bus time per sample\n",
+	        ( (double) one_shot.transactions / one_shot.samples ) /
+	        ( (double) batch.transactions / batch.samples ),
+	        ( (double) one_shot.bus_ns / one_shot.samples ) /
+	        ( (double) batch.bus_ns / batch.samples ) );
+	printf( "  %u samples + %u lost of %u due in %u drains, overflow cost %u (want %u)\n",
+	        b.samples, b.lost, due, b.drains, overflow_lost, want_lost );
+	printf( "  %u off their timestamp, %u off the period, pressure within %.2f Pa\n",
+	        b.bad_time, b.bad_step, b.worst_pa );
+
+	/* the last sample may land either side of the final drain */
+	ok = ok && ( b.samples + b.lost + 1 >= due ) && ( b.samples + b.lost <= due );
+	ok = ok && ( ( overflow_lost == want_lost ) || ( overflow_lost == want_lost + 1 ) );
+	ok = ok && !b.bad_time && !b.bad_step && ( lost_before == 0 );
+	return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+/* event mode */
+
+/**
+ * @brief      A calm day for the event run: pressure and temperature drift
+ *             slowly, then a gust front lifts the pressure 200 Pa in a
+ *             minute and drops the temperature 4 C over five.
+ */
+static double calm_pa( uint32_t ms ) {
+	double s = ms / 1000.0;
+	double p = 101000.0 + 30.0 * s / 3600.0;
+	if ( s > BENCH_FRONT_S ) {
+		double rise = ( s - BENCH_FRONT_S ) / 60.0;
+		p += 200.0 * ( ( rise > 1.0 ) ? 1.0 : rise );
+	}
+	return p;
+}
+
+static double calm_c( uint32_t ms ) {
+	double s = ms / 1000.0;
+	double t = 12.0 + 2.5 * s / 3600.0;
+	if ( s > BENCH_FRONT_S ) {
+		double fall = ( s - BENCH_FRONT_S ) / 300.0;
+		t -= 4.0 * ( ( fall > 1.0 ) ? 1.0 : fall );
+	}
+	return t;
+}
+
+static void run_calm_ms( uint32_t ms ) {
+	for ( uint32_t t = 0; t < ms; t += BENCH_POLL_MS ) {
+		delay( BENCH_POLL_MS );
+		sim::env().pressure_pa = calm_pa( millis() );
+		sim::env().temp_c = calm_c( millis() );
+	}
+}
+
+/**
+ * @brief      Samples once a second in event mode through a calm day and a
+ *             front, polling at the sketch's 5 s report rate.  After every
+ *             poll the last published values must still be within the
+ *             window (plus noise, rounding and a second of drift) of what the
+ *             sensor was measuring, and nothing may be published that had
+ *             not moved a full window.  Set against taking a one-shot
+ *             sample every report.
+ */
+static bool bench_events( const BENCH_COST_T &one_shot ) {
+	BENCH_COST_T events = { "events", 0, 0, 0, 0, 0, 0 };
+	MPL3115A2_SAMPLE_T last = { 0, 0, 0 };
+	uint32_t polls = 0;
+	uint32_t published = 0;
+	uint32_t p_events = 0;
+	uint32_t t_events = 0;
+	uint32_t small = 0;         /* published without moving a window */
+	uint32_t stale = 0;         /* held value too far from the truth */
+	double worst_pa = 0;
+	double worst_c = 0;
+	bool ok = true;
+
+	run_calm_ms( BENCH_POLL_MS );
+	ok = ok && mpl.startEvents( 0, BENCH_EVENT_PA, BENCH_EVENT_C );
+	ok = ok && !mpl.startConversion();
+	uint32_t start = millis();
+
+	while ( ( millis() - start ) < BENCH_EVENT_RUN_MS ) {
+		run_calm_ms( BENCH_REPORT_MS );
+		MPL3115A2_SAMPLE_T s;
+		sim::Stats before = sim::stats();
+		uint64_t t0 = sim::now_ns();
+		uint8_t ev = mpl.pollEvents( &s );
+		charge( &events, before, t0 );
+		polls++;
+		if ( ev ) {
+			published++;
+			if ( polls > 1 ) {
+				bool dp = fabs( ( (double) s.pressure - last.pressure ) / 4.0 ) > BENCH_EVENT_PA;
+				bool dt = abs( s.temp_c100 - last.temp_c100 ) > BENCH_EVENT_C * 100;
+				small += ( ( ev & MPL3115A2_EVENT_PRESSURE ) && !dp ) ? 1 : 0;
+				small += ( ( ev & MPL3115A2_EVENT_TEMPERATURE ) && !dt ) ? 1 : 0;
+			}
+			p_events += ( ev & MPL3115A2_EVENT_PRESSURE ) ? 1 : 0;
+			t_events += ( ev & MPL3115A2_EVENT_TEMPERATURE ) ? 1 : 0;
+			last = s;
+		}
+		else if ( 1 == polls ) {
+			small++;
+		}
+		/* the newest sample the device took */
+		uint32_t newest = millis() - ( millis() - start - BENCH_MPL_CONV_MS ) % 1000;
+		double err_pa = fabs( last.pressure / 4.0 - calm_pa( newest ) );
+		double err_c = fabs( last.temp_c100 / 100.0 - calm_c( newest ) );
+		worst_pa = ( err_pa > worst_pa ) ? err_pa : worst_pa;
+		worst_c = ( err_c > worst_c ) ? err_c : worst_c;
+		if ( ( err_pa > BENCH_EVENT_PA + BENCH_EVENT_PA_SLACK ) ||
+		     ( err_c > BENCH_EVENT_C + BENCH_EVENT_C_SLACK ) ) {
+			stale++;
+		}
+	}
+	mpl.stopEvents();
+	uint32_t p_raw;
+	ok = ok && mpl.getPressure( &p_raw );
+
+	/* one one-shot sample a report, published every time */
+	BENCH_COST_T every = one_shot;
+	every.name = "every 5s";
+	every.transactions = every.transactions * polls / every.samples;
+	every.messages = every.messages * polls / every.samples;
+	every.bytes = every.bytes * polls / every.samples;
+	every.bus_ns = every.bus_ns * polls / every.samples;
+	every.read_ns = every.read_ns * polls / every.samples;
+	every.samples = polls;
+	events.samples = polls;
+
+	printf( "bench_mpl: event mode, %u Pa / %u C windows, %u reports over %u h "
+	        "(a sample is a report)\n",
+	        BENCH_EVENT_PA, BENCH_EVENT_C, polls, (unsigned) ( BENCH_EVENT_RUN_MS / 3600000UL ) );
+	report( every );
+	report( events );
+	printf( "  %u published (%u pressure, %u temperature) of %u reports, "
+	        "%.1fx fewer transactions, %.1fx less bus time\n",
+	        published, p_events, t_events, polls,
+	        (double) every.transactions / ( events.transactions ? events.transactions : 1 ),
+	        (double) every.bus_ns / ( events.bus_ns ? events.bus_ns : 1 ) );
+	printf( "  held values within %.2f Pa and %.2f C of the sensor, %u too far, "
+	        "%u published early\n", worst_pa, worst_c, stale, small );
+
+	ok = ok && !stale && !small && ( published < polls / 4 ) &&
+	     ( events.transactions < every.transactions );
+	return ok;
+}
+
+int main( int argc, char **argv ) {
+	uint32_t samples = 200;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( !strcmp( argv[i], "--samples" ) && has_arg ) {
+			samples = (uint32_t) strtoul( argv[++i], 0, 0 );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--samples N]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	sim::env().temp_c = 21.5;
+	sim::env().humidity_pct = 45.0;
+	sim::env().pressure_pa = 101325.0;
+	sim::attach_i2c( &sim_mpl );
+	bool ok = mpl.init( false );
+
+	BENCH_COST_T burst = { "burst", 0, 0, 0, 0, 0, 0 };
+	ok = bench_one_shot( samples, &burst ) && ok;
+	ok = bench_oversampling() && ok;
+	ok = bench_batch( burst ) && ok;
+	ok = bench_events( burst ) && ok;
+
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
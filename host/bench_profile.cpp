@@ -0,0 +1,203 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_profile.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Checks the profiling layer against the simulated clock.  Known
+ *             durations are timed with PROFILE_SCOPE() in the main line and
+ *             in a pulse ISR; the count, minimum, maximum, mean and every
+ *             histogram bin must come out as the durations put them, the
+ *             dump line must print the same figures and leave the region
+ *             cleared, and the cost of timing a region is reported.  Every
+ *             region but isr_rain is recorded, so the one left out must
+ *             cost nothing and stay out of the dump.  Profile.cpp is built
+ *             in here with that selection.
+ *
+ *             usage: bench_profile [--edges N]
+ */
+
+#define PROFILE_ENABLE 1
+#define PROFILE_REGIONS ( ( PROFILE_BIT( PROFILE_NUM_REGIONS ) - 1 ) & ~PROFILE_BIT( PROF_ISR_RAIN ) )
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "Arduino.h"
+#include "sim.h"
+#include "../Profile.cpp"
+
+#define BENCH_PULSE_PIN             (3)
+
+/* an empty region costs the two micros() calls, and the sim's micros() is
+   truncated to whole us */
+#define BENCH_SCOPE_MAX_US          (4)
+
+/* the ISR body - 20 us */
+#define BENCH_ISR_NS                (20000ULL)
+
+/**
+ * @brief      Collects printed text.
+ */
+class StringPrint : public Print {
+public:
+	size_t write( uint8_t c ) {
+		text += (char) c;
+		return 1;
+	}
+	using Print::write;
+	std::string text;
+};
+
+static void pulseISR( void ) {
+	PROFILE_SCOPE( PROF_ISR_WIND );
+	sim::advance_ns( BENCH_ISR_NS );
+}
+
+static bool check( bool cond, const char *what ) {
+	if ( !cond ) {
+		printf( "  FAIL: %s\n", what );
+	}
+	return cond;
+}
+
+/**
+ * @brief      floor(log2()) clamped to the last bin, for every power of two
+ *             and its neighbours.
+ */
+static bool bins_ok( void ) {
+	bool ok = ( 0 == profile_bin( 0 ) ) && ( 0 == profile_bin( 1 ) );
+	for ( uint8_t k = 1; k < 32; k++ ) {
+		uint32_t p = 1UL << k;
+		uint8_t want = ( k < PROFILE_HIST_BINS - 1 ) ? k : PROFILE_HIST_BINS - 1;
+		uint8_t below = ( k - 1 < PROFILE_HIST_BINS - 1 ) ? k - 1 : PROFILE_HIST_BINS - 1;
+		ok = ok && ( want == profile_bin( p ) ) && ( below == profile_bin( p - 1 ) ) &&
+		     ( want == profile_bin( p + p / 2 ) );
+	}
+	return ok;
+}
+
+int main( int argc, char **argv ) {
+	uint32_t edges = 1000;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( !strcmp( argv[i], "--edges" ) && has_arg ) {
+			edges = (uint32_t) strtoul( argv[++i], 0, 0 );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--edges N]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	bool ok = check( bins_ok(), "profile_bin" );
+	profile_reset();
+
+	/* cost of timing an empty region */
+	uint64_t t0 = sim::now_ns();
+	{
+		PROFILE_SCOPE( PROF_LOOP );
+	}
+	uint64_t cost_ns = sim::now_ns() - t0;
+	PROFILE_STATS_T st;
+	profile_get( PROF_LOOP, &st );
+	ok = check( ( 1 == st.count ) && ( st.max_us <= BENCH_SCOPE_MAX_US ), "empty region" ) && ok;
+
+	/* a region left out reads no clock and records nothing */
+	t0 = sim::now_ns();
+	{
+		PROFILE_SCOPE( PROF_ISR_RAIN );
+	}
+	PROFILE_ADD( PROF_ISR_RAIN, 1 );
+	ok = check( ( sim::now_ns() == t0 ) && !profile_get( PROF_ISR_RAIN, &st ), "region left out" ) &&
+	     ok;
+
+	/* the bins stop at 255 */
+	for ( uint16_t i = 0; i < 300; i++ ) {
+		PROFILE_ADD( PROF_TASK_RAIN, 100 );
+	}
+	profile_get( PROF_TASK_RAIN, &st );
+	ok = check( ( 300 == st.count ) && ( 0xFF == st.hist[profile_bin( 100 )] ), "bin saturation" ) &&
+	     ok;
+
+	/* 1.5 x 2^k us lands mid bin k, whatever the overhead adds */
+	uint32_t want_hist[PROFILE_HIST_BINS] = { 0 };
+	uint32_t n = 0;
+	uint64_t sum_us = 0;
+	for ( uint8_t k = 3; k <= PROFILE_HIST_BINS; k++ ) {
+		uint32_t us = ( 3UL << k ) / 2;
+		{
+			PROFILE_SCOPE( PROF_TASK_WIND );
+			sim::advance_ns( us * 1000ULL );
+		}
+		want_hist[profile_bin( us )]++;
+		sum_us += us;
+		n++;
+	}
+	profile_get( PROF_TASK_WIND, &st );
+	uint32_t lo = ( 3UL << 3 ) / 2, hi = ( 3UL << PROFILE_HIST_BINS ) / 2;
+	ok = check( n == st.count, "count" ) && ok;
+	ok = check( ( st.min_us >= lo ) && ( st.min_us <= lo + BENCH_SCOPE_MAX_US ), "min" ) && ok;
+	ok = check( ( st.max_us >= hi ) && ( st.max_us <= hi + BENCH_SCOPE_MAX_US ), "max" ) && ok;
+	ok = check( ( st.sum_us >= sum_us ) && ( st.sum_us <= sum_us + n * BENCH_SCOPE_MAX_US ),
+	            "sum" ) && ok;
+	bool hist_ok = true;
+	for ( uint8_t i = 0; i < PROFILE_HIST_BINS; i++ ) {
+		hist_ok = hist_ok && ( want_hist[i] == st.hist[i] );
+	}
+	ok = check( hist_ok, "histogram" ) && ok;
+
+	/* the same figures in the dump line, and the region cleared */
+	StringPrint out;
+	profile_dump_start();
+	uint8_t lines = 0;
+	while ( profile_dump_next( &out ) ) {
+		lines++;
+	}
+	char want[160];
+	snprintf( want, sizeof( want ), "P task_wind n=%u min=%u mean=%u max=%u h=", st.count,
+	          st.min_us, st.sum_us / st.count, st.max_us );
+	ok = check( PROFILE_NUM_SLOTS == lines, "dump lines" ) && ok;
+	ok = check( std::string::npos == out.text.find( "P isr_rain" ), "region left out of the dump" ) &&
+	     ok;
+	ok = check( std::string::npos != out.text.find( want ), "dump figures" ) && ok;
+	ok = check( std::string::npos != out.text.find( "P late_wind n=0\r\n" ), "empty region line" ) && ok;
+	ok = check( !profile_dumping(), "dump over" ) && ok;
+	profile_get( PROF_TASK_WIND, &st );
+	ok = check( 0 == st.count, "cleared by the dump" ) && ok;
+
+	/* regions recorded from an ISR */
+	attachInterrupt( digitalPinToInterrupt( BENCH_PULSE_PIN ), pulseISR, FALLING );
+	sim::reset_stats();
+	for ( uint32_t i = 0; i < edges; i++ ) {
+		sim::inject_pulse( BENCH_PULSE_PIN, sim::now_ns() + 1000000ULL * ( i + 1 ) );
+	}
+	sim::advance_ns( 1000000ULL * ( edges + 1 ) );
+	profile_get( PROF_ISR_WIND, &st );
+	uint32_t isr_us = (uint32_t) ( BENCH_ISR_NS / 1000 );
+	ok = check( ( edges == st.count ) && ( sim::stats().irq_serviced == edges ), "isr count" ) && ok;
+	ok = check( ( st.min_us >= isr_us ) && ( st.max_us <= isr_us + BENCH_SCOPE_MAX_US ),
+	            "isr times" ) && ok;
+
+	printf( "bench_profile: %u of %u regions, %u histogram bins, %u bytes of statistics\n",
+	        PROFILE_NUM_SLOTS, PROFILE_NUM_REGIONS, PROFILE_HIST_BINS,
+	        (unsigned) ( PROFILE_NUM_SLOTS * sizeof( PROFILE_STATS_T ) ) );
+	printf( "  timing a region costs %.2f us on the simulated AVR\n", cost_ns / 1e3 );
+	printf( "  %u ISR times of %u us: min %u max %u mean %u us\n", edges, isr_us, st.min_us,
+	        st.max_us, st.count ? st.sum_us / st.count : 0 );
+	printf( "  dump of %u regions, %u bytes:\n", lines, (unsigned) out.text.size() );
+	size_t at = out.text.find( "P task_wind" );
+	if ( std::string::npos != at ) {
+		printf( "  %s\n", out.text.substr( at, out.text.find( '\r', at ) - at ).c_str() );
+	}
+
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,151 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_pulses.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Stress run of the WSA80422 pulse path.  Anemometer edges arrive
+ *             with random spacing averaging 150 mph and rain tips at an
+ *             absurd rate, while a stand-in main loop takes counts at random
+ *             times through the same calls the sketch uses.  Every edge
+ *             delivered must show up in the counts, no interrupt may be lost
+ *             or masked, and the timestamp rings must never overflow.
+ *
+ *             usage: bench_pulses [--seconds N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+#include "../WSA80422.h"
+
+#define BENCH_WSPEED_PIN            (3)
+#define BENCH_RAIN_PIN              (2)
+
+/* anemometer spacing 7-12 ms (124-213 mph, mean 157 mph) */
+#define BENCH_WIND_MIN_NS           (7000000ULL)
+#define BENCH_WIND_SPAN_NS          (5000000ULL)
+/* bucket tips 20-200 ms apart */
+#define BENCH_RAIN_MIN_NS           (20000000ULL)
+#define BENCH_RAIN_SPAN_NS          (180000000ULL)
+
+/* stand-in loop() work between passes, up to 2 ms, with one pass in
+   BENCH_STALL_ODDS stalled as long as a burst of 9600 baud output - about
+   29 wind pulses, close to the 32 slot ring */
+#define BENCH_PASS_MAX_NS           (2000000ULL)
+#define BENCH_STALL_NS              (200000000ULL)
+#define BENCH_STALL_ODDS            (200)
+
+static WSA80422 ws;
+
+void windIRQ( void ) {
+	ws.windIRQ_CB();
+}
+
+void rainIRQ( void ) {
+	ws.rainIRQ_CB();
+}
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t rnd( uint64_t span ) {
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 7;
+	rng_state ^= rng_state << 17;
+	return rng_state % span;
+}
+
+/**
+ * @brief      Queues edges on a pin up to the horizon.
+ *
+ * @return     the number of edges queued.
+ */
+static uint64_t schedule( uint8_t pin, uint64_t *next_ns, uint64_t horizon_ns,
+                          uint64_t min_ns, uint64_t span_ns ) {
+	uint64_t n = 0;
+	while ( *next_ns < horizon_ns ) {
+		sim::inject_pulse( pin, *next_ns );
+		*next_ns += min_ns + rnd( span_ns );
+		n++;
+	}
+	return n;
+}
+
+int main( int argc, char **argv ) {
+	double seconds = 600.0;
+
+	for ( int i = 1; i < argc; i++ ) {
+		if ( !strcmp( argv[i], "--seconds" ) && ( i + 1 < argc ) ) {
+			seconds = atof( argv[++i] );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--seconds N]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	ws.init( BENCH_RAIN_PIN, BENCH_WSPEED_PIN, A0 );
+	sim::reset_stats();
+
+	uint64_t start = sim::now_ns();
+	uint64_t end = start + (uint64_t) ( seconds * 1e9 );
+	uint64_t next_wind = start + BENCH_WIND_MIN_NS;
+	uint64_t next_rain = start + BENCH_RAIN_MIN_NS;
+	uint64_t next_sec = start + 1000000000ULL;
+	uint64_t wind_sent = 0, rain_sent = 0;
+	uint64_t wind_seen = 0, rain_seen = 0;
+
+	while ( sim::now_ns() < end ) {
+		/* keep one second of edges queued ahead of the clock */
+		uint64_t horizon = sim::now_ns() + 1000000000ULL;
+		if ( horizon > end ) {
+			horizon = end;
+		}
+		wind_sent += schedule( BENCH_WSPEED_PIN, &next_wind, horizon,
+		                       BENCH_WIND_MIN_NS, BENCH_WIND_SPAN_NS );
+		rain_sent += schedule( BENCH_RAIN_PIN, &next_rain, horizon,
+		                       BENCH_RAIN_MIN_NS, BENCH_RAIN_SPAN_NS );
+
+		ws.service_pulses();
+		if ( sim::now_ns() >= next_sec ) {
+			next_sec += 1000000000ULL;
+			/* what wind_calcs_per_second() and rain_calcs_per_minute() take */
+			wind_seen += ws.takeWindAcc();
+			rain_seen += ws.takeRainFall() / 11;
+		}
+		if ( 0 == rnd( BENCH_STALL_ODDS ) ) {
+			sim::advance_ns( BENCH_STALL_NS );
+		}
+		else {
+			sim::advance_ns( rnd( BENCH_PASS_MAX_NS ) );
+		}
+	}
+
+	/* let the last edges land, then take what is left */
+	sim::advance_ns( BENCH_RAIN_MIN_NS );
+	ws.service_pulses();
+	wind_seen += ws.takeWindAcc();
+	rain_seen += ws.takeRainFall() / 11;
+
+	const sim::Stats &st = sim::stats();
+	bool ok = ( wind_seen == wind_sent ) && ( rain_seen == rain_sent ) &&
+	          ( 0 == st.irq_lost ) && ( 0 == st.irq_masked_ns ) &&
+	          ( 0 == ws.get_pulse_overflows() );
+
+	printf( "bench_pulses: %.0f s simulated\n", seconds );
+	printf( "  wind edges  %10llu sent %10llu counted\n",
+	        (unsigned long long) wind_sent, (unsigned long long) wind_seen );
+	printf( "  rain edges  %10llu sent %10llu counted\n",
+	        (unsigned long long) rain_sent, (unsigned long long) rain_seen );
+	printf( "  irq lost    %10llu\n", (unsigned long long) st.irq_lost );
+	printf( "  irq masked  %10.3f ms\n", st.irq_masked_ns / 1e6 );
+	printf( "  ring drops  %10u\n", ws.get_pulse_overflows() );
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
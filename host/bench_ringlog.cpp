@@ -0,0 +1,294 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_ringlog.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Runs the EEPROM ring log through days of minute records on a
+ *             file backed EEPROM, resetting the board in the middle of
+ *             writes (and now and then browning it out) and dumping the log
+ *             over the serial framing while a record is being written.
+ *             After every reset the log must resume at the record that was
+ *             cut short, or the one after it if it made it, and everything
+ *             still held must read back exactly as written.  Reports write
+ *             amplification, wear spread and recovery time.
+ *
+ *             usage: bench_ringlog [--days N]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "sim.h"
+#include "telemetry_decoder.h"
+#include "../RingLog.h"
+
+/* one reset in BENCH_RESET_ODDS minutes, one in BENCH_BROWNOUT_ODDS of them
+   a brown-out */
+#define BENCH_RESET_ODDS            (30)
+#define BENCH_BROWNOUT_ODDS         (4)
+#define BENCH_DUMP_ODDS             (50)
+
+#define BENCH_MINUTE_NS             (60000000000ULL)
+#define BENCH_STEP_NS               (500000ULL)
+/* resets land up to this long after an append - a record takes ~58 ms */
+#define BENCH_CUT_STEPS             (140)
+#define BENCH_CELL_RATING           (100000.0)
+
+static RingLog ring;
+static std::vector<std::vector<uint8_t> > truth;
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t rnd( uint32_t span ) {
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 7;
+	rng_state ^= rng_state << 17;
+	return (uint32_t) ( ( rng_state >> 32 ) % span );
+}
+
+static int32_t walk( int32_t v, int32_t step, int32_t lo, int32_t hi ) {
+	v += (int32_t) rnd( 2 * step + 1 ) - step;
+	return ( v < lo ) ? lo : ( ( v > hi ) ? hi : v );
+}
+
+/**
+ * @brief      A minute of slowly changing weather.
+ */
+static RINGLOG_RECORD_T next_weather( void ) {
+	static RINGLOG_RECORD_T w = { 0, 0, 80, 200, 120, WDIR_SW, 0, 1500, 110, 101325 };
+	w.valid = RINGLOG_VALID_HTU | RINGLOG_VALID_BARO | RINGLOG_VALID_VANE;
+	if ( 0 == rnd( 40 ) ) {
+		w.valid &= (uint8_t) ~( 1 << rnd( 3 ) );
+	}
+	w.wind_mph10 = (uint16_t) walk( w.wind_mph10, 15, 0, 600 );
+	w.wind_dir = (uint16_t) ( ( w.wind_dir + 360 + (int32_t) rnd( 41 ) - 20 ) % 360 );
+	w.gust_mph10 = (uint16_t) ( w.wind_mph10 + rnd( 100 ) );
+	w.gust_dir = (WINDDIR_T) rnd( WDIR_NUM_BANDS );
+	w.rain_tips = ( 0 == rnd( 10 ) ) ? (uint8_t) rnd( 20 ) : 0;
+	w.temp_c100 = (int16_t) walk( w.temp_c100, 8, -3000, 4500 );
+	w.humidity_x2 = (uint8_t) walk( w.humidity_x2, 1, 20, 200 );
+	w.pressure_pa = (uint32_t) walk( (int32_t) w.pressure_pa, 3, 95000, 104000 );
+	return w;
+}
+
+static void run_until_idle( void ) {
+	while ( ring.busy() ) {
+		sim::advance_ns( BENCH_STEP_NS );
+		ring.service();
+	}
+}
+
+static bool matches( uint32_t seq, const RINGLOG_RECORD_T &rec ) {
+	uint8_t image[RINGLOG_RECORD_LEN];
+	RingLog::pack( &rec, image );
+	return ( seq < truth.size() ) && ( rec.seq == seq ) &&
+	       !memcmp( image, truth[seq].data(), RINGLOG_RECORD_LEN );
+}
+
+/**
+ * @brief      Everything from first up to the newest record must be held
+ *             and intact.
+ */
+static bool check_held( uint32_t first ) {
+	RINGLOG_RECORD_T rec;
+	for ( uint32_t s = first; s < ring.nextSeq(); s++ ) {
+		if ( !ring.read( s, &rec ) || !matches( s, rec ) ) {
+			printf( "  record %lu lost or damaged\n", (unsigned long) s );
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief      Dumps from since on through the wire framing and checks the
+ *             records arrive in order, complete and intact.
+ */
+static bool check_dump( uint32_t since ) {
+	TelemetryDecoder dec;
+	uint8_t image[RINGLOG_RECORD_LEN];
+	uint8_t frame[RINGLOG_FRAME_LEN];
+	uint32_t expect = ( since > ring.oldestSeq() ) ? since : ring.oldestSeq();
+	bool ok = true;
+
+	ring.startDump( since );
+	while ( ring.dumping() ) {
+		if ( ring.dumpNext( image ) ) {
+			size_t n = RingLog::frame( image, frame );
+			dec.feed( frame, n, []( const TELEMETRY_RECORD_T & ) {},
+			          [&]( const RINGLOG_RECORD_T &rec ) {
+				ok = ok && ( rec.seq == expect ) && matches( expect, rec );
+				expect++;
+			} );
+		}
+		else {
+			sim::advance_ns( BENCH_STEP_NS );
+		}
+		ring.service();
+	}
+	ok = ok && ( expect == ring.nextSeq() ) && ( 0 == dec.stats().bad_frames ) &&
+	     ( 0 == dec.stats().crc_errors );
+	if ( !ok ) {
+		printf( "  dump since %lu broken at %lu\n", (unsigned long) since,
+		        (unsigned long) expect );
+	}
+	return ok;
+}
+
+int main( int argc, char **argv ) {
+	double days = 7.0;
+
+	for ( int i = 1; i < argc; i++ ) {
+		if ( !strcmp( argv[i], "--days" ) && ( i + 1 < argc ) ) {
+			days = atof( argv[++i] );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--days N]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	char path[] = "/tmp/bench_ringlog_XXXXXX";
+	int fd = mkstemp( path );
+	if ( ( fd < 0 ) || !sim::eeprom_attach_file( path ) ) {
+		fprintf( stderr, "cannot create %s\n", path );
+		return 1;
+	}
+	close( fd );
+
+	uint16_t area = EEPROM.length();
+	ring.begin( 0, area );
+	sim::reset_stats();
+
+	uint64_t minutes = (uint64_t) ( days * 24 * 60 );
+	uint64_t appended = 0, resets = 0, brownouts = 0, torn = 0, dumps = 0;
+	uint64_t recover_ns = 0, recover_max_ns = 0, recover_reads = 0, recover_wait_ns = 0;
+	uint64_t durable_ns = 0, durable_max_ns = 0;
+	bool ok = true;
+
+	for ( uint64_t m = 0; ok && ( m < minutes ); m++ ) {
+		uint64_t minute_start = sim::now_ns();
+		RINGLOG_RECORD_T rec = next_weather();
+		uint32_t seq = ring.nextSeq();
+		if ( !ring.append( &rec ) || ( rec.seq != seq ) ) {
+			printf( "  append %lu refused\n", (unsigned long) seq );
+			ok = false;
+			break;
+		}
+		std::vector<uint8_t> image( RINGLOG_RECORD_LEN );
+		RingLog::pack( &rec, image.data() );
+		truth.resize( seq + 1 );
+		truth[seq] = image;
+		appended++;
+
+		if ( 0 == rnd( BENCH_RESET_ODDS ) ) {
+			/* stop somewhere in the write sequence and start over */
+			uint32_t steps = rnd( BENCH_CUT_STEPS );
+			for ( uint32_t i = 0; i < steps; i++ ) {
+				sim::advance_ns( BENCH_STEP_NS );
+				ring.service();
+			}
+			if ( 0 == rnd( BENCH_BROWNOUT_ODDS ) ) {
+				sim::eeprom_brownout( (uint8_t) rnd( 256 ) );
+				brownouts++;
+			}
+			resets++;
+
+			uint64_t reads = sim::stats().eeprom_reads;
+			uint64_t waited = sim::stats().eeprom_wait_ns;
+			uint64_t t0 = sim::now_ns();
+			ring = RingLog();
+			ring.begin( 0, area );
+			uint64_t t = sim::now_ns() - t0;
+			recover_ns += t;
+			recover_max_ns = ( t > recover_max_ns ) ? t : recover_max_ns;
+			recover_reads += sim::stats().eeprom_reads - reads;
+			/* after a reset begin() waits out the byte still programming */
+			recover_wait_ns += sim::stats().eeprom_wait_ns - waited;
+
+			uint32_t next = ring.nextSeq();
+			if ( next == seq ) {
+				/* cut short - the oldest record went with it */
+				torn++;
+				truth.pop_back();
+				ok = check_held( ring.oldestSeq() + 1 );
+			}
+			else if ( next == seq + 1 ) {
+				ok = check_held( ring.oldestSeq() );
+			}
+			else {
+				printf( "  resumed at %lu after writing %lu\n", (unsigned long) next,
+				        (unsigned long) seq );
+				ok = false;
+			}
+		}
+		else if ( 0 == rnd( BENCH_DUMP_ODDS ) ) {
+			/* while the new record is still going in */
+			uint32_t since = ring.oldestSeq() + rnd( ring.capacity() + 4 );
+			ok = check_dump( since > 4 ? since - 4 : 0 );
+			dumps++;
+		}
+		run_until_idle();
+		uint64_t t = sim::now_ns() - minute_start;
+		durable_ns += t;
+		durable_max_ns = ( t > durable_max_ns ) ? t : durable_max_ns;
+		sim::advance_ns( BENCH_MINUTE_NS - t );
+	}
+
+	/* power off: everything must come back from the file */
+	if ( ok ) {
+		uint32_t next = ring.nextSeq();
+		sim::eeprom_attach_file( path );
+		ring = RingLog();
+		ring.begin( 0, area );
+		if ( ring.nextSeq() != next ) {
+			printf( "  reload resumed at %lu, expected %lu\n",
+			        (unsigned long) ring.nextSeq(), (unsigned long) next );
+			ok = false;
+		}
+		ok = ok && check_held( ring.oldestSeq() ) && check_dump( 0 );
+	}
+	unlink( path );
+
+	const sim::Stats &st = sim::stats();
+	uint32_t wear_max = 0;
+	uint64_t wear_sum = 0;
+	for ( uint16_t a = 0; a < area; a++ ) {
+		uint32_t w = sim::eeprom_wear( a );
+		wear_sum += w;
+		wear_max = ( w > wear_max ) ? w : wear_max;
+	}
+	double wear_per_day = wear_max / days;
+	/* nothing but recovery may wait on the EEPROM */
+	uint64_t wait_ns = st.eeprom_wait_ns - recover_wait_ns;
+	ok = ok && ( 0 == wait_ns );
+
+	printf( "bench_ringlog: %.1f days, %u slots\n", days, ring.capacity() );
+	printf( "  records      %10llu appended, %llu resets (%llu brown-outs), %llu cut short, "
+	        "%llu dumps\n",
+	        (unsigned long long) appended, (unsigned long long) resets,
+	        (unsigned long long) brownouts, (unsigned long long) torn,
+	        (unsigned long long) dumps );
+	printf( "  programmed   %10llu bytes, %.2f per record byte\n",
+	        (unsigned long long) st.eeprom_writes,
+	        (double) st.eeprom_writes / ( appended * RINGLOG_RECORD_LEN ) );
+	printf( "  wear         %10u max, %.1f mean per cell - %.1f years to %.0f cycles\n",
+	        wear_max, (double) wear_sum / area,
+	        wear_per_day ? BENCH_CELL_RATING / wear_per_day / 365.0 : 0.0, BENCH_CELL_RATING );
+	printf( "  durable      %10.1f ms mean, %.1f ms max after append\n",
+	        durable_ns / 1e6 / appended, durable_max_ns / 1e6 );
+	printf( "  recovery     %10.3f ms mean, %.3f ms max, %llu reads\n",
+	        resets ? recover_ns / 1e6 / resets : 0.0, recover_max_ns / 1e6,
+	        resets ? (unsigned long long) ( recover_reads / resets ) : 0ULL );
+	printf( "  eeprom waits %10.3f ms outside recovery\n", wait_ns / 1e6 );
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
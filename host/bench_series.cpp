@@ -0,0 +1,290 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_series.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Files days of 1 Hz station reports into a StationHistory -
+ *             wind at 1 Hz, rain, temperature, humidity and pressure once a
+ *             minute, all quantised the way the drivers quantise them -
+ *             closing and reopening it half way.  Reports bytes per sample
+ *             for each column, ingest and scan rates and the cost of range
+ *             summaries, and checks every sample reads back exactly and
+ *             every summary matches a full scan.
+ *
+ *             usage: bench_series [--days N] [--dir DIR]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "station_history.h"
+
+#define BENCH_T0_MS                 (1791936000000LL)  /* 2026-10-14 00:00 UTC */
+#define BENCH_DAY_S                 (86400)
+#define BENCH_QUERIES               (1000)
+
+typedef struct BENCH_EXPECT {
+	std::vector<int64_t> t;
+	std::vector<float> v;
+} BENCH_EXPECT_T;
+
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t rnd( void ) {
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+	return (uint32_t) ( rng >> 32 );
+}
+
+static double rnd_unit( void ) {
+	return rnd() / 4294967296.0;
+}
+
+static uint64_t mono_ns( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * @brief      The next second of weather, as the board would report it.
+ */
+static void next_second( uint32_t s, TELEMETRY_RECORD_T *r ) {
+	static double wind_mean = 4.0;
+	static int vane = 4;
+	static uint32_t gust_pls = 0;
+	static double temp_walk = 0;
+	static double rh_walk = 0;
+	static uint32_t rain_left = 0;
+
+	/* anemometer pulses counted over the second */
+	wind_mean += ( rnd_unit() - 0.5 ) * 0.4;
+	wind_mean = ( wind_mean < 0 ) ? 0 : ( wind_mean > 20 ) ? 20 : wind_mean;
+	int pls = (int) lround( wind_mean + ( rnd_unit() - 0.5 ) * wind_mean );
+	pls = ( pls < 0 ) ? 0 : pls;
+	if ( 0 == rnd() % 10 ) {
+		vane = ( vane + ( ( rnd() & 1 ) ? 1 : 15 ) ) % 16;
+	}
+	if ( 0 == s % 120 ) {
+		gust_pls = 0;
+	}
+	gust_pls = ( (uint32_t) pls > gust_pls ) ? (uint32_t) pls : gust_pls;
+	r->wind_spd = (uint32_t) pls * 1492;
+	r->wind_dir = (uint16_t) lround( vane * 22.5 ) % 360;
+	r->gust_spd = gust_pls * 1492;
+	r->gust_dir = r->wind_dir;
+
+	if ( 0 == s % 60 ) {
+		/* the rest changes once a minute */
+		double day = ( s % BENCH_DAY_S ) / (double) BENCH_DAY_S;
+		temp_walk += ( rnd_unit() - 0.5 ) * 0.1;
+		rh_walk += ( rnd_unit() - 0.5 ) * 0.4;
+		double temp = 12.0 + 6.0 * sin( 2 * M_PI * ( day - 0.3 ) ) + temp_walk;
+		/* HTU21D: 14 bit reading, bottom two status bits cleared */
+		uint16_t raw = (uint16_t) ( ( temp + 46.85 ) * 65536 / 175.72 ) & ~0x03;
+		r->temp_htu_c100 = (int16_t) lround( ( ( 175.72 * raw ) / 65536 - 46.85 ) * 100 );
+		double rh = 60.0 - 20.0 * sin( 2 * M_PI * ( day - 0.3 ) ) + rh_walk;
+		rh = ( rh < 5 ) ? 5 : ( rh > 100 ) ? 100 : rh;
+		uint16_t hraw = (uint16_t) ( ( rh + 6 ) * 65536 / 125 ) & ~0x0F;
+		r->humidity_c100 = (uint16_t) lround( ( ( 125.0 * hraw ) / 65536 - 6 ) * 100 );
+		r->pressure_pa4 += (uint32_t) ( (int) ( rnd() % 9 ) - 4 );
+		if ( !rain_left && ( 0 == rnd() % 2000 ) ) {
+			rain_left = 30 + rnd() % 240;
+		}
+		r->rain_1m = rain_left ? ( rnd() % 6 ) * 11 : 0;
+		rain_left -= rain_left ? 1 : 0;
+	}
+	r->seq++;
+	r->time_ms += 1000;
+}
+
+/**
+ * @brief      What StationHistory::add() should have stored, column by
+ *             column.
+ */
+static void expect( BENCH_EXPECT_T *e, int64_t t, const TELEMETRY_RECORD_T &r ) {
+	e[HIST_WIND_MPH].t.push_back( t );
+	e[HIST_WIND_MPH].v.push_back( (float) ( r.wind_spd / 1000.0 ) );
+	e[HIST_WIND_DIR].t.push_back( t );
+	e[HIST_WIND_DIR].v.push_back( r.wind_dir );
+	e[HIST_GUST_MPH].t.push_back( t );
+	e[HIST_GUST_MPH].v.push_back( (float) ( r.gust_spd / 1000.0 ) );
+	if ( 0 == ( t - BENCH_T0_MS ) % HIST_MINUTE_MS ) {
+		e[HIST_RAIN_IN].t.push_back( t );
+		e[HIST_RAIN_IN].v.push_back( (float) ( r.rain_1m / 1000.0 ) );
+		e[HIST_TEMP_C].t.push_back( t );
+		e[HIST_TEMP_C].v.push_back( r.temp_htu_c100 / 100.0f );
+		e[HIST_HUMIDITY].t.push_back( t );
+		e[HIST_HUMIDITY].v.push_back( r.humidity_c100 / 100.0f );
+		e[HIST_PRESSURE_PA].t.push_back( t );
+		e[HIST_PRESSURE_PA].v.push_back( r.pressure_pa4 / 4.0f );
+	}
+}
+
+int main( int argc, char **argv ) {
+	double days = 30;
+	std::string dir;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( !strcmp( argv[i], "--days" ) && has_arg ) {
+			days = atof( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--dir" ) && has_arg ) {
+			dir = argv[++i];
+		}
+		else {
+			fprintf( stderr, "usage: %s [--days N] [--dir DIR]\n", argv[0] );
+			return 2;
+		}
+	}
+	bool keep = !dir.empty();
+	if ( !keep ) {
+		char tmpl[] = "/tmp/bench_series.XXXXXX";
+		if ( !mkdtemp( tmpl ) ) {
+			perror( "mkdtemp" );
+			return 1;
+		}
+		dir = tmpl;
+	}
+	uint32_t seconds = (uint32_t) ( days * BENCH_DAY_S );
+	bool ok = true;
+
+	/* ingest, reopening half way */
+	static BENCH_EXPECT_T e[HIST_COLUMNS];
+	TELEMETRY_RECORD_T r;
+	memset( &r, 0, sizeof( r ) );
+	r.valid = TELEM_VALID_HTU | TELEM_VALID_MPL_T | TELEM_VALID_MPL_P;
+	r.pressure_pa4 = 405300;
+
+	StationHistory hist;
+	if ( !hist.open( dir, true ) ) {
+		perror( dir.c_str() );
+		return 1;
+	}
+	uint64_t ingest_ns = 0;
+	uint64_t samples = 0;
+	for ( uint32_t s = 0; s < seconds; s++ ) {
+		next_second( s, &r );
+		int64_t t = BENCH_T0_MS + (int64_t) s * 1000;
+		expect( e, t, r );
+		uint64_t t0 = mono_ns();
+		if ( s == seconds / 2 ) {
+			hist.close();
+			if ( !hist.open( dir, true ) ) {
+				printf( "  reopen failed\n" );
+				return 1;
+			}
+		}
+		if ( !hist.add( t, r ) ) {
+			printf( "  record at %u s refused\n", s );
+			ok = false;
+		}
+		ingest_ns += mono_ns() - t0;
+	}
+	uint64_t t0 = mono_ns();
+	hist.close();
+	ingest_ns += mono_ns() - t0;
+
+	if ( !hist.open( dir, false ) ) {
+		perror( dir.c_str() );
+		return 1;
+	}
+	printf( "bench_series: %.1f days, %u reports, %s\n", days, seconds, dir.c_str() );
+
+	/* read back and check */
+	uint64_t bytes = 0;
+	uint64_t scan_ns = 0;
+	for ( int c = 0; c < HIST_COLUMNS; c++ ) {
+		SeriesFile &col = hist.column( (HIST_COLUMN_T) c );
+		const BENCH_EXPECT_T &x = e[c];
+		size_t i = 0;
+		bool same = ( col.samples() == x.t.size() );
+		t0 = mono_ns();
+		uint64_t n = col.scan( INT64_MIN, INT64_MAX, [&]( int64_t t, double v ) {
+			if ( ( i >= x.t.size() ) || ( t != x.t[i] ) || ( v != (double) x.v[i] ) ) {
+				same = false;
+			}
+			i++;
+		} );
+		scan_ns += mono_ns() - t0;
+		same = same && ( n == x.t.size() );
+		samples += n;
+		bytes += col.file_bytes();
+		printf( "  %-12s %9llu samples %9llu bytes  %5.2f bytes/sample (%4.1fx)%s\n",
+		        StationHistory::column_name( (HIST_COLUMN_T) c ), (unsigned long long) n,
+		        (unsigned long long) col.file_bytes(),
+		        n ? (double) col.file_bytes() / n : 0.0,
+		        col.file_bytes() ? 16.0 * n / col.file_bytes() : 0.0,
+		        same ? "" : "  MISMATCH" );
+		ok = ok && same;
+	}
+	printf( "  total        %9llu samples %9llu bytes  %5.2f bytes/sample (16 raw)\n",
+	        (unsigned long long) samples, (unsigned long long) bytes,
+	        samples ? (double) bytes / samples : 0.0 );
+	printf( "  ingest       %9.2f M samples/s\n", samples * 1e3 / ingest_ns );
+	printf( "  scan         %9.2f M samples/s\n", samples * 1e3 / scan_ns );
+
+	/* range summaries against a scan of the same range */
+	SeriesFile &wind = hist.column( HIST_WIND_MPH );
+	int64_t span = (int64_t) seconds * 1000;
+	uint64_t sum_ns = 0;
+	uint64_t brute_ns = 0;
+	uint64_t from_hdr = 0;
+	uint64_t decoded = 0;
+	for ( int q = 0; q < BENCH_QUERIES; q++ ) {
+		int64_t a = BENCH_T0_MS + (int64_t) ( rnd_unit() * span );
+		int64_t b = a + (int64_t) ( rnd_unit() * BENCH_DAY_S * 1000 );
+		SERIES_SUMMARY_T s;
+		t0 = mono_ns();
+		wind.summary( a, b, &s );
+		sum_ns += mono_ns() - t0;
+		from_hdr += s.blocks_read;
+		decoded += s.blocks_decoded;
+
+		uint64_t count = 0;
+		double mn = 0;
+		double mx = 0;
+		double sum = 0;
+		t0 = mono_ns();
+		wind.scan( a, b, [&]( int64_t, double v ) {
+			mn = ( !count || ( v < mn ) ) ? v : mn;
+			mx = ( !count || ( v > mx ) ) ? v : mx;
+			sum += v;
+			count++;
+		} );
+		brute_ns += mono_ns() - t0;
+		if ( ( s.count != count ) || ( count && ( ( s.min != mn ) || ( s.max != mx ) ||
+		     ( fabs( s.sum - sum ) > 1e-9 * fabs( sum ) + 1e-9 ) ) ) ) {
+			printf( "  summary %lld..%lld: %llu / %g / %g / %g, scan %llu / %g / %g / %g\n",
+			        (long long) a, (long long) b, (unsigned long long) s.count, s.min, s.max,
+			        s.sum, (unsigned long long) count, mn, mx, sum );
+			ok = false;
+		}
+	}
+	printf( "  summary      %9.1f us per query (scan %.1f us), %.1f blocks from headers, "
+	        "%.1f decoded\n", sum_ns / 1e3 / BENCH_QUERIES, brute_ns / 1e3 / BENCH_QUERIES,
+	        (double) from_hdr / BENCH_QUERIES, (double) decoded / BENCH_QUERIES );
+	hist.close();
+
+	if ( !keep ) {
+		for ( int c = 0; c < HIST_COLUMNS; c++ ) {
+			std::string f = dir + "/" + StationHistory::column_name( (HIST_COLUMN_T) c ) + ".ser";
+			unlink( f.c_str() );
+		}
+		rmdir( dir.c_str() );
+	}
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
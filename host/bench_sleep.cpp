@@ -0,0 +1,174 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_sleep.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      The WSA80422 pulse path with the core asleep between events.
+ *             A stand-in main loop drains the pulse rings, takes the wind
+ *             count every second and the rain every minute from the
+ *             scheduler, and sleeps with PowerSave until the next tick -
+ *             at calm, breezy and storm wind speeds with the rain gauge
+ *             tipping.  Every edge must be counted, no interrupt lost and
+ *             no ring overflow, while the core stays asleep most of the
+ *             time, and the awake share the firmware counts must be within
+ *             10% of the simulator's.
+ *
+ *             usage: bench_sleep [--seconds N]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+#include "../WSA80422.h"
+#include "../Scheduler.h"
+#include "../PowerSave.h"
+
+#define BENCH_WSPEED_PIN            (3)
+#define BENCH_RAIN_PIN              (2)
+
+/* stand-in loop() work once awake */
+#define BENCH_PASS_NS               (150000ULL)
+
+/* the awake share the firmware counts must be within this much of the
+   simulator's, relative */
+#define BENCH_AWAKE_TOL             (0.10)
+
+typedef struct BENCH_CASE {
+	double wind_mph;
+	double rain_in_hr;
+	double max_awake_pct;
+} BENCH_CASE_T;
+
+static WSA80422 ws;
+static Scheduler sched;
+static PowerSave power;
+static uint64_t wind_seen, rain_seen;
+
+void windIRQ( void ) {
+	ws.windIRQ_CB();
+	power.wake();
+}
+
+void rainIRQ( void ) {
+	ws.rainIRQ_CB();
+	power.wake();
+}
+
+static uint64_t rng_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t rnd( uint64_t span ) {
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 7;
+	rng_state ^= rng_state << 17;
+	return rng_state % span;
+}
+
+/**
+ * @brief      Queues edges on a pin from now to end, spaced 0.8 to 1.2
+ *             times the mean period for the rate.
+ *
+ * @return     the number of edges queued.
+ */
+static uint64_t schedule( uint8_t pin, double hz, uint64_t end_ns ) {
+	uint64_t n = 0;
+	if ( hz <= 0.0 ) {
+		return 0;
+	}
+	uint64_t period = (uint64_t) ( 1e9 / hz );
+	for ( uint64_t at = sim::now_ns() + period; at < end_ns;
+	      at += period * 4 / 5 + rnd( period * 2 / 5 ) ) {
+		sim::inject_pulse( pin, at );
+		n++;
+	}
+	return n;
+}
+
+static void wind_task( void ) {
+	wind_seen += ws.takeWindAcc();
+}
+
+static void rain_task( void ) {
+	rain_seen += ws.takeRainFall() / 11;
+}
+
+int main( int argc, char **argv ) {
+	double seconds = 300.0;
+
+	for ( int i = 1; i < argc; i++ ) {
+		if ( !strcmp( argv[i], "--seconds" ) && ( i + 1 < argc ) ) {
+			seconds = atof( argv[++i] );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--seconds N]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	static const BENCH_CASE_T cases[] = {
+		{ 0.0, 0.0, 1.0 },
+		{ 5.0, 0.2, 1.5 },
+		{ 30.0, 2.0, 2.0 },
+		{ 150.0, 20.0, 5.0 }
+	};
+
+	ws.init( BENCH_RAIN_PIN, BENCH_WSPEED_PIN, A0 );
+	sched.addTask( wind_task, 1000, 0 );
+	sched.addTask( rain_task, 60000, 1 );
+	sched.start();
+
+	bool ok = true;
+	printf( "bench_sleep: %.0f s per case, idle between ticks and pulses\n", seconds );
+	printf( "  %6s %6s %9s %9s %9s %9s %5s %8s %8s\n", "mph", "in/hr", "wind sent",
+	        "counted", "rain sent", "counted", "lost", "awake", "counted" );
+	for ( const BENCH_CASE_T &c : cases ) {
+		sim::reset_stats();
+		power.resetStats();
+		wind_seen = rain_seen = 0;
+
+		uint64_t start = sim::now_ns();
+		uint64_t end = start + (uint64_t) ( seconds * 1e9 );
+		/* 1.492 mph per anemometer closure per second, 0.011" per bucket tip */
+		uint64_t wind_sent = schedule( BENCH_WSPEED_PIN, c.wind_mph / 1.492, end );
+		uint64_t rain_sent = schedule( BENCH_RAIN_PIN, c.rain_in_hr / 0.011 / 3600.0, end );
+		while ( sim::now_ns() < end ) {
+			ws.service_pulses();
+			sched.run();
+			sim::advance_ns( BENCH_PASS_NS );
+			power.sleepUntil( sched.usUntilNext() );
+		}
+		/* take what is left */
+		uint64_t run_ns = sim::now_ns() - start;
+		ws.service_pulses();
+		wind_seen += ws.takeWindAcc();
+		rain_seen += ws.takeRainFall() / 11;
+
+		const sim::Stats &st = sim::stats();
+		double awake = 100.0 * ( 1.0 - (double) st.sleep_ns / run_ns );
+		/* from the ms totals - awakePermille() is rounded to 0.1 % */
+		POWER_STATS_T ps;
+		power.getStats( &ps );
+		double counted = 100.0 * ( 1.0 - (double) ps.asleep_ms / ps.elapsed_ms );
+		bool good = ( wind_seen == wind_sent ) && ( rain_seen == rain_sent ) &&
+		            ( 0 == st.irq_lost ) && ( 0 == ws.get_pulse_overflows() ) &&
+		            ( awake <= c.max_awake_pct ) &&
+		            ( fabs( counted - awake ) <= BENCH_AWAKE_TOL * awake );
+		printf( "  %6.1f %6.1f %9llu %9llu %9llu %9llu %5llu %7.2f%% %7.2f%%%s\n",
+		        c.wind_mph, c.rain_in_hr, (unsigned long long) wind_sent,
+		        (unsigned long long) wind_seen, (unsigned long long) rain_sent,
+		        (unsigned long long) rain_seen, (unsigned long long) st.irq_lost, awake,
+		        counted, good ? "" : "  <- FAIL" );
+		ok = ok && good;
+	}
+	printf( "  ring drops %u\n", ws.get_pulse_overflows() );
+
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
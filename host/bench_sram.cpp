@@ -0,0 +1,59 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_sram.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Checks the sketch's globals against the SRAM budget in
+ *             SramBudget.h.  The firmware headers are read packed, as
+ *             avr-gcc lays structs out, so every fixed width member is the
+ *             size it is on the board.  Pointers stay 8 bytes, so the
+ *             total is an upper bound.  Nothing is constructed, so the
+ *             packed layouts never meet code built without them.  The
+ *             PROFILE_ENABLE build, with its default regions, must fit as
+ *             well.
+ */
+
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "EEPROM.h"
+
+#pragma pack(push, 1)
+#include "../SramBudget.h"
+#pragma pack(pop)
+
+#define BENCH_ROW( type )   printf( "  %-18s %5u\n", #type, (unsigned) sizeof( type ) )
+
+int main( void ) {
+	printf( "sketch globals, bytes (host pointers, packed)\n" );
+	BENCH_ROW( DRV_HTU21D );
+	BENCH_ROW( MPL3115A2 );
+	BENCH_ROW( WSA80422 );
+	BENCH_ROW( Acquisition );
+	BENCH_ROW( StationPipeline );
+	BENCH_ROW( STATION_MEAN_T );
+	BENCH_ROW( Scheduler );
+	BENCH_ROW( RingLog );
+	BENCH_ROW( PowerSave );
+	printf( "  %-18s %5u\n", "scalars", (unsigned) SRAM_SKETCH_SCALARS );
+
+	unsigned total = (unsigned) SRAM_GLOBALS_BYTES;
+	unsigned prof_total = total - PROFILE_RAM_BYTES + PROFILE_LINKED_RAM_BYTES;
+	bool ok = ( total <= SRAM_GLOBALS_BUDGET );
+	bool prof_ok = ( prof_total <= SRAM_GLOBALS_BUDGET );
+	printf( "  total %u of %u (%u SRAM less %u core, %u stack)%s\n", total,
+	        (unsigned) SRAM_GLOBALS_BUDGET, (unsigned) SRAM_TOTAL_BYTES,
+	        (unsigned) SRAM_CORE_BYTES, (unsigned) SRAM_STACK_BYTES, ok ? "" : "  <- FAIL" );
+	printf( "  with PROFILE_ENABLE, %u regions: %u%s\n", (unsigned) PROFILE_NUM_SLOTS, prof_total,
+	        prof_ok ? "" : "  <- FAIL" );
+	ok = ok && prof_ok;
+
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
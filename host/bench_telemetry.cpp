@@ -0,0 +1,146 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_telemetry.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Round trip and throughput check of the telemetry framing.
+ *             Random records are framed with the firmware encoder into one
+ *             stream, with text and corrupted frames mixed in.  The decoder
+ *             must return every intact record unchanged and flag every
+ *             damaged one, whatever size pieces the stream is fed in.  The
+ *             stream is then decoded repeatedly to time it.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include "telemetry_decoder.h"
+
+#define BENCH_RECORDS               (200000)
+/* one frame in BENCH_CORRUPT_ODDS gets a flipped bit */
+#define BENCH_CORRUPT_ODDS          (97)
+#define BENCH_TIMED_PASSES          (20)
+
+static uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t rnd( void ) {
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 7;
+	rng_state ^= rng_state << 17;
+	return (uint32_t) ( rng_state >> 32 );
+}
+
+static void random_record( TELEMETRY_RECORD_T *r, uint16_t seq ) {
+	memset( r, 0, sizeof( *r ) );
+	r->seq = seq;
+	r->time_ms = rnd();
+	r->valid = rnd() & 7;
+	r->wind_x = (int16_t) rnd();
+	r->wind_y = (int16_t) rnd();
+	r->wind_dir = rnd() % 360;
+	r->wind_spd = rnd();
+	r->wind_spd_2m = rnd();
+	r->wind_dir_2m = rnd() % 360;
+	r->gust_spd = rnd();
+	r->gust_dir = rnd() % 360;
+	r->gust_10m_spd = rnd();
+	r->gust_10m_dir = rnd() % 360;
+	r->rain_1m = (uint16_t) rnd();
+	r->rain_1hr = (uint16_t) rnd();
+	/* plenty of zero bytes to exercise the stuffing */
+	r->rain_day = ( rnd() & 1 ) ? 0 : (uint16_t) rnd();
+	r->temp_htu_c100 = (int16_t) rnd();
+	r->humidity_c100 = (uint16_t) rnd();
+	r->temp_mpl_c100 = (int16_t) rnd();
+	r->pressure_pa4 = rnd() & 0xFFFFF;
+	r->light_mv = (uint16_t) ( rnd() & 0x0F00 );
+}
+
+static bool same( const TELEMETRY_RECORD_T &a, const TELEMETRY_RECORD_T &b ) {
+	uint8_t pa[TELEMETRY_PAYLOAD_LEN], pb[TELEMETRY_PAYLOAD_LEN];
+	telemetry_pack( &a, pa );
+	telemetry_pack( &b, pb );
+	return 0 == memcmp( pa, pb, sizeof( pa ) );
+}
+
+int main( void ) {
+	std::vector<TELEMETRY_RECORD_T> sent;
+	std::vector<uint8_t> stream;
+	size_t damaged = 0;
+	const char *noise = "\r\nMPL3115A2 init'd!\r\n";
+
+	stream.insert( stream.end(), noise, noise + strlen( noise ) );
+	for ( uint32_t i = 0; i < BENCH_RECORDS; i++ ) {
+		TELEMETRY_RECORD_T r;
+		uint8_t frame[TELEMETRY_FRAME_LEN];
+		random_record( &r, (uint16_t) i );
+		size_t n = telemetry_frame( &r, frame );
+		if ( 0 == rnd() % BENCH_CORRUPT_ODDS ) {
+			/* flip one bit inside the frame, keeping the delimiters */
+			frame[1 + rnd() % ( n - 2 )] ^= (uint8_t) ( 1u << ( rnd() & 7 ) );
+			damaged++;
+		}
+		else {
+			sent.push_back( r );
+		}
+		stream.insert( stream.end(), frame, frame + n );
+	}
+
+	/* correctness, fed in awkward piece sizes */
+	static const size_t piece[] = { 1, 7, 53, 54, 4096, 1 << 20 };
+	bool ok = true;
+	for ( size_t p = 0; p < sizeof( piece ) / sizeof( piece[0] ); p++ ) {
+		TelemetryDecoder dec;
+		size_t got = 0;
+		bool match = true;
+		for ( size_t off = 0; off < stream.size(); off += piece[p] ) {
+			size_t n = std::min( piece[p], stream.size() - off );
+			dec.feed( &stream[off], n, [&]( const TELEMETRY_RECORD_T &r ) {
+				if ( ( got >= sent.size() ) || !same( r, sent[got] ) ) {
+					match = false;
+				}
+				got++;
+			} );
+		}
+		const TelemetryDecoder::Stats &st = dec.stats();
+		/* a flipped bit may turn into a bad frame, a CRC error or, when it
+		   creates or removes a zero, split one frame into two bad ones */
+		bool pass = match && ( got == sent.size() ) &&
+		            ( st.bad_frames + st.crc_errors >= damaged + 1 );
+		printf( "  piece %7zu: %zu/%zu records, %llu bad, %llu CRC errors - %s\n",
+		        piece[p], got, sent.size(), (unsigned long long) st.bad_frames,
+		        (unsigned long long) st.crc_errors, pass ? "ok" : "MISMATCH" );
+		ok = ok && pass;
+	}
+
+	/* throughput */
+	TelemetryDecoder dec;
+	uint64_t sink = 0;
+	auto t0 = std::chrono::steady_clock::now();
+	for ( int pass = 0; pass < BENCH_TIMED_PASSES; pass++ ) {
+		for ( size_t off = 0; off < stream.size(); off += 4096 ) {
+			size_t n = std::min( (size_t) 4096, stream.size() - off );
+			dec.feed( &stream[off], n, [&]( const TELEMETRY_RECORD_T &r ) {
+				sink += r.seq;
+			} );
+		}
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	double s = std::chrono::duration<double>( t1 - t0 ).count();
+	double frames = (double) dec.stats().frames;
+
+	printf( "bench_telemetry: %d records, %zu byte frames (%zu byte payload)\n",
+	        BENCH_RECORDS, (size_t) TELEMETRY_FRAME_LEN, (size_t) TELEMETRY_PAYLOAD_LEN );
+	printf( "  decode: %.2f M frames/s, %.0f MB/s (sink %llu)\n",
+	        frames / s / 1e6, stream.size() * (double) BENCH_TIMED_PASSES / s / 1e6,
+	        (unsigned long long) sink );
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,187 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_units.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Checks the fixed point conversions in units.h over every input
+ *             they can be given against the exact value, computed with 64 bit
+ *             integers and rounded half away from zero - no mismatch is
+ *             allowed.  Also runs the float code each one replaced, in single
+ *             precision as on the AVR (where double is float), and reports
+ *             how often and how far that strayed from the exact answer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+
+#include "../units.h"
+
+/* the pressure register holds 20 bits of Pa x 4 */
+#define BENCH_PA4_LIMIT             (1UL << 20)
+#define BENCH_ADC_LIMIT             (1024)
+
+typedef struct BENCH_TALLY {
+	const char *name;
+	uint64_t inputs;
+	uint64_t wrong;         /* kernel != exact */
+	uint64_t float_off;     /* old float code != exact */
+	int64_t float_worst;
+} BENCH_TALLY_T;
+
+/**
+ * @brief      num / den rounded half away from zero, den > 0.
+ */
+static int64_t exact( int64_t num, int64_t den ) {
+	return ( num < 0 ) ? -( ( -2 * num + den ) / ( 2 * den ) ) : ( 2 * num + den ) / ( 2 * den );
+}
+
+static void tally( BENCH_TALLY_T *t, int64_t kernel, int64_t want, int64_t legacy ) {
+	t->inputs++;
+	if ( kernel != want ) {
+		if ( t->wrong < 3 ) {
+			printf( "  %s: got %lld, exact %lld\n", t->name, (long long) kernel, (long long) want );
+		}
+		t->wrong++;
+	}
+	if ( legacy != want ) {
+		t->float_off++;
+		int64_t d = llabs( legacy - want );
+		if ( d > t->float_worst ) {
+			t->float_worst = d;
+		}
+	}
+}
+
+/*----------------------------------------------------------------------------*/
+/* the float code each kernel replaced */
+
+static int16_t legacy_to_c100( float v ) {
+	return (int16_t) ( v * 100.0f + ( ( v < 0 ) ? -0.5f : 0.5f ) );
+}
+
+static float legacy_htu_temp_c( uint16_t raw ) {
+	float tempC_f;
+	raw &= ~( 0x03 );
+	tempC_f = (float) raw;
+	return ( ( 175.72f * tempC_f ) / 65536 ) - 46.85f;
+}
+
+static float legacy_htu_humidity( uint16_t raw ) {
+	float hum_f;
+	raw &= ~( 0x03 );
+	hum_f = (float) raw;
+	return ( ( 125.0f * hum_f ) / 65536 ) - 6;
+}
+
+static float legacy_mpl_temp_c( uint16_t raw ) {
+	int16_t t_q4 = (int16_t) raw;
+	t_q4 >>= 4;
+	return t_q4 / 16.0f;
+}
+
+static float legacy_inhg( uint32_t pa4 ) {
+	float f_press = pa4;
+	f_press /= 4.0f;
+	return f_press / 3386.38f;
+}
+
+static float legacy_light_v( uint16_t light, uint16_t ref ) {
+	float operatingVoltage = ref;
+	float lightSensor = light;
+	operatingVoltage = 3.3f / operatingVoltage;
+	return operatingVoltage * lightSensor;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void report( const BENCH_TALLY_T &t ) {
+	printf( "  %-14s %9llu inputs %3llu wrong   old float code off on %7llu (%5.2f%%), "
+	        "by up to %lld\n",
+	        t.name, (unsigned long long) t.inputs, (unsigned long long) t.wrong,
+	        (unsigned long long) t.float_off, 100.0 * t.float_off / t.inputs,
+	        (long long) t.float_worst );
+}
+
+template<typename Fn>
+static double ns_per_call( Fn fn, uint32_t n ) {
+	volatile int64_t sink = 0;
+	auto t0 = std::chrono::steady_clock::now();
+	for ( uint32_t i = 0; i < n; i++ ) {
+		sink = sink + fn( i );
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / n;
+}
+
+int main( void ) {
+	bool ok = true;
+
+	BENCH_TALLY_T temp = { "htu temp c100", 0, 0, 0, 0 };
+	BENCH_TALLY_T rh = { "htu rh c100", 0, 0, 0, 0 };
+	BENCH_TALLY_T mpl = { "mpl temp c100", 0, 0, 0, 0 };
+	for ( uint32_t raw = 0; raw < 0x10000; raw++ ) {
+		int64_t masked = raw & ~0x03u;
+		tally( &temp, units_htu_temp_c100( (uint16_t) raw ),
+		       exact( 17572 * masked - 4685 * 65536LL, 65536 ),
+		       legacy_to_c100( legacy_htu_temp_c( (uint16_t) raw ) ) );
+		tally( &rh, units_htu_humidity_c100( (uint16_t) raw ),
+		       exact( 12500 * masked - 600 * 65536LL, 65536 ),
+		       legacy_to_c100( legacy_htu_humidity( (uint16_t) raw ) ) );
+		tally( &mpl, units_mpl_temp_c100( (uint16_t) raw ),
+		       exact( ( (int16_t) raw >> 4 ) * 25LL, 4 ),
+		       legacy_to_c100( legacy_mpl_temp_c( (uint16_t) raw ) ) );
+	}
+
+	BENCH_TALLY_T inhg = { "inHg x 1000", 0, 0, 0, 0 };
+	for ( uint32_t pa4 = 0; pa4 < BENCH_PA4_LIMIT; pa4++ ) {
+		/* the old float used 3386.38 Pa, the exact one 3386.389 */
+		tally( &inhg, units_pa4_to_inhg1000( pa4 ), exact( pa4 * 250000LL, 3386389 ),
+		       (int64_t) ( legacy_inhg( pa4 ) * 1000.0f + 0.5f ) );
+	}
+
+	BENCH_TALLY_T f100 = { "c100 -> f100", 0, 0, 0, 0 };
+	for ( int32_t c100 = INT16_MIN; c100 <= INT16_MAX; c100++ ) {
+		float c = c100 / 100.0f;
+		float f = ( c * 9.0f / 5.0f ) + 32;
+		tally( &f100, units_c100_to_f100( (int16_t) c100 ), exact( 9LL * c100 + 16000, 5 ),
+		       (int64_t) ( f * 100.0f + ( ( f < 0 ) ? -0.5f : 0.5f ) ) );
+	}
+
+	BENCH_TALLY_T light = { "light mV", 0, 0, 0, 0 };
+	for ( uint16_t ref = 1; ref < BENCH_ADC_LIMIT; ref++ ) {
+		for ( uint16_t l = 0; l < BENCH_ADC_LIMIT; l++ ) {
+			int64_t want = exact( 3300LL * l, ref );
+			want = ( want > 0xFFFF ) ? 0xFFFF : want;
+			int64_t old = (int64_t) ( legacy_light_v( l, ref ) * 1000.0f + 0.5f );
+			tally( &light, units_light_mv( l, ref ), want, ( old > 0xFFFF ) ? 0xFFFF : old );
+		}
+	}
+	ok = ok && ( 0xFFFF == units_light_mv( 512, 0 ) );
+
+	printf( "bench_units: every input, exact rounding\n" );
+	const BENCH_TALLY_T *all[] = { &temp, &rh, &mpl, &inhg, &f100, &light };
+	for ( const BENCH_TALLY_T *t : all ) {
+		report( *t );
+		ok = ok && !t->wrong;
+	}
+
+	/* the host has an FPU, so this flatters the float code - on the AVR each
+	   float multiply or divide is a soft-float library call */
+	const uint32_t n = 1u << 22;
+	printf( "  host ns/call  htu temp %.2f (float %.2f), inHg %.2f (float %.2f)\n",
+	        ns_per_call( []( uint32_t i ) { return units_htu_temp_c100( (uint16_t) i ); }, n ),
+	        ns_per_call( []( uint32_t i ) {
+	        	return legacy_to_c100( legacy_htu_temp_c( (uint16_t) i ) ); }, n ),
+	        ns_per_call( []( uint32_t i ) { return units_pa4_to_inhg1000( i & 0xFFFFF ); }, n ),
+	        ns_per_call( []( uint32_t i ) {
+	        	return (int32_t) ( legacy_inhg( i & 0xFFFFF ) * 1000.0f + 0.5f ); }, n ) );
+
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
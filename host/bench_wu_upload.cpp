@@ -0,0 +1,192 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file bench_wu_upload.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Checks and times the Wunderground query encoder, then runs the
+ *             uploader against the local stand-in server with failed answers,
+ *             dropped connections, chunked answers and answers ended by the
+ *             connection closing injected.  Every update must arrive exactly
+ *             once and in order.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "http_standin.h"
+#include "wu_uploader.h"
+#include "../Wunderground.h"
+
+#define BENCH_ENCODE_RECORDS        (1000000)
+#define BENCH_UPLOADS               (400)
+
+static const WU_STATION_T station = { "KCASANFR5", "p&ss w", "vws versionxx" };
+
+static uint64_t rng_state = 0xD1B54A32D192ED03ULL;
+
+static uint32_t rnd( void ) {
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 7;
+	rng_state ^= rng_state << 17;
+	return (uint32_t) ( rng_state >> 32 );
+}
+
+static uint64_t now_ms( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static TELEMETRY_RECORD_T sample_record( void ) {
+	TELEMETRY_RECORD_T r;
+	memset( &r, 0, sizeof( r ) );
+	r.valid = TELEM_VALID_HTU | TELEM_VALID_MPL_T | TELEM_VALID_MPL_P;
+	r.wind_dir = 225;
+	r.wind_spd = 12345;
+	r.gust_spd = 20050;
+	r.gust_dir = 203;
+	r.wind_spd_2m = 9949;
+	r.wind_dir_2m = 219;
+	r.gust_10m_spd = 29840;
+	r.gust_10m_dir = 248;
+	r.rain_1hr = 33;
+	r.rain_day = 0;
+	r.temp_htu_c100 = -555;
+	r.humidity_c100 = 4567;
+	r.pressure_pa4 = 405300;
+	return r;
+}
+
+static bool check( const char *what, const TELEMETRY_RECORD_T &r, const char *expect ) {
+	char q[WU_QUERY_MAX];
+	size_t n = wu_build_query( q, sizeof( q ), &station, "2000-01-01 10:32:35", &r );
+	bool ok = ( n == strlen( expect ) ) && !strcmp( q, expect );
+	printf( "  %-22s %s\n", what, ok ? "ok" : "MISMATCH" );
+	if ( !ok ) {
+		printf( "    got    %s\n    expect %s\n", q, expect );
+	}
+	return ok;
+}
+
+static bool check_encoder( void ) {
+	bool ok = true;
+	TELEMETRY_RECORD_T r = sample_record();
+
+	ok &= check( "full record", r,
+		"ID=KCASANFR5&PASSWORD=p%26ss%20w&dateutc=2000-01-01%2010%3A32%3A35"
+		"&winddir=225&windspeedmph=12.3&windgustmph=20.1&windgustdir=203"
+		"&windspdmph_avg2m=9.9&winddir_avg2m=219&windgustmph_10m=29.8&windgustdir_10m=248"
+		"&rainin=0.033&dailyrainin=0.000&tempf=22.0&humidity=45.7&baromin=29.921"
+		"&softwaretype=vws%20versionxx&action=updateraw" );
+
+	r.temp_htu_c100 = -2005;
+	r.humidity_c100 = 5;
+	r.valid = TELEM_VALID_HTU;
+	ok &= check( "below 0 F, no baro", r,
+		"ID=KCASANFR5&PASSWORD=p%26ss%20w&dateutc=2000-01-01%2010%3A32%3A35"
+		"&winddir=225&windspeedmph=12.3&windgustmph=20.1&windgustdir=203"
+		"&windspdmph_avg2m=9.9&winddir_avg2m=219&windgustmph_10m=29.8&windgustdir_10m=248"
+		"&rainin=0.033&dailyrainin=0.000&tempf=-4.1&humidity=0.1"
+		"&softwaretype=vws%20versionxx&action=updateraw" );
+
+	char small[64];
+	bool fits = ( 0 != wu_build_query( small, sizeof( small ), &station, "now", &r ) );
+	printf( "  %-22s %s\n", "short buffer refused", ( !fits && !small[0] ) ? "ok" : "MISMATCH" );
+	return ok && !fits && !small[0];
+}
+
+static void time_encoder( void ) {
+	std::vector<TELEMETRY_RECORD_T> recs( 1024 );
+	for ( auto &r : recs ) {
+		r = sample_record();
+		r.wind_spd = rnd() % 200000;
+		r.temp_htu_c100 = (int16_t) ( rnd() % 9000 ) - 4000;
+		r.pressure_pa4 = 360000 + rnd() % 80000;
+	}
+	char q[WU_QUERY_MAX];
+	size_t total = 0;
+	auto t0 = std::chrono::steady_clock::now();
+	for ( int i = 0; i < BENCH_ENCODE_RECORDS; i++ ) {
+		total += wu_build_query( q, sizeof( q ), &station, "now", &recs[i & 1023] );
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	double s = std::chrono::duration<double>( t1 - t0 ).count();
+	printf( "  encode: %.2f M queries/s, %.0f bytes each\n",
+	        BENCH_ENCODE_RECORDS / s / 1e6, (double) total / BENCH_ENCODE_RECORDS );
+}
+
+static bool run_upload( void ) {
+	HttpStandin server;
+	HttpStandin::Faults faults;
+	faults.fail_every = 7;
+	faults.drop_every = 11;
+	faults.chunk_every = 5;
+	faults.close_every = 13;
+	uint16_t port = server.start( 0, faults );
+	if ( !port ) {
+		printf( "  stand-in server failed to start\n" );
+		return false;
+	}
+
+	WuUploader::Config cfg;
+	cfg.port = port;
+	cfg.batch_max = 8;
+	cfg.flush_ms = 0;
+	cfg.timeout_ms = 1000;
+	cfg.backoff_min_ms = 1;
+	cfg.backoff_max_ms = 8;
+	WuUploader up( cfg );
+
+	std::vector<std::string> sent;
+	TELEMETRY_RECORD_T r = sample_record();
+	for ( int i = 0; i < BENCH_UPLOADS; i++ ) {
+		char dateutc[24];
+		char q[WU_QUERY_MAX];
+		snprintf( dateutc, sizeof( dateutc ), "2026-10-16 %02d:%02d:%02d",
+		          i / 3600, ( i / 60 ) % 60, i % 60 );
+		r.wind_spd = rnd() % 50000;
+		wu_build_query( q, sizeof( q ), &station, dateutc, &r );
+		sent.push_back( q );
+		up.enqueue( q, now_ms() );
+	}
+
+	uint64_t start = now_ms();
+	while ( up.pending() && ( now_ms() - start < 20000 ) ) {
+		up.service( now_ms() );
+		if ( up.pending() && ( now_ms() < up.next_attempt_ms() ) ) {
+			usleep( 1000 );
+		}
+	}
+	uint64_t took = now_ms() - start;
+	server.stop();
+
+	std::vector<std::string> got = server.accepted();
+	const WuUploader::Stats &st = up.stats();
+	bool ok = ( got == sent ) && ( st.sent == sent.size() ) && !st.rejected && !st.dropped;
+	printf( "  upload: %zu/%zu accepted in order, %llu requests on %llu connections, "
+	        "%llu batches, %llu failed, %llu ms - %s\n",
+	        got.size(), sent.size(), (unsigned long long) server.requests(),
+	        (unsigned long long) server.connections(), (unsigned long long) st.batches,
+	        (unsigned long long) st.failures, (unsigned long long) took,
+	        ok ? "ok" : "MISMATCH" );
+	return ok;
+}
+
+int main( void ) {
+	printf( "bench_wu_upload:\n" );
+	bool ok = check_encoder();
+	time_encoder();
+	ok = run_upload() && ok;
+	printf( "%s\n", ok ? "PASS" : "FAIL" );
+	return ok ? 0 : 1;
+}
+
+/** @} end of addtogroup */
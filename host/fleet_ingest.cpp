@@ -0,0 +1,184 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file fleet_ingest.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Collector daemon for a fleet of stations - reads every serial
+ *             port (or PTY) named on the command line until they all hang up
+ *             or it is interrupted, then prints one CSV line per station.
+ *
+ *             usage: fleet_ingest [--workers N] [--stats-s S] DEVICE...
+ *
+ *             fleet_ingest --workers 4 --stats-s 10 /dev/ttyUSB* > fleet.csv
+ *             fleet_loadgen --stations 200 --seconds 60 > ports &
+ *             sleep 1; fleet_ingest --workers 4 $(cat ports) > fleet.csv
+ */
+
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "ingest_server.h"
+
+static volatile sig_atomic_t quit = 0;
+
+static void on_signal( int ) {
+	quit = 1;
+}
+
+static uint64_t now_ms( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void usage( const char *prog ) {
+	fprintf( stderr, "usage: %s [--workers N] [--stats-s S] DEVICE...\n", prog );
+}
+
+static int open_port( const char *path ) {
+	int fd = open( path, O_RDONLY | O_NOCTTY | O_NONBLOCK );
+	if ( fd < 0 ) {
+		return -1;
+	}
+	struct termios t;
+	if ( 0 == tcgetattr( fd, &t ) ) {
+		cfmakeraw( &t );
+		cfsetispeed( &t, B115200 );
+		tcsetattr( fd, TCSANOW, &t );
+	}
+	return fd;
+}
+
+static void print_table( IngestServer &srv, double elapsed_s ) {
+	IngestServer::StationView v;
+	uint64_t records = 0;
+	uint64_t missed = 0;
+	uint64_t crc = 0;
+	uint64_t lag_max = 0;
+	uint64_t hist[INGEST_LAG_BUCKETS] = { 0 };
+	unsigned open = 0;
+
+	for ( size_t i = 0; i < srv.stations(); i++ ) {
+		srv.snapshot( i, &v );
+		records += v.agg.records + v.agg.log_records;
+		missed += v.agg.missed;
+		crc += v.link.crc_errors;
+		open += v.open ? 1 : 0;
+		if ( v.lag_max_ns > lag_max ) {
+			lag_max = v.lag_max_ns;
+		}
+		for ( unsigned b = 0; b < INGEST_LAG_BUCKETS; b++ ) {
+			hist[b] += v.lag_hist[b];
+		}
+	}
+	fprintf( stderr, "fleet_ingest: %.0f s, %u/%zu open, %llu records (%.0f/s), %llu missed, "
+	                 "%llu CRC errors, lag p50 %llu us p99 %llu us max %llu us\n",
+	         elapsed_s, open, srv.stations(), (unsigned long long) records,
+	         elapsed_s > 0 ? records / elapsed_s : 0.0, (unsigned long long) missed,
+	         (unsigned long long) crc,
+	         (unsigned long long) IngestServer::lag_percentile_us( hist, 50 ),
+	         (unsigned long long) IngestServer::lag_percentile_us( hist, 99 ),
+	         (unsigned long long) ( lag_max / 1000 ) );
+}
+
+static void print_csv( IngestServer &srv ) {
+	IngestServer::StationView v;
+
+	printf( "station,records,missed,restarts,log_records,crc_errors,bad_frames,"
+	        "wind_mean_mph,gust_max_mph,gust_dir,temp_min_c,temp_max_c,"
+	        "pressure_min_pa,pressure_max_pa,lag_mean_us,lag_p99_us,lag_max_us,"
+	        "pauses,paused_ms\n" );
+	for ( size_t i = 0; i < srv.stations(); i++ ) {
+		srv.snapshot( i, &v );
+		const StationAggregate &a = v.agg;
+		printf( "%s,%llu,%llu,%llu,%llu,%llu,%llu,%.3f,%.3f,%u,",
+		        v.name.c_str(), (unsigned long long) a.records, (unsigned long long) a.missed,
+		        (unsigned long long) a.restarts, (unsigned long long) a.log_records,
+		        (unsigned long long) v.link.crc_errors, (unsigned long long) v.link.bad_frames,
+		        a.wind_mean() / 1000.0, a.gust_max / 1000.0, a.gust_max_dir );
+		printf( "%.2f,%.2f,%.2f,%.2f,%llu,%llu,%llu,%llu,%llu\n",
+		        a.temp_min_c100 / 100.0, a.temp_max_c100 / 100.0,
+		        a.pressure_min_pa4 / 4.0, a.pressure_max_pa4 / 4.0,
+		        (unsigned long long) ( v.lag_count ? v.lag_sum_ns / v.lag_count / 1000 : 0 ),
+		        (unsigned long long) IngestServer::lag_percentile_us( v.lag_hist, 99 ),
+		        (unsigned long long) ( v.lag_max_ns / 1000 ),
+		        (unsigned long long) v.pauses, (unsigned long long) ( v.paused_ns / 1000000 ) );
+	}
+}
+
+int main( int argc, char **argv ) {
+	IngestServer::Config cfg;
+	double stats_s = 0;
+	std::vector<const char *> ports;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( !strcmp( argv[i], "--workers" ) && has_arg ) {
+			cfg.workers = (unsigned) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--stats-s" ) && has_arg ) {
+			stats_s = atof( argv[++i] );
+		}
+		else if ( '-' == argv[i][0] ) {
+			usage( argv[0] );
+			return 2;
+		}
+		else {
+			ports.push_back( argv[i] );
+		}
+	}
+	if ( ports.empty() ) {
+		usage( argv[0] );
+		return 2;
+	}
+
+	struct rlimit rl;
+	if ( ( 0 == getrlimit( RLIMIT_NOFILE, &rl ) ) && ( rl.rlim_cur < rl.rlim_max ) ) {
+		rl.rlim_cur = rl.rlim_max;
+		setrlimit( RLIMIT_NOFILE, &rl );
+	}
+
+	IngestServer srv( cfg );
+	for ( const char *p : ports ) {
+		int fd = open_port( p );
+		if ( fd < 0 ) {
+			perror( p );
+			return 1;
+		}
+		srv.add_stream( fd, p );
+	}
+
+	signal( SIGINT, on_signal );
+	signal( SIGTERM, on_signal );
+	if ( !srv.start() ) {
+		perror( "fleet_ingest" );
+		return 1;
+	}
+
+	uint64_t start = now_ms();
+	uint64_t next_stats = start + (uint64_t) ( stats_s * 1000 );
+	while ( !quit && !srv.finished() ) {
+		usleep( 100000 );
+		if ( ( stats_s > 0 ) && ( now_ms() >= next_stats ) ) {
+			print_table( srv, ( now_ms() - start ) / 1000.0 );
+			next_stats += (uint64_t) ( stats_s * 1000 );
+		}
+	}
+	srv.stop();
+
+	print_csv( srv );
+	print_table( srv, ( now_ms() - start ) / 1000.0 );
+	return 0;
+}
+
+/** @} end of addtogroup */
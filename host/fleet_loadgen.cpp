@@ -0,0 +1,135 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file fleet_loadgen.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Load generator for fleet_ingest - opens one PTY per simulated
+ *             station, prints their paths on stdout and sends telemetry
+ *             through them at the board's report rate (or flat out).
+ *
+ *             usage: fleet_loadgen [--stations N] [--writers N] [--rate HZ]
+ *                                  [--flood] [--records N] [--seconds S]
+ *                                  [--linger-s S]
+ *
+ *             It stops after --records frames per station or --seconds,
+ *             whichever comes first, waits up to --linger-s for the collector
+ *             to read what is left and then hangs up every PTY.
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pty_fleet.h"
+
+static volatile sig_atomic_t quit = 0;
+
+static void on_signal( int ) {
+	quit = 1;
+}
+
+static uint64_t now_ms( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void usage( const char *prog ) {
+	fprintf( stderr, "usage: %s [--stations N] [--writers N] [--rate HZ] [--flood] "
+	                 "[--records N] [--seconds S] [--linger-s S]\n", prog );
+}
+
+int main( int argc, char **argv ) {
+	PtyFleet::Config cfg;
+	unsigned stations = 10;
+	double seconds = 0;
+	double linger_s = 10.0;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( !strcmp( argv[i], "--stations" ) && has_arg ) {
+			stations = (unsigned) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--writers" ) && has_arg ) {
+			cfg.writers = (unsigned) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--rate" ) && has_arg ) {
+			cfg.rate_hz = atof( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--flood" ) ) {
+			cfg.flood = true;
+		}
+		else if ( !strcmp( argv[i], "--records" ) && has_arg ) {
+			cfg.records = strtoull( argv[++i], 0, 0 );
+		}
+		else if ( !strcmp( argv[i], "--seconds" ) && has_arg ) {
+			seconds = atof( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--linger-s" ) && has_arg ) {
+			linger_s = atof( argv[++i] );
+		}
+		else {
+			usage( argv[0] );
+			return 2;
+		}
+	}
+	if ( !stations || ( cfg.rate_hz <= 0 ) ) {
+		usage( argv[0] );
+		return 2;
+	}
+
+	PtyFleet fleet;
+	if ( !fleet.open( stations ) ) {
+		perror( "fleet_loadgen" );
+		return 1;
+	}
+	for ( unsigned i = 0; i < fleet.size(); i++ ) {
+		printf( "%s\n", fleet.path( i ).c_str() );
+	}
+	fflush( stdout );
+
+	signal( SIGINT, on_signal );
+	signal( SIGTERM, on_signal );
+	uint64_t start = now_ms();
+	fleet.start( cfg );
+
+	/* the writers return by themselves once --records are sent */
+	uint64_t last = fleet.frames();
+	uint64_t idle_ms = 0;
+	while ( !quit ) {
+		usleep( 100000 );
+		if ( ( seconds > 0 ) && ( now_ms() - start >= seconds * 1000 ) ) {
+			break;
+		}
+		uint64_t f = fleet.frames();
+		idle_ms = ( f == last ) ? idle_ms + 100 : 0;
+		last = f;
+		if ( cfg.records && fleet.drained() && ( idle_ms >= 500 ) ) {
+			break;
+		}
+	}
+	fleet.stop();
+	double elapsed_s = ( now_ms() - start ) / 1000.0;
+
+	uint64_t linger_end = now_ms() + (uint64_t) ( linger_s * 1000 );
+	while ( !quit && !fleet.drained() && ( now_ms() < linger_end ) ) {
+		usleep( 50000 );
+	}
+	bool drained = fleet.drained();
+	fleet.hang_up();
+
+	fprintf( stderr, "fleet_loadgen: %u stations, %llu frames in %.1f s (%.0f/s), "
+	                 "writers stalled %.1f ms%s\n",
+	         fleet.size(), (unsigned long long) fleet.frames(), elapsed_s,
+	         elapsed_s > 0 ? fleet.frames() / elapsed_s : 0.0, fleet.stall_ns() / 1e6,
+	         drained ? "" : ", collector did not read everything" );
+	return drained ? 0 : 1;
+}
+
+/** @} end of addtogroup */
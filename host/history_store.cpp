@@ -0,0 +1,149 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file history_store.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Files a station's telemetry stream (stdin) into its history
+ *             directory, or reads a column back out.
+ *
+ *             usage: history_store DIR < stream
+ *                    history_store --summary COLUMN [--from MS] [--to MS] DIR
+ *                    history_store --csv COLUMN [--from MS] [--to MS] DIR
+ *
+ *             Records are stamped with Unix time in ms: the wall clock when
+ *             the first one arrives, then the board's own time_ms from
+ *             there, so a piped simulation keeps its 5 s spacing.  A board
+ *             reset (time_ms going back) starts again from the wall clock,
+ *             or just after the newest sample held if that is later.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "station_history.h"
+#include "telemetry_decoder.h"
+
+static int64_t wall_ms( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_REALTIME, &ts );
+	return (int64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void usage( const char *prog ) {
+	fprintf( stderr, "usage: %s DIR < stream\n"
+	                 "       %s --summary|--csv COLUMN [--from MS] [--to MS] DIR\n",
+	         prog, prog );
+}
+
+static int file_stream( const char *dir ) {
+	StationHistory hist;
+	if ( !hist.open( dir, true ) ) {
+		perror( dir );
+		return 1;
+	}
+	TelemetryDecoder dec;
+	uint8_t buf[4096];
+	ssize_t n;
+	int64_t epoch = 0;
+	uint32_t last_ms = 0;
+	bool started = false;
+	uint64_t filed = 0;
+	uint64_t refused = 0;
+
+	while ( ( n = read( 0, buf, sizeof( buf ) ) ) > 0 ) {
+		dec.feed( buf, (size_t) n, [&]( const TELEMETRY_RECORD_T &r ) {
+			if ( !started || ( r.time_ms < last_ms ) ) {
+				SeriesFile &wind = hist.column( HIST_WIND_MPH );
+				int64_t at = wall_ms();
+				if ( wind.samples() && ( at <= wind.last_time() ) ) {
+					at = wind.last_time() + 1000;
+				}
+				epoch = at - r.time_ms;
+				started = true;
+			}
+			last_ms = r.time_ms;
+			if ( hist.add( epoch + r.time_ms, r ) ) {
+				filed++;
+			}
+			else {
+				refused++;
+			}
+		} );
+	}
+	hist.close();
+	fprintf( stderr, "history_store: %llu records filed, %llu refused\n",
+	         (unsigned long long) filed, (unsigned long long) refused );
+	return 0;
+}
+
+int main( int argc, char **argv ) {
+	const char *column = 0;
+	bool csv = false;
+	int64_t from = INT64_MIN;
+	int64_t to = INT64_MAX;
+	const char *dir = 0;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( ( !strcmp( argv[i], "--summary" ) || !strcmp( argv[i], "--csv" ) ) && has_arg ) {
+			csv = !strcmp( argv[i], "--csv" );
+			column = argv[++i];
+		}
+		else if ( !strcmp( argv[i], "--from" ) && has_arg ) {
+			from = strtoll( argv[++i], 0, 0 );
+		}
+		else if ( !strcmp( argv[i], "--to" ) && has_arg ) {
+			to = strtoll( argv[++i], 0, 0 );
+		}
+		else if ( ( '-' != argv[i][0] ) && !dir ) {
+			dir = argv[i];
+		}
+		else {
+			usage( argv[0] );
+			return 2;
+		}
+	}
+	if ( !dir ) {
+		usage( argv[0] );
+		return 2;
+	}
+	if ( !column ) {
+		return file_stream( dir );
+	}
+
+	HIST_COLUMN_T c;
+	if ( !StationHistory::column_by_name( column, &c ) ) {
+		fprintf( stderr, "unknown column %s\n", column );
+		return 2;
+	}
+	StationHistory hist;
+	if ( !hist.open( dir, false ) ) {
+		perror( dir );
+		return 1;
+	}
+	SeriesFile &s = hist.column( c );
+	if ( csv ) {
+		printf( "time_ms,%s\n", column );
+		s.scan( from, to, []( int64_t t, double v ) {
+			printf( "%lld,%.9g\n", (long long) t, v );
+		} );
+	}
+	else {
+		SERIES_SUMMARY_T sum;
+		s.summary( from, to, &sum );
+		printf( "%s: %llu samples, min %.9g, max %.9g, mean %.9g "
+		        "(%u blocks from headers, %u decoded), %.2f bytes per sample\n",
+		        column, (unsigned long long) sum.count, sum.min, sum.max,
+		        sum.count ? sum.sum / sum.count : 0.0, sum.blocks_read, sum.blocks_decoded,
+		        s.samples() ? (double) s.file_bytes() / s.samples() : 0.0 );
+	}
+	return 0;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,197 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file http_standin.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "http_standin.h"
+
+HttpStandin::HttpStandin() : listen_fd( -1 ), running( false ), num_requests( 0 ),
+	num_connections( 0 ) {
+}
+
+HttpStandin::~HttpStandin() {
+	stop();
+}
+
+/**
+ * @brief      Listens on 127.0.0.1 and starts serving.
+ *
+ * @param[in]  port    0 picks a free port.
+ *
+ * @return     the port in use, 0 on failure.
+ */
+uint16_t HttpStandin::start( uint16_t port, const Faults &f ) {
+	struct sockaddr_in addr;
+	socklen_t len = sizeof( addr );
+	int one = 1;
+
+	faults = f;
+	listen_fd = socket( AF_INET, SOCK_STREAM, 0 );
+	if ( listen_fd < 0 ) {
+		return 0;
+	}
+	setsockopt( listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof( one ) );
+	memset( &addr, 0, sizeof( addr ) );
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+	addr.sin_port = htons( port );
+	if ( bind( listen_fd, (struct sockaddr *) &addr, sizeof( addr ) ) ||
+	     listen( listen_fd, 8 ) ||
+	     getsockname( listen_fd, (struct sockaddr *) &addr, &len ) ) {
+		close( listen_fd );
+		listen_fd = -1;
+		return 0;
+	}
+	running = true;
+	worker = std::thread( &HttpStandin::serve, this );
+	return ntohs( addr.sin_port );
+}
+
+void HttpStandin::stop( void ) {
+	if ( running ) {
+		running = false;
+		worker.join();
+	}
+	if ( listen_fd >= 0 ) {
+		close( listen_fd );
+		listen_fd = -1;
+	}
+}
+
+std::vector<std::string> HttpStandin::accepted( void ) {
+	std::lock_guard<std::mutex> g( lock );
+	return updates;
+}
+
+/* connections are served one at a time - the uploader only opens one */
+void HttpStandin::serve( void ) {
+	while ( running ) {
+		struct pollfd p = { listen_fd, POLLIN, 0 };
+		if ( poll( &p, 1, 50 ) <= 0 ) {
+			continue;
+		}
+		int conn = accept( listen_fd, 0, 0 );
+		if ( conn >= 0 ) {
+			num_connections++;
+			handle( conn );
+			close( conn );
+		}
+	}
+}
+
+void HttpStandin::handle( int conn ) {
+	std::string buf;
+	char chunk[2048];
+
+	while ( running ) {
+		size_t end = buf.find( "\r\n\r\n" );
+		if ( std::string::npos == end ) {
+			struct pollfd p = { conn, POLLIN, 0 };
+			if ( poll( &p, 1, 50 ) == 0 ) {
+				continue;
+			}
+			ssize_t n = recv( conn, chunk, sizeof( chunk ), 0 );
+			if ( n <= 0 ) {
+				return;
+			}
+			buf.append( chunk, (size_t) n );
+			continue;
+		}
+
+		/* request line: GET <target> HTTP/1.1 */
+		std::string line = buf.substr( 0, buf.find( "\r\n" ) );
+		buf.erase( 0, end + 4 );
+		size_t sp1 = line.find( ' ' );
+		size_t sp2 = line.rfind( ' ' );
+		if ( ( std::string::npos == sp1 ) || ( sp1 == sp2 ) ) {
+			return;
+		}
+		bool keep_open = true;
+		if ( !answer( conn, line.substr( sp1 + 1, sp2 - sp1 - 1 ), &keep_open ) || !keep_open ) {
+			return;
+		}
+	}
+}
+
+static bool has_param( const std::string &query, const char *name ) {
+	std::string key = std::string( name ) + "=";
+	size_t at = query.find( key );
+	while ( std::string::npos != at ) {
+		if ( ( 0 == at ) || ( '&' == query[at - 1] ) ) {
+			return true;
+		}
+		at = query.find( key, at + 1 );
+	}
+	return false;
+}
+
+bool HttpStandin::answer( int conn, const std::string &target, bool *keep_open ) {
+	uint64_t n = ++num_requests;
+	const char *status = "200 OK";
+	const char *body = "success\n";
+
+	if ( faults.drop_every && ( 0 == n % faults.drop_every ) ) {
+		*keep_open = false;
+		return true;
+	}
+	if ( faults.fail_every && ( 0 == n % faults.fail_every ) ) {
+		status = "500 Internal Server Error";
+		body = "error\n";
+	}
+	else {
+		size_t q = target.find( '?' );
+		std::string query = ( std::string::npos == q ) ? "" : target.substr( q + 1 );
+		if ( !has_param( query, "ID" ) || !has_param( query, "PASSWORD" ) ||
+		     !has_param( query, "dateutc" ) ||
+		     ( std::string::npos == query.find( "action=updateraw" ) ) ) {
+			body = "INVALIDPASSWORDID|Password or key and/or id are incorrect\n";
+		}
+		else {
+			std::lock_guard<std::mutex> g( lock );
+			updates.push_back( query );
+		}
+	}
+
+	char head[160];
+	std::string resp;
+	if ( faults.chunk_every && ( 0 == n % faults.chunk_every ) ) {
+		/* split so it takes more than one chunk, with an extension and a trailer */
+		size_t half = strlen( body ) / 2;
+		int hl = snprintf( head, sizeof( head ),
+		                   "HTTP/1.1 %s\r\nContent-Type: text/plain\r\n"
+		                   "Transfer-Encoding: chunked\r\n\r\n%zx;x=1\r\n",
+		                   status, half );
+		resp = std::string( head, (size_t) hl ) + std::string( body, half );
+		hl = snprintf( head, sizeof( head ), "\r\n%zx\r\n%s\r\n0\r\nX-End: 1\r\n\r\n",
+		               strlen( body ) - half, body + half );
+		resp += std::string( head, (size_t) hl );
+	}
+	else if ( faults.close_every && ( 0 == n % faults.close_every ) ) {
+		int hl = snprintf( head, sizeof( head ),
+		                   "HTTP/1.1 %s\r\nContent-Type: text/plain\r\nConnection: close\r\n\r\n",
+		                   status );
+		resp = std::string( head, (size_t) hl ) + body;
+		*keep_open = false;
+	}
+	else {
+		int hl = snprintf( head, sizeof( head ),
+		                   "HTTP/1.1 %s\r\nContent-Type: text/plain\r\nContent-Length: %zu\r\n\r\n",
+		                   status, strlen( body ) );
+		resp = std::string( head, (size_t) hl ) + body;
+	}
+	return send( conn, resp.data(), resp.size(), MSG_NOSIGNAL ) == (ssize_t) resp.size();
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,69 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file http_standin.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Local stand-in for the Wunderground update endpoint.
+ *
+ * @details    Serves HTTP/1.1 keep-alive GETs on a background thread and
+ *             records the query of every update it accepts.  A request must
+ *             carry ID, PASSWORD, dateutc and action=updateraw to be answered
+ *             "success".  Faults can be injected to exercise retries: every
+ *             fail_every-th request gets a 500, every drop_every-th has its
+ *             connection closed without an answer.  Neither is recorded, so a
+ *             correct client ends up with every update accepted exactly once.
+ *             Every chunk_every-th answer is sent with chunked transfer coding
+ *             and every close_every-th with no length at all, the body ending
+ *             where the server closes the connection.
+ */
+
+#ifndef HTTP_STANDIN_H
+#define HTTP_STANDIN_H
+
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class HttpStandin {
+public:
+	struct Faults {
+		uint32_t fail_every = 0;
+		uint32_t drop_every = 0;
+		uint32_t chunk_every = 0;
+		uint32_t close_every = 0;
+	};
+
+	HttpStandin();
+	~HttpStandin();
+
+	uint16_t start( uint16_t port, const Faults &faults );
+	void stop( void );
+
+	std::vector<std::string> accepted( void );
+	uint64_t requests( void ) const { return num_requests; }
+	uint64_t connections( void ) const { return num_connections; }
+
+private:
+	void serve( void );
+	void handle( int conn );
+	bool answer( int conn, const std::string &target, bool *keep_open );
+
+	int listen_fd;
+	Faults faults;
+	std::thread worker;
+	std::atomic<bool> running;
+	std::atomic<uint64_t> num_requests;
+	std::atomic<uint64_t> num_connections;
+	std::mutex lock;
+	std::vector<std::string> updates;
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,388 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file ingest_server.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "ingest_server.h"
+
+/* reads per ready descriptor before moving on to the next one */
+#define INGEST_READ_BUDGET          (4)
+#define INGEST_MAX_EVENTS           (256)
+/* epoll tag of the worker -> I/O thread wake up */
+#define INGEST_WAKE_TAG             (0xFFFFFFFFULL)
+
+static uint64_t mono_ns( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static unsigned lag_bucket( uint64_t ns ) {
+	uint64_t us = ns / 1000;
+	unsigned b = 0;
+	while ( us && ( b < INGEST_LAG_BUCKETS - 1 ) ) {
+		us >>= 1;
+		b++;
+	}
+	return b;
+}
+
+IngestServer::IngestServer( const Config &config ) : cfg( config ) {
+	if ( !cfg.workers ) {
+		cfg.workers = 1;
+	}
+	if ( cfg.low_water > cfg.high_water ) {
+		cfg.low_water = cfg.high_water;
+	}
+	epfd = -1;
+	wake_fd = -1;
+	stopping = false;
+	open_streams = 0;
+	total_records = 0;
+}
+
+IngestServer::~IngestServer() {
+	stop();
+	for ( auto &s : station ) {
+		if ( s->fd >= 0 ) {
+			close( s->fd );
+		}
+	}
+}
+
+/**
+ * @brief      Adds a stream to collect from - call before start().  The
+ *             descriptor is made non-blocking and closed by the server.
+ *
+ * @return     the station id, -1 on error.
+ */
+int IngestServer::add_stream( int fd, const std::string &name ) {
+	if ( ( fd < 0 ) || ( epfd >= 0 ) ) {
+		return -1;
+	}
+	fcntl( fd, F_SETFL, fcntl( fd, F_GETFL ) | O_NONBLOCK );
+
+	std::unique_ptr<Station> s( new Station );
+	s->fd = fd;
+	s->name = name;
+	s->open = true;
+	s->paused = false;
+	s->queued = 0;
+	s->in_epoll = false;
+	s->paused_at_ns = 0;
+	s->lag_count = 0;
+	s->lag_sum_ns = 0;
+	s->lag_max_ns = 0;
+	memset( s->lag_hist, 0, sizeof( s->lag_hist ) );
+	s->pauses = 0;
+	s->paused_ns = 0;
+	station.push_back( std::move( s ) );
+	return (int) station.size() - 1;
+}
+
+/**
+ * @brief      Starts the I/O thread and the workers.
+ */
+bool IngestServer::start( void ) {
+	epfd = epoll_create1( EPOLL_CLOEXEC );
+	wake_fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+	if ( ( epfd < 0 ) || ( wake_fd < 0 ) ) {
+		return false;
+	}
+	struct epoll_event ev;
+	ev.events = EPOLLIN;
+	ev.data.u64 = INGEST_WAKE_TAG;
+	epoll_ctl( epfd, EPOLL_CTL_ADD, wake_fd, &ev );
+
+	open_streams = station.size();
+	for ( uint32_t i = 0; i < station.size(); i++ ) {
+		resume( i );
+	}
+	for ( unsigned i = 0; i < cfg.workers; i++ ) {
+		worker.emplace_back( new Worker );
+	}
+	for ( auto &w : worker ) {
+		Worker *wp = w.get();
+		w->thread = std::thread( [this, wp] { worker_loop( wp ); } );
+	}
+	io_thread = std::thread( [this] { io_loop(); } );
+	return true;
+}
+
+/**
+ * @brief      Stops reading, lets the workers finish what is queued and
+ *             joins every thread.
+ */
+void IngestServer::stop( void ) {
+	if ( epfd < 0 ) {
+		return;
+	}
+	stopping = true;
+	uint64_t one = 1;
+	ssize_t n = write( wake_fd, &one, sizeof( one ) );
+	(void) n;
+	if ( io_thread.joinable() ) {
+		io_thread.join();
+	}
+	for ( auto &w : worker ) {
+		{
+			std::lock_guard<std::mutex> lock( w->m );
+			w->queue.push_back( 0 );
+		}
+		w->cv.notify_one();
+	}
+	for ( auto &w : worker ) {
+		if ( w->thread.joinable() ) {
+			w->thread.join();
+		}
+	}
+	worker.clear();
+	close( epfd );
+	close( wake_fd );
+	epfd = -1;
+	wake_fd = -1;
+}
+
+/**
+ * @brief      Every stream has hung up and everything read is processed.
+ */
+bool IngestServer::finished( void ) const {
+	if ( open_streams.load() ) {
+		return false;
+	}
+	for ( auto &s : station ) {
+		if ( s->queued.load() ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief      Copies out one station's state.
+ */
+void IngestServer::snapshot( size_t id, StationView *view ) {
+	Station *s = station[id].get();
+	std::lock_guard<std::mutex> lock( s->m );
+	view->name = s->name;
+	view->open = s->open.load();
+	view->agg = s->agg;
+	view->link = s->dec.stats();
+	view->lag_count = s->lag_count;
+	view->lag_sum_ns = s->lag_sum_ns;
+	view->lag_max_ns = s->lag_max_ns;
+	memcpy( view->lag_hist, s->lag_hist, sizeof( view->lag_hist ) );
+	view->queued_bytes = s->queued.load();
+	view->pauses = s->pauses.load();
+	view->paused_ns = s->paused_ns.load();
+}
+
+/**
+ * @brief      Lag below which pct percent of the histogram falls, as the
+ *             upper edge of its bucket in microseconds.
+ */
+uint64_t IngestServer::lag_percentile_us( const uint64_t *hist, double pct ) {
+	uint64_t total = 0;
+	for ( unsigned i = 0; i < INGEST_LAG_BUCKETS; i++ ) {
+		total += hist[i];
+	}
+	if ( !total ) {
+		return 0;
+	}
+	uint64_t want = (uint64_t) ( total * pct / 100.0 );
+	uint64_t seen = 0;
+	for ( unsigned i = 0; i < INGEST_LAG_BUCKETS; i++ ) {
+		seen += hist[i];
+		if ( seen > want ) {
+			return 1ULL << i;
+		}
+	}
+	return 1ULL << ( INGEST_LAG_BUCKETS - 1 );
+}
+
+void IngestServer::io_loop( void ) {
+	struct epoll_event ev[INGEST_MAX_EVENTS];
+
+	while ( !stopping.load() && open_streams.load() ) {
+		int n = epoll_wait( epfd, ev, INGEST_MAX_EVENTS, 100 );
+		for ( int i = 0; i < n; i++ ) {
+			if ( INGEST_WAKE_TAG == ev[i].data.u64 ) {
+				uint64_t v;
+				ssize_t r = read( wake_fd, &v, sizeof( v ) );
+				(void) r;
+				std::vector<uint32_t> ids;
+				{
+					std::lock_guard<std::mutex> lock( resume_m );
+					ids.swap( resume_list );
+				}
+				for ( uint32_t id : ids ) {
+					Station *s = station[id].get();
+					if ( s->paused.load() && ( s->queued.load() <= cfg.low_water ) ) {
+						resume( id );
+					}
+				}
+			}
+			else {
+				read_stream( (uint32_t) ev[i].data.u64 );
+			}
+		}
+	}
+}
+
+void IngestServer::read_stream( uint32_t id ) {
+	Station *s = station[id].get();
+	if ( !s->in_epoll ) {
+		return;
+	}
+	for ( int i = 0; i < INGEST_READ_BUDGET; i++ ) {
+		Chunk *c = (Chunk *) malloc( offsetof( Chunk, data ) + cfg.chunk_bytes );
+		ssize_t n = read( s->fd, c->data, cfg.chunk_bytes );
+		if ( n <= 0 ) {
+			free( c );
+			/* a PTY whose master has gone reads EIO rather than 0 */
+			if ( ( 0 == n ) || ( ( EAGAIN != errno ) && ( EINTR != errno ) ) ) {
+				close_stream( id );
+			}
+			return;
+		}
+		c->station = id;
+		c->len = (uint32_t) n;
+		c->read_ns = mono_ns();
+
+		size_t queued = s->queued.fetch_add( (size_t) n ) + (size_t) n;
+		Worker *w = worker[id % worker.size()].get();
+		bool was_empty;
+		{
+			std::lock_guard<std::mutex> lock( w->m );
+			was_empty = w->queue.empty();
+			w->queue.push_back( c );
+		}
+		if ( was_empty ) {
+			w->cv.notify_one();
+		}
+		if ( queued > cfg.high_water ) {
+			pause( id );
+			return;
+		}
+	}
+}
+
+void IngestServer::close_stream( uint32_t id ) {
+	Station *s = station[id].get();
+	if ( s->in_epoll ) {
+		epoll_ctl( epfd, EPOLL_CTL_DEL, s->fd, 0 );
+		s->in_epoll = false;
+	}
+	close( s->fd );
+	s->fd = -1;
+	s->open = false;
+	open_streams--;
+}
+
+/**
+ * @brief      Stops reading a station until its backlog drains.  The
+ *             descriptor leaves the epoll set entirely - with only its
+ *             events masked a hang up would still be reported every pass.
+ */
+void IngestServer::pause( uint32_t id ) {
+	Station *s = station[id].get();
+	epoll_ctl( epfd, EPOLL_CTL_DEL, s->fd, 0 );
+	s->in_epoll = false;
+	s->paused_at_ns = mono_ns();
+	s->pauses++;
+	s->paused = true;
+	/* the worker may have drained it before seeing the flag */
+	if ( s->queued.load() <= cfg.low_water ) {
+		resume( id );
+	}
+}
+
+void IngestServer::resume( uint32_t id ) {
+	Station *s = station[id].get();
+	if ( ( s->fd < 0 ) || s->in_epoll ) {
+		return;
+	}
+	if ( s->paused.exchange( false ) ) {
+		s->paused_ns += mono_ns() - s->paused_at_ns;
+	}
+	struct epoll_event ev;
+	ev.events = EPOLLIN;
+	ev.data.u64 = id;
+	if ( 0 == epoll_ctl( epfd, EPOLL_CTL_ADD, s->fd, &ev ) ) {
+		s->in_epoll = true;
+	}
+	else {
+		close_stream( id );
+	}
+}
+
+void IngestServer::worker_loop( Worker *w ) {
+	std::vector<Chunk *> batch;
+	for ( ;; ) {
+		{
+			std::unique_lock<std::mutex> lock( w->m );
+			w->cv.wait( lock, [w] { return !w->queue.empty(); } );
+			batch.swap( w->queue );
+		}
+		for ( Chunk *c : batch ) {
+			if ( !c ) {
+				return;
+			}
+			process( c );
+		}
+		batch.clear();
+	}
+}
+
+void IngestServer::process( Chunk *c ) {
+	Station *s = station[c->station].get();
+	uint64_t records = 0;
+	{
+		std::lock_guard<std::mutex> lock( s->m );
+		uint64_t now = 0;
+		auto lag = [&]( void ) {
+			if ( !now ) {
+				now = mono_ns();
+			}
+			uint64_t ns = now - c->read_ns;
+			s->lag_count++;
+			s->lag_sum_ns += ns;
+			if ( ns > s->lag_max_ns ) {
+				s->lag_max_ns = ns;
+			}
+			s->lag_hist[lag_bucket( ns )]++;
+			records++;
+		};
+		s->dec.feed( c->data, c->len,
+		             [&]( const TELEMETRY_RECORD_T &rec ) { s->agg.add( rec ); lag(); },
+		             [&]( const RINGLOG_RECORD_T &rec ) { s->agg.add_log( rec ); lag(); } );
+	}
+	total_records.fetch_add( records, std::memory_order_relaxed );
+
+	size_t left = s->queued.fetch_sub( c->len ) - c->len;
+	if ( ( left <= cfg.low_water ) && s->paused.load() ) {
+		{
+			std::lock_guard<std::mutex> lock( resume_m );
+			resume_list.push_back( c->station );
+		}
+		uint64_t one = 1;
+		ssize_t n = write( wake_fd, &one, sizeof( one ) );
+		(void) n;
+	}
+	free( c );
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,145 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file ingest_server.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Collector for a fleet of stations: one epoll I/O thread reads
+ *             every serial / PTY stream, a pool of workers decodes the
+ *             frames and keeps a StationAggregate per station.
+ *
+ * @details    Each station belongs to one worker (station index modulo the
+ *             worker count), so its frames are decoded in order and its
+ *             decoder and aggregate are only ever touched by that thread -
+ *             the per-station mutex exists for snapshot() and is otherwise
+ *             uncontended.  The I/O thread reads into chunks and queues them
+ *             on the owning worker without copying.
+ *
+ *             Back-pressure is per station: once more than high_water bytes
+ *             of a station are queued its descriptor is taken out of the
+ *             epoll set, so the kernel buffer fills and the sender blocks,
+ *             and it is put back once the worker has brought the backlog
+ *             under low_water.  Other stations keep flowing.
+ *
+ *             Lag is the time from the read() that completed a frame to the
+ *             worker handing the record to the aggregate, kept per station
+ *             as a mean, a maximum and a log2 histogram in microseconds.
+ */
+
+#ifndef INGEST_SERVER_H
+#define INGEST_SERVER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "station_aggregate.h"
+#include "telemetry_decoder.h"
+
+/* @brief      log2 lag buckets: < 1 us, < 2 us, ... >= 2^(N-2) us */
+#define INGEST_LAG_BUCKETS 24
+
+class IngestServer {
+public:
+	struct Config {
+		unsigned workers = 1;
+		size_t chunk_bytes = 4096;
+		size_t high_water = 256 * 1024;
+		size_t low_water = 64 * 1024;
+	};
+
+	/** @brief A consistent copy of one station's state. */
+	struct StationView {
+		std::string name;
+		bool open;
+		StationAggregate agg;
+		TelemetryDecoder::Stats link;
+		uint64_t lag_count;
+		uint64_t lag_sum_ns;
+		uint64_t lag_max_ns;
+		uint64_t lag_hist[INGEST_LAG_BUCKETS];
+		uint64_t queued_bytes;
+		uint64_t pauses;
+		uint64_t paused_ns;
+	};
+
+	explicit IngestServer( const Config &cfg );
+	~IngestServer();
+
+	int add_stream( int fd, const std::string &name );
+	bool start( void );
+	void stop( void );
+	bool finished( void ) const;
+	size_t stations( void ) const { return station.size(); }
+	void snapshot( size_t id, StationView *view );
+	uint64_t records( void ) const { return total_records.load( std::memory_order_relaxed ); }
+
+	static uint64_t lag_percentile_us( const uint64_t *hist, double pct );
+
+private:
+	struct Chunk {
+		uint32_t station;
+		uint32_t len;
+		uint64_t read_ns;
+		uint8_t data[1];
+	};
+
+	struct Station {
+		int fd;
+		std::string name;
+		std::atomic<bool> open;
+		std::atomic<bool> paused;
+		std::atomic<size_t> queued;
+		/* I/O thread only */
+		bool in_epoll;
+		uint64_t paused_at_ns;
+		/* owning worker, and snapshot() */
+		std::mutex m;
+		TelemetryDecoder dec;
+		StationAggregate agg;
+		uint64_t lag_count;
+		uint64_t lag_sum_ns;
+		uint64_t lag_max_ns;
+		uint64_t lag_hist[INGEST_LAG_BUCKETS];
+		std::atomic<uint64_t> pauses;
+		std::atomic<uint64_t> paused_ns;
+	};
+
+	struct Worker {
+		std::mutex m;
+		std::condition_variable cv;
+		std::vector<Chunk *> queue;
+		std::thread thread;
+	};
+
+	Config cfg;
+	std::vector<std::unique_ptr<Station> > station;
+	std::vector<std::unique_ptr<Worker> > worker;
+	std::thread io_thread;
+	int epfd;
+	int wake_fd;
+	std::atomic<bool> stopping;
+	std::atomic<size_t> open_streams;
+	std::atomic<uint64_t> total_records;
+	std::mutex resume_m;
+	std::vector<uint32_t> resume_list;
+
+	void io_loop( void );
+	void read_stream( uint32_t id );
+	void close_stream( uint32_t id );
+	void pause( uint32_t id );
+	void resume( uint32_t id );
+	void worker_loop( Worker *w );
+	void process( Chunk *c );
+};
+
+#endif
+
+/** @} end of addtogroup */
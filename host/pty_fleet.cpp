@@ -0,0 +1,255 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file pty_fleet.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+
+#include "pty_fleet.h"
+
+/* frames packed into one write() when flooding */
+#define FLEET_BATCH_FRAMES          (64)
+#define FLEET_POLL_MS               (10)
+
+static uint64_t mono_ns( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+PtyFleet::PtyFleet() {
+	stopping = false;
+	frames_sent = 0;
+	stalled_ns = 0;
+}
+
+PtyFleet::~PtyFleet() {
+	stop();
+	hang_up();
+}
+
+/**
+ * @brief      Creates one PTY per station.
+ *
+ * @return     false if the system ran out of PTYs or descriptors.
+ */
+bool PtyFleet::open( unsigned stations ) {
+	/* two descriptors per station here, one more in the collector */
+	struct rlimit rl;
+	if ( ( 0 == getrlimit( RLIMIT_NOFILE, &rl ) ) && ( rl.rlim_cur < rl.rlim_max ) ) {
+		rl.rlim_cur = rl.rlim_max;
+		setrlimit( RLIMIT_NOFILE, &rl );
+	}
+	for ( unsigned i = 0; i < stations; i++ ) {
+		Station s;
+		memset( &s.rec, 0, sizeof( s.rec ) );
+		s.master = posix_openpt( O_RDWR | O_NOCTTY );
+		if ( ( s.master < 0 ) || grantpt( s.master ) || unlockpt( s.master ) ) {
+			if ( s.master >= 0 ) {
+				close( s.master );
+			}
+			return false;
+		}
+		s.path = ptsname( s.master );
+		s.slave = ::open( s.path.c_str(), O_RDWR | O_NOCTTY );
+		if ( s.slave < 0 ) {
+			close( s.master );
+			return false;
+		}
+		struct termios t;
+		tcgetattr( s.slave, &t );
+		cfmakeraw( &t );
+		tcsetattr( s.slave, TCSANOW, &t );
+		fcntl( s.master, F_SETFL, fcntl( s.master, F_GETFL ) | O_NONBLOCK );
+
+		/* every station starts somewhere different */
+		s.rec.seq = (uint16_t) ( i * 7919 );
+		s.rec.valid = TELEM_VALID_HTU | TELEM_VALID_MPL_T | TELEM_VALID_MPL_P;
+		s.rec.wind_spd = 5000 + ( i % 20 ) * 1000;
+		s.rec.temp_htu_c100 = (int16_t) ( 1000 + ( i % 30 ) * 50 );
+		s.rec.humidity_c100 = 5000;
+		s.rec.pressure_pa4 = 405300;
+		s.sent = 0;
+		s.next_ns = 0;
+		s.buf.resize( FLEET_BATCH_FRAMES * TELEMETRY_FRAME_LEN );
+		s.buf_len = 0;
+		s.buf_off = 0;
+		station.push_back( s );
+	}
+	return true;
+}
+
+/**
+ * @brief      Starts the writer threads.
+ */
+void PtyFleet::start( const Config &config ) {
+	cfg = config;
+	if ( !cfg.writers ) {
+		cfg.writers = 1;
+	}
+	stopping = false;
+	uint64_t now = mono_ns();
+	for ( unsigned i = 0; i < station.size(); i++ ) {
+		/* spread the first frames over one period */
+		station[i].next_ns = now + ( cfg.flood ? 0 :
+		                     (uint64_t) ( 1e9 / cfg.rate_hz * i / station.size() ) );
+	}
+	for ( unsigned i = 0; i < cfg.writers; i++ ) {
+		writer.emplace_back( [this, i] { writer_loop( i, cfg.writers ); } );
+	}
+}
+
+/**
+ * @brief      Waits for the writers - they finish once every station has
+ *             sent cfg.records frames.
+ */
+void PtyFleet::wait( void ) {
+	for ( auto &t : writer ) {
+		t.join();
+	}
+	writer.clear();
+}
+
+void PtyFleet::stop( void ) {
+	stopping = true;
+	wait();
+}
+
+/**
+ * @brief      The reader has taken everything written so far.
+ */
+bool PtyFleet::drained( void ) const {
+	for ( const Station &s : station ) {
+		int n = 0;
+		if ( ( s.slave >= 0 ) && ( 0 == ioctl( s.slave, FIONREAD, &n ) ) && n ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief      Closes every PTY.  Anything the reader has not taken yet is
+ *             lost, as with a pulled USB cable - see drained().
+ */
+void PtyFleet::hang_up( void ) {
+	for ( Station &s : station ) {
+		if ( s.master >= 0 ) {
+			close( s.master );
+			s.master = -1;
+		}
+		if ( s.slave >= 0 ) {
+			close( s.slave );
+			s.slave = -1;
+		}
+	}
+}
+
+/**
+ * @brief      Moves one station's weather on by a report.
+ */
+static void step_weather( TELEMETRY_RECORD_T *r, uint32_t rnd ) {
+	r->seq++;
+	r->time_ms += 5000;
+	int32_t w = (int32_t) r->wind_spd + (int32_t) ( rnd % 2001 ) - 1000;
+	r->wind_spd = ( w < 0 ) ? 0 : (uint32_t) w;
+	r->wind_spd_2m = r->wind_spd;
+	r->gust_spd = r->wind_spd + ( ( rnd >> 11 ) % 8000 );
+	r->wind_dir = (uint16_t) ( ( rnd >> 5 ) % 360 );
+	r->gust_dir = r->wind_dir;
+	r->temp_htu_c100 += (int16_t) ( ( rnd >> 20 ) % 5 ) - 2;
+	r->temp_mpl_c100 = r->temp_htu_c100;
+	r->pressure_pa4 += ( ( rnd >> 25 ) % 9 ) - 4;
+}
+
+/**
+ * @brief      Refills an empty station buffer with the frames that are
+ *             due - one at a time at the report rate, a batch when flooding.
+ *
+ * @return     true if there is something to write.
+ */
+bool PtyFleet::fill( Station *s, uint64_t now_ns ) {
+	if ( s->buf_off < s->buf_len ) {
+		return true;
+	}
+	s->buf_len = 0;
+	s->buf_off = 0;
+	while ( s->buf_len + TELEMETRY_FRAME_LEN <= s->buf.size() ) {
+		if ( ( cfg.records && ( s->sent >= cfg.records ) ) ||
+		     ( !cfg.flood && ( now_ns < s->next_ns ) ) ) {
+			break;
+		}
+		/* seed from the record itself, so each station walks on its own */
+		uint32_t x = ( (uint32_t) s->rec.seq << 16 ) ^ s->rec.time_ms ^ 0x9E3779B9u;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		step_weather( &s->rec, x );
+		s->buf_len += telemetry_frame( &s->rec, &s->buf[s->buf_len] );
+		s->sent++;
+		frames_sent++;
+		if ( !cfg.flood ) {
+			s->next_ns += (uint64_t) ( 1e9 / cfg.rate_hz );
+			break;
+		}
+	}
+	return s->buf_len > 0;
+}
+
+void PtyFleet::writer_loop( unsigned first, unsigned step ) {
+	std::vector<struct pollfd> blocked;
+
+	while ( !stopping.load() ) {
+		bool busy = false;
+		bool wrote = false;
+		blocked.clear();
+		uint64_t now = mono_ns();
+
+		for ( unsigned i = first; i < station.size(); i += step ) {
+			Station *s = &station[i];
+			if ( !fill( s, now ) ) {
+				if ( !cfg.records || ( s->sent < cfg.records ) ) {
+					busy = true;
+				}
+				continue;
+			}
+			busy = true;
+			ssize_t n = write( s->master, &s->buf[s->buf_off], s->buf_len - s->buf_off );
+			if ( n > 0 ) {
+				s->buf_off += (size_t) n;
+				wrote = true;
+			}
+			if ( s->buf_off < s->buf_len ) {
+				blocked.push_back( { s->master, POLLOUT, 0 } );
+			}
+		}
+		if ( !busy ) {
+			return;
+		}
+		if ( !wrote ) {
+			if ( blocked.empty() ) {
+				/* nothing due yet */
+				usleep( 1000 );
+			}
+			else {
+				uint64_t t0 = mono_ns();
+				poll( blocked.data(), blocked.size(), FLEET_POLL_MS );
+				stalled_ns += mono_ns() - t0;
+			}
+		}
+	}
+}
+
+/** @} end of addtogroup */
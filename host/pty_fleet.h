@@ -0,0 +1,85 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file pty_fleet.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Simulated fleet of stations, each talking through its own
+ *             pseudo-terminal exactly as a board talks through its USB
+ *             serial port.
+ *
+ * @details    Each station sends binary telemetry frames (Telemetry.h) with
+ *             its own sequence numbers and slowly changing weather.  Writer
+ *             threads share the stations between them and write without
+ *             blocking, so one slow reader never holds up another station;
+ *             time spent with every station of a thread blocked is counted
+ *             as a stall.  The slave ends are put in raw mode and held open
+ *             so the line discipline stays raw and a collector can open and
+ *             close them freely.
+ */
+
+#ifndef PTY_FLEET_H
+#define PTY_FLEET_H
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Telemetry.h"
+
+class PtyFleet {
+public:
+	struct Config {
+		unsigned writers = 1;
+		double rate_hz = 0.2;           /* frames per station per second */
+		bool flood = false;             /* ignore rate_hz, send flat out */
+		uint64_t records = 0;           /* per station, 0 = until stop() */
+	};
+
+	PtyFleet();
+	~PtyFleet();
+
+	bool open( unsigned stations );
+	unsigned size( void ) const { return (unsigned) station.size(); }
+	const std::string &path( unsigned i ) const { return station[i].path; }
+
+	void start( const Config &cfg );
+	void wait( void );
+	void stop( void );
+	bool drained( void ) const;
+	void hang_up( void );
+
+	uint64_t frames( void ) const { return frames_sent.load(); }
+	uint64_t stall_ns( void ) const { return stalled_ns.load(); }
+
+private:
+	struct Station {
+		int master;
+		int slave;
+		std::string path;
+		TELEMETRY_RECORD_T rec;
+		uint64_t sent;
+		uint64_t next_ns;
+		std::vector<uint8_t> buf;       /* frames not yet written */
+		size_t buf_len;
+		size_t buf_off;
+	};
+
+	Config cfg;
+	std::vector<Station> station;
+	std::vector<std::thread> writer;
+	std::atomic<bool> stopping;
+	std::atomic<uint64_t> frames_sent;
+	std::atomic<uint64_t> stalled_ns;
+
+	void writer_loop( unsigned first, unsigned step );
+	bool fill( Station *s, uint64_t now_ns );
+};
+
+#endif
+
+/** @} end of addtogroup */
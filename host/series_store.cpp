@@ -0,0 +1,501 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file series_store.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "series_store.h"
+
+/* worst case: 5 + 64 bits of timestamp, 2 + 5 + 6 + 64 of value */
+#define SERIES_MAX_SAMPLE_BITS      (146)
+/* value XOR window not set yet */
+#define SERIES_NO_WINDOW            (0xFF)
+
+static uint64_t double_bits( double v ) {
+	uint64_t b;
+	memcpy( &b, &v, sizeof( b ) );
+	return b;
+}
+
+static double bits_double( uint64_t b ) {
+	double v;
+	memcpy( &v, &b, sizeof( v ) );
+	return v;
+}
+
+/*----------------------------------------------------------------------------*/
+
+SeriesBlockDecoder::SeriesBlockDecoder( const SERIES_BLOCK_HDR_T &hdr, const uint8_t *payload ) {
+	data = payload;
+	bits = hdr.bits;
+	pos = 0;
+	left = hdr.count;
+	t = hdr.t_first;
+	delta = 0;
+	value = double_bits( hdr.v_first );
+	lead = SERIES_NO_WINDOW;
+	trail = 0;
+	first = true;
+}
+
+uint64_t SeriesBlockDecoder::get( unsigned n ) {
+	uint64_t v = 0;
+	while ( n ) {
+		unsigned avail = 8 - ( pos & 7 );
+		unsigned take = ( n < avail ) ? n : avail;
+		uint8_t byte = data[pos >> 3];
+		v = ( v << take ) | ( ( byte >> ( avail - take ) ) & ( ( 1u << take ) - 1 ) );
+		pos += take;
+		n -= take;
+	}
+	return v;
+}
+
+/**
+ * @brief      Fetches the next sample of the block.
+ *
+ * @return     false once the block is exhausted (or its stream is short).
+ */
+bool SeriesBlockDecoder::next( int64_t *t_out, double *v_out ) {
+	if ( !left ) {
+		return false;
+	}
+	left--;
+	if ( first ) {
+		first = false;
+		*t_out = t;
+		*v_out = bits_double( value );
+		return true;
+	}
+	if ( pos + 2 > bits ) {
+		left = 0;
+		return false;
+	}
+
+	/* timestamp: delta of delta */
+	int64_t dod;
+	if ( !get( 1 ) ) {
+		dod = 0;
+	}
+	else if ( !get( 1 ) ) {
+		dod = (int64_t) get( 7 ) - 63;
+	}
+	else if ( !get( 1 ) ) {
+		dod = (int64_t) get( 9 ) - 255;
+	}
+	else if ( !get( 1 ) ) {
+		dod = (int64_t) get( 12 ) - 2047;
+	}
+	else if ( !get( 1 ) ) {
+		dod = (int32_t) (uint32_t) get( 32 );
+	}
+	else {
+		dod = (int64_t) get( 64 );
+	}
+	delta += dod;
+	t += delta;
+
+	/* value: XOR with the previous one */
+	if ( get( 1 ) ) {
+		if ( get( 1 ) ) {
+			lead = (uint8_t) get( 5 );
+			unsigned len = (unsigned) get( 6 ) + 1;
+			trail = (uint8_t) ( 64 - lead - len );
+		}
+		unsigned len = 64 - lead - trail;
+		value ^= get( len ) << trail;
+	}
+	*t_out = t;
+	*v_out = bits_double( value );
+	return true;
+}
+
+/*----------------------------------------------------------------------------*/
+
+SeriesFile::SeriesFile() {
+	fd = -1;
+	writable = false;
+	sample_count = 0;
+	tail_index = 0;
+	memset( tail, 0, sizeof( tail ) );
+	tail_dirty = false;
+	prev_t = 0;
+	prev_delta = 0;
+	prev_value = 0;
+	lead = SERIES_NO_WINDOW;
+	trail = 0;
+	map_base = 0;
+	map_len = 0;
+	map_blocks = 0;
+}
+
+SeriesFile::~SeriesFile() {
+	close();
+}
+
+/**
+ * @brief      Opens (and if writable, creates) a series file.  A writable
+ *             file carries on filling its last block.
+ *
+ * @return     false if the file cannot be opened or is not a series file.
+ */
+bool SeriesFile::open( const std::string &file, bool rw ) {
+	close();
+	path = file;
+	writable = rw;
+	fd = ::open( path.c_str(), rw ? ( O_RDWR | O_CREAT ) : O_RDONLY, 0644 );
+	if ( fd < 0 ) {
+		return false;
+	}
+
+	uint8_t hdr[SERIES_FILE_HDR_LEN];
+	ssize_t n = pread( fd, hdr, sizeof( hdr ), 0 );
+	if ( ( 0 == n ) && rw ) {
+		uint32_t version = SERIES_FILE_VERSION;
+		uint32_t block_bytes = SERIES_BLOCK_BYTES;
+		memset( hdr, 0, sizeof( hdr ) );
+		memcpy( hdr, SERIES_FILE_MAGIC, 8 );
+		memcpy( hdr + 8, &version, 4 );
+		memcpy( hdr + 12, &block_bytes, 4 );
+		if ( pwrite( fd, hdr, sizeof( hdr ), 0 ) != (ssize_t) sizeof( hdr ) ) {
+			close();
+			return false;
+		}
+	}
+	else {
+		uint32_t version;
+		uint32_t block_bytes;
+		memcpy( &version, hdr + 8, 4 );
+		memcpy( &block_bytes, hdr + 12, 4 );
+		if ( ( n != (ssize_t) sizeof( hdr ) ) || memcmp( hdr, SERIES_FILE_MAGIC, 8 ) ||
+		     ( SERIES_FILE_VERSION != version ) || ( SERIES_BLOCK_BYTES != block_bytes ) ) {
+			close();
+			return false;
+		}
+	}
+	if ( !map() ) {
+		close();
+		return false;
+	}
+
+	SERIES_BLOCK_HDR_T bh;
+	size_t used = 0;
+	for ( size_t b = 0; b < map_blocks; b++ ) {
+		if ( !block( b, &bh ) ) {
+			break;
+		}
+		sample_count += bh.count;
+		used = b + 1;
+	}
+	tail_index = used;
+	if ( used ) {
+		return load_tail();
+	}
+	return true;
+}
+
+/**
+ * @brief      Picks the last block back up, replaying it to recover the
+ *             encoder's state.
+ */
+bool SeriesFile::load_tail( void ) {
+	tail_index--;
+	SERIES_BLOCK_HDR_T hdr;
+	const uint8_t *blk = block( tail_index, &hdr );
+	if ( !blk ) {
+		return false;
+	}
+	memcpy( tail, blk, SERIES_BLOCK_BYTES );
+
+	SeriesBlockDecoder dec( hdr, tail + sizeof( hdr ) );
+	int64_t t;
+	double v;
+	uint32_t n = 0;
+	while ( dec.next( &t, &v ) ) {
+		n++;
+	}
+	if ( n != hdr.count ) {
+		return false;
+	}
+	prev_t = dec.t;
+	prev_delta = dec.delta;
+	prev_value = dec.value;
+	lead = dec.lead;
+	trail = dec.trail;
+	return true;
+}
+
+void SeriesFile::close( void ) {
+	if ( fd < 0 ) {
+		return;
+	}
+	flush();
+	unmap();
+	::close( fd );
+	fd = -1;
+	sample_count = 0;
+	tail_index = 0;
+	memset( tail, 0, sizeof( tail ) );
+	prev_t = 0;
+	prev_delta = 0;
+	lead = SERIES_NO_WINDOW;
+}
+
+uint64_t SeriesFile::file_bytes( void ) const {
+	struct stat st;
+	return ( ( fd >= 0 ) && ( 0 == fstat( fd, &st ) ) ) ? (uint64_t) st.st_size : 0;
+}
+
+/**
+ * @brief      Writes the block being filled to its place in the file.
+ */
+bool SeriesFile::flush( void ) {
+	if ( !writable || !tail_dirty ) {
+		return true;
+	}
+	off_t at = SERIES_FILE_HDR_LEN + (off_t) tail_index * SERIES_BLOCK_BYTES;
+	if ( pwrite( fd, tail, SERIES_BLOCK_BYTES, at ) != SERIES_BLOCK_BYTES ) {
+		return false;
+	}
+	tail_dirty = false;
+	return true;
+}
+
+void SeriesFile::put( uint64_t value, unsigned n ) {
+	SERIES_BLOCK_HDR_T *hdr = tail_hdr();
+	uint8_t *data = tail + sizeof( SERIES_BLOCK_HDR_T );
+	while ( n ) {
+		unsigned avail = 8 - ( hdr->bits & 7 );
+		unsigned take = ( n < avail ) ? n : avail;
+		uint8_t chunk = (uint8_t) ( ( value >> ( n - take ) ) & ( ( 1u << take ) - 1 ) );
+		data[hdr->bits >> 3] |= (uint8_t) ( chunk << ( avail - take ) );
+		hdr->bits += take;
+		n -= take;
+	}
+}
+
+void SeriesFile::start_block( int64_t t, double v ) {
+	memset( tail, 0, sizeof( tail ) );
+	SERIES_BLOCK_HDR_T *hdr = tail_hdr();
+	hdr->magic = SERIES_BLOCK_MAGIC;
+	hdr->count = 1;
+	hdr->t_first = t;
+	hdr->t_last = t;
+	hdr->v_first = v;
+	hdr->min = v;
+	hdr->max = v;
+	hdr->sum = v;
+	prev_delta = 0;
+	prev_value = double_bits( v );
+	lead = SERIES_NO_WINDOW;
+	trail = 0;
+}
+
+/**
+ * @brief      Adds one sample to the end of the series.
+ *
+ * @return     false if t_ms is not after the last sample, v is not finite,
+ *             or a full block could not be written out.
+ */
+bool SeriesFile::append( int64_t t_ms, double v ) {
+	if ( !writable || !isfinite( v ) || ( sample_count && ( t_ms <= prev_t ) ) ) {
+		return false;
+	}
+	SERIES_BLOCK_HDR_T *hdr = tail_hdr();
+
+	if ( !sample_count || ( hdr->bits + SERIES_MAX_SAMPLE_BITS > SERIES_PAYLOAD_BYTES * 8 ) ||
+	     ( 0xFFFF == hdr->count ) ) {
+		if ( sample_count ) {
+			if ( !flush() ) {
+				return false;
+			}
+			tail_index++;
+		}
+		start_block( t_ms, v );
+	}
+	else {
+		int64_t delta = t_ms - prev_t;
+		int64_t dod = delta - prev_delta;
+		if ( 0 == dod ) {
+			put( 0, 1 );
+		}
+		else if ( ( dod >= -63 ) && ( dod <= 64 ) ) {
+			put( 0x2, 2 );
+			put( (uint64_t) ( dod + 63 ), 7 );
+		}
+		else if ( ( dod >= -255 ) && ( dod <= 256 ) ) {
+			put( 0x6, 3 );
+			put( (uint64_t) ( dod + 255 ), 9 );
+		}
+		else if ( ( dod >= -2047 ) && ( dod <= 2048 ) ) {
+			put( 0xE, 4 );
+			put( (uint64_t) ( dod + 2047 ), 12 );
+		}
+		else if ( ( dod >= INT32_MIN ) && ( dod <= INT32_MAX ) ) {
+			put( 0x1E, 5 );
+			put( (uint32_t) (int32_t) dod, 32 );
+		}
+		else {
+			put( 0x1F, 5 );
+			put( (uint64_t) dod, 64 );
+		}
+		prev_delta = delta;
+
+		uint64_t bits = double_bits( v );
+		uint64_t x = bits ^ prev_value;
+		if ( !x ) {
+			put( 0, 1 );
+		}
+		else {
+			unsigned xl = (unsigned) __builtin_clzll( x );
+			unsigned xt = (unsigned) __builtin_ctzll( x );
+			if ( xl > 31 ) {
+				xl = 31;
+			}
+			if ( ( SERIES_NO_WINDOW != lead ) && ( xl >= lead ) && ( xt >= trail ) ) {
+				put( 0x2, 2 );
+				put( x >> trail, 64 - lead - trail );
+			}
+			else {
+				unsigned len = 64 - xl - xt;
+				put( 0x3, 2 );
+				put( xl, 5 );
+				put( len - 1, 6 );
+				put( x >> xt, len );
+				lead = (uint8_t) xl;
+				trail = (uint8_t) xt;
+			}
+		}
+		prev_value = bits;
+
+		hdr->count++;
+		hdr->t_last = t_ms;
+		if ( v < hdr->min ) {
+			hdr->min = v;
+		}
+		if ( v > hdr->max ) {
+			hdr->max = v;
+		}
+		hdr->sum += v;
+	}
+	prev_t = t_ms;
+	sample_count++;
+	tail_dirty = true;
+	return true;
+}
+
+/**
+ * @brief      count / min / max / sum over from <= t <= to.  Blocks wholly
+ *             inside the range are taken from their headers.
+ */
+bool SeriesFile::summary( int64_t from, int64_t to, SERIES_SUMMARY_T *out ) {
+	memset( out, 0, sizeof( *out ) );
+	if ( !map() ) {
+		return false;
+	}
+	auto add = [out]( double mn, double mx, double sum, uint64_t count ) {
+		if ( !out->count || ( mn < out->min ) ) {
+			out->min = mn;
+		}
+		if ( !out->count || ( mx > out->max ) ) {
+			out->max = mx;
+		}
+		out->sum += sum;
+		out->count += count;
+	};
+	for ( size_t b = 0; b < map_blocks; b++ ) {
+		SERIES_BLOCK_HDR_T hdr;
+		const uint8_t *blk = block( b, &hdr );
+		if ( !blk ) {
+			break;
+		}
+		if ( hdr.t_last < from ) {
+			continue;
+		}
+		if ( hdr.t_first > to ) {
+			break;
+		}
+		if ( ( hdr.t_first >= from ) && ( hdr.t_last <= to ) ) {
+			add( hdr.min, hdr.max, hdr.sum, hdr.count );
+			out->blocks_read++;
+			continue;
+		}
+		SeriesBlockDecoder dec( hdr, blk + sizeof( hdr ) );
+		int64_t t;
+		double v;
+		while ( dec.next( &t, &v ) && ( t <= to ) ) {
+			if ( t >= from ) {
+				add( v, v, v, 1 );
+			}
+		}
+		out->blocks_decoded++;
+	}
+	return true;
+}
+
+/**
+ * @brief      Maps the file as it is now, flushing the block being filled
+ *             first so reads see every sample appended.
+ */
+bool SeriesFile::map( void ) {
+	if ( fd < 0 ) {
+		return false;
+	}
+	if ( !flush() ) {
+		return false;
+	}
+	size_t len = (size_t) file_bytes();
+	if ( map_base && ( len == map_len ) ) {
+		return true;
+	}
+	unmap();
+	if ( len < SERIES_FILE_HDR_LEN ) {
+		return false;
+	}
+	void *p = mmap( 0, len, PROT_READ, MAP_SHARED, fd, 0 );
+	if ( MAP_FAILED == p ) {
+		return false;
+	}
+	map_base = (const uint8_t *) p;
+	map_len = len;
+	map_blocks = ( len - SERIES_FILE_HDR_LEN ) / SERIES_BLOCK_BYTES;
+	return true;
+}
+
+void SeriesFile::unmap( void ) {
+	if ( map_base ) {
+		munmap( (void *) map_base, map_len );
+	}
+	map_base = 0;
+	map_len = 0;
+	map_blocks = 0;
+}
+
+/**
+ * @brief      Block b of the mapping and a copy of its header.
+ *
+ * @return     0 if the block is not there or not written.
+ */
+const uint8_t *SeriesFile::block( size_t b, SERIES_BLOCK_HDR_T *hdr ) const {
+	if ( b >= map_blocks ) {
+		return 0;
+	}
+	const uint8_t *p = map_base + SERIES_FILE_HDR_LEN + b * SERIES_BLOCK_BYTES;
+	memcpy( hdr, p, sizeof( *hdr ) );
+	if ( ( SERIES_BLOCK_MAGIC != hdr->magic ) || !hdr->count ||
+	     ( hdr->bits > SERIES_PAYLOAD_BYTES * 8 ) ) {
+		return 0;
+	}
+	return p;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,184 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file series_store.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Append-only compressed store for one column of station history
+ *             - a time series of (ms timestamp, value) pairs in one file.
+ *
+ * @details    The file is a 64 byte header followed by fixed size blocks.
+ *             Each block starts with a SERIES_BLOCK_HDR_T giving the time
+ *             range and the count, min, max and sum of its samples, then a
+ *             bit stream compressed the Gorilla way:
+ *
+ *             - timestamps as the delta of the delta from the previous
+ *               sample, so a steady 1 s or 60 s cadence costs one bit;
+ *             - values as the XOR with the previous value, sending only the
+ *               bits that changed, so a repeated reading costs one bit and
+ *               the float a driver returned (widened to double) a few bytes.
+ *
+ *             The first sample of a block is kept whole in the header, so
+ *             each block decodes on its own.  The last block is held in
+ *             memory while it fills and rewritten in place by flush(); only
+ *             flushed samples are on disk.  Reads map the file and skip
+ *             blocks by their headers - summary() answers from the headers
+ *             alone for every block wholly inside the range.
+ *
+ *             Timestamps must strictly increase and values must be finite;
+ *             append() refuses anything else.  Host byte order - the files
+ *             are not meant to move between machines.
+ */
+
+#ifndef SERIES_STORE_H
+#define SERIES_STORE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define SERIES_FILE_MAGIC           "WSSERIES"
+#define SERIES_FILE_VERSION         (1)
+#define SERIES_FILE_HDR_LEN         (64)
+#define SERIES_BLOCK_MAGIC          (0x4B4C4253UL)     /* "SBLK" */
+#define SERIES_BLOCK_BYTES          (4096)
+
+typedef struct SERIES_BLOCK_HDR {
+	uint32_t magic;
+	uint16_t count;
+	uint16_t reserved;
+	uint32_t bits;          /* of the bit stream in use */
+	uint32_t pad;
+	int64_t t_first;
+	int64_t t_last;
+	double v_first;
+	double min;
+	double max;
+	double sum;
+} SERIES_BLOCK_HDR_T;
+
+#define SERIES_PAYLOAD_BYTES        (SERIES_BLOCK_BYTES - sizeof( SERIES_BLOCK_HDR_T ))
+
+/** @brief count / min / max / sum of the samples in a time range. */
+typedef struct SERIES_SUMMARY {
+	uint64_t count;
+	double min;
+	double max;
+	double sum;
+	uint32_t blocks_read;       /* from their headers only */
+	uint32_t blocks_decoded;
+} SERIES_SUMMARY_T;
+
+/**
+ * @brief      Walks the samples of one block in order.
+ */
+class SeriesBlockDecoder {
+public:
+	SeriesBlockDecoder( const SERIES_BLOCK_HDR_T &hdr, const uint8_t *payload );
+	bool next( int64_t *t, double *v );
+
+private:
+	friend class SeriesFile;
+	const uint8_t *data;
+	uint32_t bits;
+	uint32_t pos;
+	uint32_t left;
+	int64_t t;
+	int64_t delta;
+	uint64_t value;
+	uint8_t lead;
+	uint8_t trail;
+	bool first;
+
+	uint64_t get( unsigned n );
+};
+
+class SeriesFile {
+public:
+	SeriesFile();
+	~SeriesFile();
+
+	bool open( const std::string &path, bool writable );
+	bool append( int64_t t_ms, double v );
+	bool flush( void );
+	void close( void );
+
+	uint64_t samples( void ) const { return sample_count; }
+	uint64_t file_bytes( void ) const;
+	int64_t last_time( void ) const { return prev_t; }
+
+	/**
+	 * @brief      Calls fn( t_ms, value ) for every flushed sample with
+	 *             from <= t_ms <= to, in time order.
+	 *
+	 * @return     the number of samples passed to fn.
+	 */
+	template<typename Fn>
+	uint64_t scan( int64_t from, int64_t to, Fn &&fn ) {
+		uint64_t n = 0;
+		if ( !map() ) {
+			return 0;
+		}
+		for ( size_t b = 0; b < map_blocks; b++ ) {
+			SERIES_BLOCK_HDR_T hdr;
+			const uint8_t *blk = block( b, &hdr );
+			if ( !blk ) {
+				break;
+			}
+			if ( hdr.t_last < from ) {
+				continue;
+			}
+			if ( hdr.t_first > to ) {
+				break;
+			}
+			SeriesBlockDecoder dec( hdr, blk + sizeof( hdr ) );
+			int64_t t;
+			double v;
+			while ( dec.next( &t, &v ) && ( t <= to ) ) {
+				if ( t >= from ) {
+					fn( t, v );
+					n++;
+				}
+			}
+		}
+		return n;
+	}
+
+	bool summary( int64_t from, int64_t to, SERIES_SUMMARY_T *out );
+
+private:
+	std::string path;
+	int fd;
+	bool writable;
+	uint64_t sample_count;
+
+	/* the block being filled */
+	uint64_t tail_index;
+	uint8_t tail[SERIES_BLOCK_BYTES];
+	bool tail_dirty;
+	int64_t prev_t;
+	int64_t prev_delta;
+	uint64_t prev_value;
+	uint8_t lead;
+	uint8_t trail;
+
+	/* read mapping */
+	const uint8_t *map_base;
+	size_t map_len;
+	size_t map_blocks;
+
+	SERIES_BLOCK_HDR_T *tail_hdr( void ) { return (SERIES_BLOCK_HDR_T *) tail; }
+	void start_block( int64_t t, double v );
+	void put( uint64_t value, unsigned n );
+	bool load_tail( void );
+	bool map( void );
+	void unmap( void );
+	const uint8_t *block( size_t b, SERIES_BLOCK_HDR_T *hdr ) const;
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,141 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file sim.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Virtual board used by the host build.  Owns the simulated
+ *             clock, the interrupt controller, the ADC inputs, the I2C bus
+ *             and the environment the simulated sensors measure.
+ *
+ * @details    Time only moves when firmware code spends it: delay(), bus
+ *             transfers, serial output, ADC conversions and a small cycle
+ *             charge for the core calls.  Pulse sources (anemometer, rain
+ *             gauge) are scheduled on the same clock and delivered through
+ *             the handlers registered with attachInterrupt().  While
+ *             interrupts are masked an edge is latched exactly like the AVR
+ *             INTx flag - further edges before the flag is serviced are lost.
+ *             sleep_cpu() skips ahead to the next timer0 overflow or edge.
+ */
+
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace sim {
+
+/** @brief Counters accumulated over a simulation run. */
+struct Stats {
+	uint64_t i2c_transactions;  /* START to STOP */
+	uint64_t i2c_messages;      /* address phases, including repeated STARTs */
+	uint64_t i2c_bytes;
+	uint64_t i2c_nacks;
+	uint64_t i2c_ns;
+	uint64_t i2c_stretch_ns;
+	uint64_t delay_ns;
+	uint64_t serial_bytes;
+	uint64_t serial_block_ns;
+	uint64_t adc_reads;
+	uint64_t adc_ns;
+	uint64_t irq_edges;
+	uint64_t irq_serviced;
+	uint64_t irq_lost;
+	uint64_t irq_masked_ns;
+	uint64_t eeprom_reads;
+	uint64_t eeprom_writes;     /* bytes actually programmed */
+	uint64_t eeprom_wait_ns;    /* callers held up by a write in progress */
+	uint64_t sleeps;            /* sleep_cpu() calls that slept */
+	uint64_t sleep_ns;          /* time the core spent asleep */
+	uint32_t i2c_transactions_by_addr[128];
+};
+
+/** @brief Physical quantities the simulated sensors measure. */
+struct Environment {
+	double temp_c;
+	double humidity_pct;
+	double pressure_pa;
+};
+
+/**
+ * @brief      A slave on the simulated I2C bus.
+ */
+class I2CDevice {
+public:
+	explicit I2CDevice( uint8_t address ) : addr( address ) {}
+	virtual ~I2CDevice() {}
+	uint8_t address( void ) const { return addr; }
+
+	/**
+	 * @brief      Master wrote a frame (register pointer and/or data).
+	 *
+	 * @return     false to NACK the frame.
+	 */
+	virtual bool on_write( const uint8_t *data, size_t len ) = 0;
+
+	/**
+	 * @brief      Master requested up to len bytes.
+	 *
+	 * @param[out] stretch_ns  time the slave holds SCL low before the data.
+	 *
+	 * @return     number of bytes supplied, 0 to NACK the address.
+	 */
+	virtual size_t on_read( uint8_t *data, size_t len, uint64_t *stretch_ns ) = 0;
+
+	/**
+	 * @brief      The clock moved on - run whatever the device does on its
+	 *             own by now, so it measures the environment as it stood.
+	 */
+	virtual void on_advance( void ) {}
+private:
+	uint8_t addr;
+};
+
+/* clock */
+uint64_t now_ns( void );
+void advance_ns( uint64_t ns );
+void charge_cycles( uint32_t cycles );
+
+/* statistics */
+Stats &stats( void );
+void reset_stats( void );
+
+/* interrupt controller */
+bool interrupts_enabled( void );
+void set_interrupts_enabled( bool enabled );
+void attach_isr( uint8_t irq, void (*isr)( void ) );
+void set_pulse_rate( uint8_t pin, double hz );
+void inject_pulse( uint8_t pin, uint64_t at_ns );
+
+/* analog inputs */
+void set_analog( uint8_t pin, uint16_t value );
+uint16_t analog_value( uint8_t pin );
+
+/* I2C bus */
+void attach_i2c( I2CDevice *dev );
+I2CDevice *find_i2c( uint8_t address );
+void advance_i2c( void );
+void set_i2c_clock( uint32_t hz );
+uint64_t i2c_bit_ns( void );
+
+/* environment */
+Environment &env( void );
+
+/* serial */
+void set_serial_echo( bool echo );
+void serial_input( const uint8_t *data, size_t len );
+
+/* EEPROM */
+bool eeprom_attach_file( const char *path );
+void eeprom_erase( void );
+void eeprom_brownout( uint8_t garbage );
+uint32_t eeprom_wear( uint16_t addr );
+
+}
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,559 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file sim_core.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Virtual clock, interrupt controller and the Arduino core calls
+ *             (timing, pins, ADC, Print/Serial, sleep) for the host build.
+ */
+
+#include <stdio.h>
+#include <deque>
+#include <map>
+
+#include "Arduino.h"
+#include "avr/sleep.h"
+#include "sim.h"
+
+/*-----------------------------------------*/
+/* Private declarations  */
+
+/* approximate AVR cycle cost of the core calls */
+#define SIM_CYCLES_MILLIS           (20)
+#define SIM_CYCLES_MICROS           (40)
+#define SIM_CYCLES_ISR_OVERHEAD     (60)
+#define SIM_CYCLES_SERIAL_WRITE     (50)
+#define SIM_CYCLES_PIN_IO           (50)
+
+/* 13 ADC clocks at 125 kHz plus the analogRead() call */
+#define SIM_ADC_CONVERSION_NS       (112000ULL)
+
+/* timer0 overflows every 64 x 256 cycles, waking an idle core */
+#define SIM_TIMER0_OVERFLOW_NS      ( 64ULL * 256ULL * 1000000000ULL / F_CPU )
+
+#define SIM_NUM_IRQS                (2)
+#define SIM_SERIAL_TX_BUFFER        (64)
+
+namespace {
+
+struct PulseSource {
+	uint64_t period_ns;
+	uint64_t next_ns;
+};
+
+uint64_t clock_ns = 0;
+bool irq_enabled = true;
+uint64_t irq_masked_at_ns = 0;
+bool in_isr = false;
+/* clock when enabling interrupts last ran a latched ISR - a sleep_cpu()
+   straight after wakes at once, like the AVR taking it after the SLEEP */
+uint64_t isr_on_unmask_ns = ~0ULL;
+bool sleep_enabled = false;
+bool irq_pending[SIM_NUM_IRQS];
+void (*irq_handler[SIM_NUM_IRQS])( void );
+PulseSource pulse_src[NUM_DIGITAL_PINS];
+std::multimap<uint64_t, uint8_t> one_shot_pulses;
+uint16_t analog_in[8];
+sim::Stats run_stats;
+sim::Environment environment = { 20.0, 50.0, 101325.0 };
+bool serial_echo = true;
+std::deque<uint8_t> serial_rx;
+
+int pin_to_irq( uint8_t pin ) {
+	return digitalPinToInterrupt( pin );
+}
+
+void service_pending( void );
+
+void run_isr( int irq ) {
+	irq_pending[irq] = false;
+	in_isr = true;
+	run_stats.irq_serviced++;
+	sim::charge_cycles( SIM_CYCLES_ISR_OVERHEAD );
+	irq_handler[irq]();
+	in_isr = false;
+	/* edges latched while the handler ran are serviced on return */
+	service_pending();
+}
+
+void service_pending( void ) {
+	for ( int irq = 0; irq < SIM_NUM_IRQS; irq++ ) {
+		if ( irq_pending[irq] && irq_enabled && !in_isr ) {
+			run_isr( irq );
+		}
+	}
+}
+
+void raise_edge( uint8_t pin ) {
+	int irq = pin_to_irq( pin );
+	if ( ( irq < 0 ) || ( 0 == irq_handler[irq] ) ) {
+		return;
+	}
+	run_stats.irq_edges++;
+	if ( irq_pending[irq] ) {
+		/* the INTx flag is already set - this edge is gone */
+		run_stats.irq_lost++;
+		return;
+	}
+	irq_pending[irq] = true;
+	if ( irq_enabled && !in_isr ) {
+		run_isr( irq );
+	}
+}
+
+/**
+ * @brief      Finds the earliest pulse due at or before the limit.
+ *
+ * @return     pin number, or -1 if nothing is due.
+ */
+int next_pulse( uint64_t limit, uint64_t *at ) {
+	int pin = -1;
+	uint64_t best = limit;
+	for ( uint8_t i = 0; i < NUM_DIGITAL_PINS; i++ ) {
+		if ( pulse_src[i].period_ns && pulse_src[i].next_ns <= best ) {
+			best = pulse_src[i].next_ns;
+			pin = i;
+		}
+	}
+	if ( !one_shot_pulses.empty() && one_shot_pulses.begin()->first <= best ) {
+		best = one_shot_pulses.begin()->first;
+		pin = NUM_DIGITAL_PINS + one_shot_pulses.begin()->second;
+	}
+	*at = best;
+	return pin;
+}
+
+}
+
+namespace sim {
+
+uint64_t now_ns( void ) {
+	return clock_ns;
+}
+
+/**
+ * @brief      Moves the virtual clock forward, delivering every pulse edge
+ *             that falls inside the interval in time order.
+ */
+void advance_ns( uint64_t ns ) {
+	uint64_t target = clock_ns + ns;
+	uint64_t at;
+	int src;
+
+	while ( 0 <= ( src = next_pulse( target, &at ) ) ) {
+		uint8_t pin;
+		if ( src >= NUM_DIGITAL_PINS ) {
+			pin = (uint8_t) ( src - NUM_DIGITAL_PINS );
+			one_shot_pulses.erase( one_shot_pulses.begin() );
+		}
+		else {
+			pin = (uint8_t) src;
+			pulse_src[pin].next_ns += pulse_src[pin].period_ns;
+		}
+		if ( at > clock_ns ) {
+			clock_ns = at;
+		}
+		raise_edge( pin );
+		/* an ISR may have spent time past the original target */
+		if ( clock_ns > target ) {
+			target = clock_ns;
+		}
+	}
+	clock_ns = target;
+	advance_i2c();
+}
+
+void charge_cycles( uint32_t cycles ) {
+	advance_ns( ( (uint64_t) cycles * 1000000000ULL ) / F_CPU );
+}
+
+Stats &stats( void ) {
+	return run_stats;
+}
+
+void reset_stats( void ) {
+	memset( &run_stats, 0, sizeof( run_stats ) );
+}
+
+bool interrupts_enabled( void ) {
+	return irq_enabled;
+}
+
+void set_interrupts_enabled( bool enabled ) {
+	if ( irq_enabled && !enabled ) {
+		irq_masked_at_ns = clock_ns;
+	}
+	else if ( !irq_enabled && enabled ) {
+		run_stats.irq_masked_ns += clock_ns - irq_masked_at_ns;
+	}
+	irq_enabled = enabled;
+	if ( enabled ) {
+		uint64_t serviced = run_stats.irq_serviced;
+		service_pending();
+		if ( run_stats.irq_serviced != serviced ) {
+			isr_on_unmask_ns = clock_ns;
+		}
+	}
+}
+
+void attach_isr( uint8_t irq, void (*isr)( void ) ) {
+	if ( irq < SIM_NUM_IRQS ) {
+		irq_handler[irq] = isr;
+		irq_pending[irq] = false;
+	}
+}
+
+/**
+ * @brief      Generates a periodic falling edge on a pin, 0 Hz turns the
+ *             source off.
+ */
+void set_pulse_rate( uint8_t pin, double hz ) {
+	if ( pin >= NUM_DIGITAL_PINS ) {
+		return;
+	}
+	if ( hz <= 0.0 ) {
+		pulse_src[pin].period_ns = 0;
+	}
+	else {
+		pulse_src[pin].period_ns = (uint64_t) ( 1e9 / hz );
+		pulse_src[pin].next_ns = clock_ns + pulse_src[pin].period_ns;
+	}
+}
+
+void inject_pulse( uint8_t pin, uint64_t at_ns ) {
+	one_shot_pulses.insert( std::make_pair( at_ns, pin ) );
+}
+
+void set_analog( uint8_t pin, uint16_t value ) {
+	if ( pin >= A0 ) {
+		pin -= A0;
+	}
+	if ( pin < 8 ) {
+		analog_in[pin] = value & 0x3FF;
+	}
+}
+
+uint16_t analog_value( uint8_t pin ) {
+	if ( pin >= A0 ) {
+		pin -= A0;
+	}
+	return ( pin < 8 ) ? analog_in[pin] : 0;
+}
+
+Environment &env( void ) {
+	return environment;
+}
+
+void set_serial_echo( bool echo ) {
+	serial_echo = echo;
+}
+
+/**
+ * @brief      Queues bytes for the sketch to read from Serial.
+ */
+void serial_input( const uint8_t *data, size_t len ) {
+	serial_rx.insert( serial_rx.end(), data, data + len );
+}
+
+}
+
+/*-----------------------------------------*/
+/* Arduino core */
+
+unsigned long millis( void ) {
+	sim::charge_cycles( SIM_CYCLES_MILLIS );
+	/* unsigned long is 32 bits on the AVR, keep the same wrap point */
+	return (uint32_t) ( clock_ns / 1000000ULL );
+}
+
+unsigned long micros( void ) {
+	sim::charge_cycles( SIM_CYCLES_MICROS );
+	return (uint32_t) ( clock_ns / 1000ULL );
+}
+
+void delay( unsigned long ms ) {
+	uint64_t ns = (uint64_t) ms * 1000000ULL;
+	run_stats.delay_ns += ns;
+	sim::advance_ns( ns );
+}
+
+void delayMicroseconds( unsigned int us ) {
+	uint64_t ns = (uint64_t) us * 1000ULL;
+	run_stats.delay_ns += ns;
+	sim::advance_ns( ns );
+}
+
+void pinMode( uint8_t pin, uint8_t mode ) {
+	(void) pin;
+	(void) mode;
+	sim::charge_cycles( SIM_CYCLES_PIN_IO );
+}
+
+void digitalWrite( uint8_t pin, uint8_t value ) {
+	(void) pin;
+	(void) value;
+	sim::charge_cycles( SIM_CYCLES_PIN_IO );
+}
+
+int digitalRead( uint8_t pin ) {
+	(void) pin;
+	sim::charge_cycles( SIM_CYCLES_PIN_IO );
+	return HIGH;
+}
+
+int analogRead( uint8_t pin ) {
+	run_stats.adc_reads++;
+	run_stats.adc_ns += SIM_ADC_CONVERSION_NS;
+	sim::advance_ns( SIM_ADC_CONVERSION_NS );
+	return sim::analog_value( pin );
+}
+
+void attachInterrupt( uint8_t irq, void (*isr)( void ), int mode ) {
+	(void) mode;
+	sim::attach_isr( irq, isr );
+}
+
+void detachInterrupt( uint8_t irq ) {
+	sim::attach_isr( irq, 0 );
+}
+
+void interrupts( void ) {
+	sim::set_interrupts_enabled( true );
+}
+
+void noInterrupts( void ) {
+	sim::set_interrupts_enabled( false );
+}
+
+/*-----------------------------------------*/
+/* Print */
+
+size_t Print::write( const uint8_t *buf, size_t len ) {
+	size_t n = 0;
+	while ( len-- ) {
+		n += write( *buf++ );
+	}
+	return n;
+}
+
+size_t Print::write( const char *str ) {
+	return ( 0 == str ) ? 0 : write( (const uint8_t *) str, strlen( str ) );
+}
+
+size_t Print::print( const __FlashStringHelper *str ) { return write( reinterpret_cast<const char *>( str ) ); }
+size_t Print::print( const char *str ) { return write( str ); }
+size_t Print::print( char c ) { return write( (uint8_t) c ); }
+size_t Print::print( unsigned char n, int base ) { return print( (unsigned long) n, base ); }
+size_t Print::print( int n, int base ) { return print( (long) n, base ); }
+size_t Print::print( unsigned int n, int base ) { return print( (unsigned long) n, base ); }
+
+size_t Print::print( long n, int base ) {
+	/* mimic the 32 bit AVR long */
+	int32_t v = (int32_t) n;
+	if ( base == 0 ) {
+		return write( (uint8_t) v );
+	}
+	if ( ( base == 10 ) && ( v < 0 ) ) {
+		size_t t = print( '-' );
+		return t + print_number( (uint32_t) ( -(int64_t) v ), 10 );
+	}
+	return print_number( (uint32_t) v, (uint8_t) base );
+}
+
+size_t Print::print( unsigned long n, int base ) {
+	if ( base == 0 ) {
+		return write( (uint8_t) n );
+	}
+	return print_number( (uint32_t) n, (uint8_t) base );
+}
+
+size_t Print::print( double n, int digits ) {
+	return print_float( n, (uint8_t) digits );
+}
+
+size_t Print::println( void ) { return write( "\r\n" ); }
+size_t Print::println( const __FlashStringHelper *str ) { size_t n = print( str ); return n + println(); }
+size_t Print::println( const char *str ) { size_t n = print( str ); return n + println(); }
+size_t Print::println( char c ) { size_t n = print( c ); return n + println(); }
+size_t Print::println( unsigned char b, int base ) { size_t n = print( b, base ); return n + println(); }
+size_t Print::println( int num, int base ) { size_t n = print( num, base ); return n + println(); }
+size_t Print::println( unsigned int num, int base ) { size_t n = print( num, base ); return n + println(); }
+size_t Print::println( long num, int base ) { size_t n = print( num, base ); return n + println(); }
+size_t Print::println( unsigned long num, int base ) { size_t n = print( num, base ); return n + println(); }
+size_t Print::println( double num, int digits ) { size_t n = print( num, digits ); return n + println(); }
+
+size_t Print::print_number( unsigned long n, uint8_t base ) {
+	char buf[8 * sizeof( long ) + 1];
+	char *str = &buf[sizeof( buf ) - 1];
+
+	*str = '\0';
+	if ( base < 2 ) {
+		base = 10;
+	}
+	do {
+		char c = (char) ( n % base );
+		n /= base;
+		*--str = c < 10 ? c + '0' : c + 'A' - 10;
+	} while ( n );
+
+	return write( str );
+}
+
+size_t Print::print_float( double number, uint8_t digits ) {
+	size_t n = 0;
+
+	if ( isnan( number ) ) return print( "nan" );
+	if ( isinf( number ) ) return print( "inf" );
+	if ( number > 4294967040.0 ) return print( "ovf" );
+	if ( number < -4294967040.0 ) return print( "ovf" );
+
+	if ( number < 0.0 ) {
+		n += print( '-' );
+		number = -number;
+	}
+
+	double rounding = 0.5;
+	for ( uint8_t i = 0; i < digits; ++i ) {
+		rounding /= 10.0;
+	}
+	number += rounding;
+
+	unsigned long int_part = (unsigned long) number;
+	double remainder = number - (double) int_part;
+	n += print( int_part );
+
+	if ( digits > 0 ) {
+		n += print( '.' );
+	}
+	while ( digits-- > 0 ) {
+		remainder *= 10.0;
+		unsigned int to_print = (unsigned int) remainder;
+		n += print( to_print );
+		remainder -= to_print;
+	}
+	return n;
+}
+
+/*-----------------------------------------*/
+/* HardwareSerial */
+
+HardwareSerial Serial;
+
+HardwareSerial::HardwareSerial() {
+	baud_rate = 9600;
+	tx_queue_end_ns = 0;
+}
+
+void HardwareSerial::begin( unsigned long baud ) {
+	baud_rate = baud;
+}
+
+void HardwareSerial::end( void ) {
+}
+
+int HardwareSerial::available( void ) {
+	return (int) serial_rx.size();
+}
+
+int HardwareSerial::read( void ) {
+	sim::charge_cycles( SIM_CYCLES_SERIAL_WRITE );
+	if ( serial_rx.empty() ) {
+		return -1;
+	}
+	uint8_t c = serial_rx.front();
+	serial_rx.pop_front();
+	return c;
+}
+
+/**
+ * @brief      Free space in the transmit buffer - bytes that can be written
+ *             without blocking.
+ */
+int HardwareSerial::availableForWrite( void ) {
+	const uint64_t byte_ns = 10000000000ULL / baud_rate;
+	uint64_t now = sim::now_ns();
+	uint64_t queued = ( tx_queue_end_ns > now ) ? ( tx_queue_end_ns - now + byte_ns - 1 ) / byte_ns : 0;
+	return ( queued >= SIM_SERIAL_TX_BUFFER ) ? 0 : (int) ( SIM_SERIAL_TX_BUFFER - queued );
+}
+
+void HardwareSerial::flush( void ) {
+	uint64_t now = sim::now_ns();
+	if ( tx_queue_end_ns > now ) {
+		run_stats.serial_block_ns += tx_queue_end_ns - now;
+		sim::advance_ns( tx_queue_end_ns - now );
+	}
+	fflush( stdout );
+}
+
+/**
+ * @brief      Queues one byte.  Each byte occupies 10 bit times (start, 8
+ *             data, stop) on the wire; once 64 bytes are outstanding the
+ *             caller waits for the oldest one to drain.
+ */
+size_t HardwareSerial::write( uint8_t c ) {
+	const uint64_t byte_ns = 10000000000ULL / baud_rate;
+	const uint64_t max_backlog = SIM_SERIAL_TX_BUFFER * byte_ns;
+
+	sim::charge_cycles( SIM_CYCLES_SERIAL_WRITE );
+	uint64_t now = sim::now_ns();
+	if ( tx_queue_end_ns < now ) {
+		tx_queue_end_ns = now;
+	}
+	if ( ( tx_queue_end_ns - now ) >= max_backlog ) {
+		uint64_t wait = tx_queue_end_ns - now - max_backlog + byte_ns;
+		run_stats.serial_block_ns += wait;
+		sim::advance_ns( wait );
+	}
+	tx_queue_end_ns += byte_ns;
+	run_stats.serial_bytes++;
+
+	if ( serial_echo ) {
+		/* byte for byte - the stream may be binary telemetry */
+		putchar( c );
+	}
+	return 1;
+}
+
+/*-----------------------------------------*/
+/* avr/sleep.h */
+
+void set_sleep_mode( uint8_t mode ) {
+	(void) mode;
+}
+
+void sleep_enable( void ) {
+	sleep_enabled = true;
+}
+
+void sleep_disable( void ) {
+	sleep_enabled = false;
+}
+
+/**
+ * @brief      Idles until the next timer0 overflow or pulse edge and runs
+ *             the ISR that woke the core.  Like the AVR, does nothing unless
+ *             sleep_enable() was called.
+ */
+void sleep_cpu( void ) {
+	if ( !sleep_enabled || ( isr_on_unmask_ns == clock_ns ) ) {
+		return;
+	}
+	uint64_t wake = ( clock_ns / SIM_TIMER0_OVERFLOW_NS + 1 ) * SIM_TIMER0_OVERFLOW_NS;
+	uint64_t at;
+	bool edge = ( 0 <= next_pulse( wake, &at ) );
+	if ( edge ) {
+		wake = at;
+	}
+	run_stats.sleeps++;
+	run_stats.sleep_ns += wake - clock_ns;
+	/* delivers the edge, whose ISR charges itself */
+	sim::advance_ns( wake - clock_ns );
+	if ( !edge ) {
+		sim::charge_cycles( SIM_CYCLES_ISR_OVERHEAD );
+	}
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,193 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file sim_eeprom.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      The ATmega328P's 1 KB data EEPROM.
+ *
+ * @details    A byte write takes SIM_EEPROM_WRITE_NS in the background; any
+ *             access before it finishes waits for it, as the avr-libc
+ *             routines spin on EEPE.  Each programmed cell is counted for
+ *             wear.  The contents can be backed by a file that is written
+ *             through on every byte, so a log survives from one run to the
+ *             next.  A reset lets a write in progress finish, as on the part;
+ *             eeprom_brownout() models the supply collapsing mid-write
+ *             instead, which leaves the cell being programmed holding
+ *             garbage.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "sim.h"
+
+/*-----------------------------------------*/
+/* Private declarations  */
+
+#define SIM_EEPROM_SIZE             ( E2END + 1 )
+
+/* tWD_EEPROM, ATmega328P datasheet table 28-18 */
+#define SIM_EEPROM_WRITE_NS         (3400000ULL)
+
+/* the 4 cycle CPU halt of an EEPROM read plus the library call */
+#define SIM_CYCLES_EEPROM_READ      (16)
+#define SIM_CYCLES_EEPROM_WRITE     (20)
+
+namespace {
+
+uint8_t cells[SIM_EEPROM_SIZE];
+uint32_t wear[SIM_EEPROM_SIZE];
+bool loaded = false;
+uint64_t busy_until_ns = 0;
+int busy_addr = -1;
+FILE *backing = 0;
+
+void load( void ) {
+	if ( !loaded ) {
+		memset( cells, 0xFF, sizeof( cells ) );
+		loaded = true;
+	}
+}
+
+void wait_ready( void ) {
+	load();
+	uint64_t now = sim::now_ns();
+	if ( busy_until_ns > now ) {
+		sim::stats().eeprom_wait_ns += busy_until_ns - now;
+		sim::advance_ns( busy_until_ns - now );
+	}
+	busy_addr = -1;
+}
+
+void store( uint16_t addr ) {
+	if ( backing ) {
+		fseek( backing, addr, SEEK_SET );
+		fputc( cells[addr], backing );
+		fflush( backing );
+	}
+}
+
+uint16_t index_of( const uint8_t *addr ) {
+	return (uint16_t) ( (uintptr_t) addr % SIM_EEPROM_SIZE );
+}
+
+}
+
+EEPROMClass EEPROM;
+
+namespace sim {
+
+/**
+ * @brief      Backs the EEPROM with a file, loading it if it exists and
+ *             creating it erased if not.
+ *
+ * @return     false if the file cannot be opened.
+ */
+bool eeprom_attach_file( const char *path ) {
+	if ( backing ) {
+		fclose( backing );
+		backing = 0;
+	}
+	memset( cells, 0xFF, sizeof( cells ) );
+	loaded = true;
+	busy_until_ns = 0;
+	busy_addr = -1;
+
+	backing = fopen( path, "r+b" );
+	if ( backing ) {
+		size_t n = fread( cells, 1, sizeof( cells ), backing );
+		(void) n;
+	}
+	else {
+		backing = fopen( path, "w+b" );
+		if ( !backing ) {
+			return false;
+		}
+	}
+	/* short or new file - fill it out erased */
+	fseek( backing, 0, SEEK_SET );
+	fwrite( cells, 1, sizeof( cells ), backing );
+	fflush( backing );
+	return true;
+}
+
+/**
+ * @brief      Sets every cell to 0xFF, as shipped.  Wear counts are kept.
+ */
+void eeprom_erase( void ) {
+	memset( cells, 0xFF, sizeof( cells ) );
+	loaded = true;
+	busy_until_ns = 0;
+	busy_addr = -1;
+	if ( backing ) {
+		fseek( backing, 0, SEEK_SET );
+		fwrite( cells, 1, sizeof( cells ), backing );
+		fflush( backing );
+	}
+}
+
+/**
+ * @brief      Loses power mid-write: a byte still being programmed is left
+ *             holding garbage.
+ */
+void eeprom_brownout( uint8_t garbage ) {
+	load();
+	if ( ( busy_addr >= 0 ) && ( busy_until_ns > sim::now_ns() ) ) {
+		cells[busy_addr] = garbage;
+		store( (uint16_t) busy_addr );
+	}
+	busy_until_ns = 0;
+	busy_addr = -1;
+}
+
+/**
+ * @brief      Times a cell has been programmed.
+ */
+uint32_t eeprom_wear( uint16_t addr ) {
+	return ( addr < SIM_EEPROM_SIZE ) ? wear[addr] : 0;
+}
+
+}
+
+/*-----------------------------------------*/
+/* avr-libc */
+
+bool eeprom_is_ready( void ) {
+	return sim::now_ns() >= busy_until_ns;
+}
+
+void eeprom_busy_wait( void ) {
+	wait_ready();
+}
+
+uint8_t eeprom_read_byte( const uint8_t *addr ) {
+	wait_ready();
+	sim::charge_cycles( SIM_CYCLES_EEPROM_READ );
+	sim::stats().eeprom_reads++;
+	return cells[index_of( addr )];
+}
+
+void eeprom_write_byte( uint8_t *addr, uint8_t value ) {
+	wait_ready();
+	sim::charge_cycles( SIM_CYCLES_EEPROM_WRITE );
+	uint16_t i = index_of( addr );
+	cells[i] = value;
+	wear[i]++;
+	store( i );
+	sim::stats().eeprom_writes++;
+	busy_addr = i;
+	busy_until_ns = sim::now_ns() + SIM_EEPROM_WRITE_NS;
+}
+
+void eeprom_update_byte( uint8_t *addr, uint8_t value ) {
+	if ( eeprom_read_byte( addr ) != value ) {
+		eeprom_write_byte( addr, value );
+	}
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,211 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file sim_htu21d.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "sim_htu21d.h"
+
+/*-----------------------------------------*/
+/* Private declarations  */
+
+#define HTU21D_ADDRESS              (0x40)
+
+#define HTU21D_CMD_READTEMP         (0xE3)
+#define HTU21D_CMD_READHUM          (0xE5)
+#define HTU21D_CMD_READTEMP_NHM     (0xF3)
+#define HTU21D_CMD_READHUM_NHM      (0xF5)
+#define HTU21D_CMD_WRITE_USR_REG    (0xE6)
+#define HTU21D_CMD_READ_USR_REG     (0xE7)
+#define HTU21D_CMD_SOFTRESET        (0xFE)
+
+#define HTU21D_USR_REG_DEFAULT      (0x02)
+/* resolution (bits 7,0), heater (bit 2) and OTP reload (bit 1) */
+#define HTU21D_USR_REG_WRITABLE     (0x87)
+
+#define HTU21D_RESET_NS             (15000000ULL)
+
+#define MS_TO_NS(ms)                ((uint64_t)(ms) * 1000000ULL)
+
+SimHTU21D::SimHTU21D() : sim::I2CDevice( HTU21D_ADDRESS ) {
+	user_reg = HTU21D_USR_REG_DEFAULT;
+	pending = NONE;
+	hold_master = false;
+	ready_ns = 0;
+	busy_until_ns = 0;
+	num_conversions = 0;
+}
+
+/**
+ * @brief      Temperature resolution selected by the user register.
+ */
+uint8_t SimHTU21D::temp_bits( uint8_t reg ) {
+	static const uint8_t bits[4] = { 14, 12, 13, 11 };
+	return bits[ ( ( reg >> 6 ) & 0x02 ) | ( reg & 0x01 ) ];
+}
+
+/**
+ * @brief      Humidity resolution selected by the user register.
+ */
+uint8_t SimHTU21D::humidity_bits( uint8_t reg ) {
+	static const uint8_t bits[4] = { 12, 8, 10, 11 };
+	return bits[ ( ( reg >> 6 ) & 0x02 ) | ( reg & 0x01 ) ];
+}
+
+/**
+ * @brief      Maximum conversion time for a measurement at the resolution
+ *             selected by the user register.
+ */
+uint64_t SimHTU21D::conversion_ns( bool humidity, uint8_t reg ) {
+	if ( humidity ) {
+		switch ( humidity_bits( reg ) ) {
+			case 12: return MS_TO_NS( 16 );
+			case 11: return MS_TO_NS( 8 );
+			case 10: return MS_TO_NS( 5 );
+			default: return MS_TO_NS( 3 );
+		}
+	}
+	switch ( temp_bits( reg ) ) {
+		case 14: return MS_TO_NS( 50 );
+		case 13: return MS_TO_NS( 25 );
+		case 12: return MS_TO_NS( 13 );
+		default: return MS_TO_NS( 7 );
+	}
+}
+
+bool SimHTU21D::on_write( const uint8_t *data, size_t len ) {
+	uint64_t now = sim::now_ns();
+
+	if ( ( 0 == len ) || ( now < busy_until_ns ) ) {
+		return ( 0 == len );
+	}
+
+	switch ( data[0] ) {
+		case HTU21D_CMD_SOFTRESET:
+			user_reg = HTU21D_USR_REG_DEFAULT;
+			pending = NONE;
+			busy_until_ns = now + HTU21D_RESET_NS;
+			break;
+		case HTU21D_CMD_READ_USR_REG:
+			pending = READ_USER_REG;
+			break;
+		case HTU21D_CMD_WRITE_USR_REG:
+			if ( len < 2 ) {
+				return false;
+			}
+			user_reg = ( user_reg & ~HTU21D_USR_REG_WRITABLE ) |
+			           ( data[1] & HTU21D_USR_REG_WRITABLE );
+			break;
+		case HTU21D_CMD_READTEMP:
+		case HTU21D_CMD_READTEMP_NHM:
+		case HTU21D_CMD_READHUM:
+		case HTU21D_CMD_READHUM_NHM: {
+			bool humidity = ( data[0] == HTU21D_CMD_READHUM ) ||
+			                ( data[0] == HTU21D_CMD_READHUM_NHM );
+			hold_master = ( data[0] == HTU21D_CMD_READTEMP ) ||
+			              ( data[0] == HTU21D_CMD_READHUM );
+			pending = humidity ? MEASURE_HUM : MEASURE_TEMP;
+			ready_ns = now + conversion_ns( humidity, user_reg );
+			num_conversions++;
+			break;
+		}
+		default:
+			return false;
+	}
+	return true;
+}
+
+size_t SimHTU21D::on_read( uint8_t *data, size_t len, uint64_t *stretch_ns ) {
+	uint64_t now = sim::now_ns();
+	*stretch_ns = 0;
+
+	if ( ( 0 == len ) || ( now < busy_until_ns ) ) {
+		return 0;
+	}
+
+	if ( READ_USER_REG == pending ) {
+		pending = NONE;
+		data[0] = user_reg;
+		return 1;
+	}
+
+	if ( ( MEASURE_TEMP != pending ) && ( MEASURE_HUM != pending ) ) {
+		return 0;
+	}
+
+	if ( now < ready_ns ) {
+		if ( !hold_master ) {
+			/* no hold master - NACK until the conversion is complete */
+			return 0;
+		}
+		*stretch_ns = ready_ns - now;
+	}
+
+	uint8_t frame[3];
+	uint16_t raw = encode( MEASURE_HUM == pending );
+	frame[0] = (uint8_t) ( raw >> 8 );
+	frame[1] = (uint8_t) raw;
+	frame[2] = crc8( frame, 2 );
+	pending = NONE;
+
+	if ( len > 3 ) {
+		len = 3;
+	}
+	for ( size_t i = 0; i < len; i++ ) {
+		data[i] = frame[i];
+	}
+	return len;
+}
+
+/**
+ * @brief      Builds the 16 bit measurement word: the value left aligned at
+ *             the active resolution, the unused low bits zero and bit 1 set
+ *             for a humidity result.
+ */
+uint16_t SimHTU21D::encode( bool humidity ) const {
+	const sim::Environment &e = sim::env();
+	double counts;
+	uint8_t bits;
+
+	if ( humidity ) {
+		counts = ( ( e.humidity_pct + 6.0 ) * 65536.0 ) / 125.0;
+		bits = humidity_bits( user_reg );
+	}
+	else {
+		counts = ( ( e.temp_c + 46.85 ) * 65536.0 ) / 175.72;
+		bits = temp_bits( user_reg );
+	}
+	if ( counts < 0.0 ) {
+		counts = 0.0;
+	}
+	if ( counts > 65535.0 ) {
+		counts = 65535.0;
+	}
+
+	uint16_t raw = (uint16_t) counts;
+	raw &= (uint16_t) ( 0xFFFF << ( 16 - bits ) );
+	raw &= ~0x0003;
+	if ( humidity ) {
+		raw |= 0x0002;
+	}
+	return raw;
+}
+
+/**
+ * @brief      CRC-8, polynomial x^8 + x^5 + x^4 + 1, initial value 0.
+ */
+uint8_t SimHTU21D::crc8( const uint8_t *data, size_t len ) {
+	uint8_t crc = 0;
+	while ( len-- ) {
+		crc ^= *data++;
+		for ( uint8_t i = 0; i < 8; i++ ) {
+			crc = ( crc & 0x80 ) ? (uint8_t) ( ( crc << 1 ) ^ 0x31 ) : (uint8_t) ( crc << 1 );
+		}
+	}
+	return crc;
+}
+
+/** @} end of addtogroup */
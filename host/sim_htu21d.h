@@ -0,0 +1,49 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file sim_htu21d.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Register level model of the HTU21D humidity/temperature sensor.
+ *
+ * @details    Supports the soft reset, user register read/write and both the
+ *             hold master (0xE3/0xE5, SCL is stretched until the conversion
+ *             finishes) and no hold master (0xF3/0xF5, the address is NACKed
+ *             until the conversion finishes) measurement commands.  The
+ *             result is quantized to the resolution selected in the user
+ *             register and carries the status bits and CRC-8 the real part
+ *             sends.  Conversion times are the datasheet maximums.
+ */
+
+#ifndef SIM_HTU21D_H
+#define SIM_HTU21D_H
+
+#include "sim.h"
+
+class SimHTU21D : public sim::I2CDevice {
+public:
+	SimHTU21D();
+	bool on_write( const uint8_t *data, size_t len );
+	size_t on_read( uint8_t *data, size_t len, uint64_t *stretch_ns );
+	uint8_t user_register( void ) const { return user_reg; }
+	uint32_t conversions( void ) const { return num_conversions; }
+	static uint64_t conversion_ns( bool humidity, uint8_t user_reg );
+	static uint8_t temp_bits( uint8_t user_reg );
+	static uint8_t humidity_bits( uint8_t user_reg );
+private:
+	enum Pending { NONE, READ_USER_REG, MEASURE_TEMP, MEASURE_HUM };
+	uint16_t encode( bool humidity ) const;
+	static uint8_t crc8( const uint8_t *data, size_t len );
+	uint8_t user_reg;
+	Pending pending;
+	bool hold_master;
+	uint64_t ready_ns;
+	uint64_t busy_until_ns;
+	uint32_t num_conversions;
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,413 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file sim_mpl3115a2.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_mpl3115a2.h"
+
+/*-----------------------------------------*/
+/* Private declarations  */
+
+#define MPL_ADDRESS                 (0x60)
+
+#define MPL_STATUS                  (0x00)
+#define MPL_OUT_P_MSB               (0x01)
+#define MPL_OUT_P_CSB               (0x02)
+#define MPL_OUT_P_LSB               (0x03)
+#define MPL_OUT_T_MSB               (0x04)
+#define MPL_OUT_T_LSB               (0x05)
+#define MPL_DR_STATUS               (0x06)
+#define MPL_OUT_P_DELTA_MSB         (0x07)
+#define MPL_OUT_T_DELTA_MSB         (0x0A)
+#define MPL_WHO_AM_I                (0x0C)
+#define MPL_F_STATUS                (0x0D)
+#define MPL_F_DATA                  (0x0E)
+#define MPL_F_SETUP                 (0x0F)
+#define MPL_INT_SOURCE              (0x12)
+#define MPL_PT_DATA_CFG             (0x13)
+#define MPL_BAR_IN_MSB              (0x14)
+#define MPL_BAR_IN_LSB              (0x15)
+#define MPL_CTRL_REG1               (0x26)
+#define MPL_CTRL_REG2               (0x27)
+#define MPL_CTRL_REG4               (0x29)
+#define MPL_P_TGT_MSB               (0x16)
+#define MPL_P_TGT_LSB               (0x17)
+#define MPL_T_TGT                   (0x18)
+#define MPL_P_WND_MSB               (0x19)
+#define MPL_P_WND_LSB               (0x1A)
+#define MPL_T_WND                   (0x1B)
+
+/* INT_SOURCE flags and the CTRL_REG4 enables in the same bits */
+#define MPL_INT_PW                  (0x20)
+#define MPL_INT_TW                  (0x10)
+
+#define MPL_DR_TDR                  (0x02)
+#define MPL_DR_PDR                  (0x04)
+#define MPL_DR_PTDR                 (0x08)
+#define MPL_DR_TOW                  (0x20)
+#define MPL_DR_POW                  (0x40)
+#define MPL_DR_PTOW                 (0x80)
+
+#define MPL_CTRL1_SBYB              (0x01)
+#define MPL_CTRL1_OST               (0x02)
+#define MPL_CTRL1_RST               (0x04)
+#define MPL_CTRL1_OS_MASK           (0x38)
+#define MPL_CTRL1_ALT               (0x80)
+
+#define MPL_F_MODE_MASK             (0xC0)
+#define MPL_F_MODE_CIRCULAR         (0x40)
+#define MPL_F_WMRK_MASK             (0x3F)
+#define MPL_F_STATUS_OVF            (0x80)
+#define MPL_F_STATUS_WMRK           (0x40)
+
+#define MPL_WHO_AM_I_VALUE          (0xC4)
+/* sea level pressure input, 2 Pa per count */
+#define MPL_BAR_IN_DEFAULT          (50663)
+
+SimMPL3115A2::SimMPL3115A2() : sim::I2CDevice( MPL_ADDRESS ) {
+	rng_state = 0x9E3779B97F4A7C15ULL;
+	num_conversions = 0;
+	reset();
+}
+
+void SimMPL3115A2::reset( void ) {
+	memset( regs, 0, sizeof( regs ) );
+	regs[MPL_WHO_AM_I] = MPL_WHO_AM_I_VALUE;
+	regs[MPL_BAR_IN_MSB] = (uint8_t) ( MPL_BAR_IN_DEFAULT >> 8 );
+	regs[MPL_BAR_IN_LSB] = (uint8_t) MPL_BAR_IN_DEFAULT;
+	reg_ptr = 0;
+	one_shot_busy = false;
+	one_shot_done_ns = 0;
+	active = false;
+	next_sample_ns = 0;
+	fifo_head = 0;
+	fifo_count = 0;
+	fifo_byte = 0;
+	fifo_overflow = false;
+	window_valid = false;
+	p_inside = false;
+	t_inside = false;
+}
+
+/**
+ * @brief      Minimum time between samples for the oversampling ratio in
+ *             CTRL_REG1 (datasheet table: 6 ms at OS1 up to 512 ms at OS128).
+ */
+uint64_t SimMPL3115A2::conversion_ns( uint8_t ctrl_reg1 ) {
+	static const uint16_t ms[8] = { 6, 10, 18, 34, 66, 130, 258, 512 };
+	return (uint64_t) ms[( ctrl_reg1 & MPL_CTRL1_OS_MASK ) >> 3] * 1000000ULL;
+}
+
+/**
+ * @brief      RMS pressure noise - 1.5 Pa at OS128, growing with the square
+ *             root of the reduction in averaged samples.
+ */
+double SimMPL3115A2::pressure_noise_pa( uint8_t ctrl_reg1 ) {
+	unsigned os = 1u << ( ( ctrl_reg1 & MPL_CTRL1_OS_MASK ) >> 3 );
+	return 1.5 * sqrt( 128.0 / os );
+}
+
+uint64_t SimMPL3115A2::acquisition_period_ns( void ) const {
+	uint64_t step = 1000000000ULL << ( regs[MPL_CTRL_REG2] & 0x0F );
+	uint64_t conv = conversion_ns( regs[MPL_CTRL_REG1] );
+	return ( conv > step ) ? conv : step;
+}
+
+double SimMPL3115A2::gaussian( void ) {
+	double u[2];
+	for ( int i = 0; i < 2; i++ ) {
+		rng_state ^= rng_state << 13;
+		rng_state ^= rng_state >> 7;
+		rng_state ^= rng_state << 17;
+		u[i] = ( (double) ( rng_state >> 11 ) + 0.5 ) / 9007199254740992.0;
+	}
+	return sqrt( -2.0 * log( u[0] ) ) * cos( 6.283185307179586 * u[1] );
+}
+
+/**
+ * @brief      Runs every conversion that has finished by the current time.
+ */
+void SimMPL3115A2::sync( void ) {
+	uint64_t now = sim::now_ns();
+	for ( ;; ) {
+		bool os_due = one_shot_busy && ( one_shot_done_ns <= now );
+		bool act_due = active && ( next_sample_ns <= now );
+		if ( os_due && ( !act_due || ( one_shot_done_ns <= next_sample_ns ) ) ) {
+			one_shot_busy = false;
+			regs[MPL_CTRL_REG1] &= ~MPL_CTRL1_OST;
+			complete_conversion( one_shot_done_ns );
+		}
+		else if ( act_due ) {
+			uint64_t at = next_sample_ns;
+			next_sample_ns += acquisition_period_ns();
+			complete_conversion( at );
+		}
+		else {
+			break;
+		}
+	}
+}
+
+/**
+ * @brief      Latches a new pressure/altitude and temperature result into
+ *             the output and delta registers and raises the data ready flags.
+ */
+void SimMPL3115A2::complete_conversion( uint64_t at_ns ) {
+	(void) at_ns;
+	const sim::Environment &e = sim::env();
+	uint8_t ctrl1 = regs[MPL_CTRL_REG1];
+	double noise_scale = pressure_noise_pa( ctrl1 ) / 1.5;
+	double p = e.pressure_pa + gaussian() * pressure_noise_pa( ctrl1 );
+	double t = e.temp_c + gaussian() * 0.02 * noise_scale;
+	int32_t p_out;
+
+	if ( ctrl1 & MPL_CTRL1_ALT ) {
+		double bar_in = 2.0 * ( ( regs[MPL_BAR_IN_MSB] << 8 ) | regs[MPL_BAR_IN_LSB] );
+		double alt = 44330.77 * ( 1.0 - pow( p / bar_in, 0.1902632 ) );
+		p_out = (int32_t) lround( alt * 16.0 );
+	}
+	else {
+		p_out = (int32_t) lround( p * 4.0 );
+	}
+	int32_t t_out = (int32_t) lround( t * 16.0 );
+
+	int32_t p_old = ( regs[MPL_OUT_P_MSB] << 12 ) | ( regs[MPL_OUT_P_CSB] << 4 ) |
+	                ( regs[MPL_OUT_P_LSB] >> 4 );
+	int32_t t_old = ( regs[MPL_OUT_T_MSB] << 4 ) | ( regs[MPL_OUT_T_LSB] >> 4 );
+	if ( ( ctrl1 & MPL_CTRL1_ALT ) && ( p_old & 0x80000 ) ) {
+		p_old -= 0x100000;
+	}
+	if ( t_old & 0x800 ) {
+		t_old -= 0x1000;
+	}
+	int32_t p_delta = p_out - p_old;
+	int32_t t_delta = t_out - t_old;
+
+	regs[MPL_OUT_P_MSB] = (uint8_t) ( p_out >> 12 );
+	regs[MPL_OUT_P_CSB] = (uint8_t) ( p_out >> 4 );
+	regs[MPL_OUT_P_LSB] = (uint8_t) ( ( p_out & 0x0F ) << 4 );
+	regs[MPL_OUT_T_MSB] = (uint8_t) ( t_out >> 4 );
+	regs[MPL_OUT_T_LSB] = (uint8_t) ( ( t_out & 0x0F ) << 4 );
+
+	regs[MPL_OUT_P_DELTA_MSB] = (uint8_t) ( p_delta >> 12 );
+	regs[MPL_OUT_P_DELTA_MSB + 1] = (uint8_t) ( p_delta >> 4 );
+	regs[MPL_OUT_P_DELTA_MSB + 2] = (uint8_t) ( ( p_delta & 0x0F ) << 4 );
+	regs[MPL_OUT_T_DELTA_MSB] = (uint8_t) ( t_delta >> 4 );
+	regs[MPL_OUT_T_DELTA_MSB + 1] = (uint8_t) ( ( t_delta & 0x0F ) << 4 );
+
+	uint8_t dr = regs[MPL_DR_STATUS];
+	if ( dr & MPL_DR_PDR ) {
+		dr |= MPL_DR_POW | MPL_DR_PTOW;
+	}
+	if ( dr & MPL_DR_TDR ) {
+		dr |= MPL_DR_TOW | MPL_DR_PTOW;
+	}
+	dr |= MPL_DR_PDR | MPL_DR_TDR | MPL_DR_PTDR;
+	regs[MPL_DR_STATUS] = dr;
+
+	window_check( p_out, t_out );
+	if ( fifo_mode() ) {
+		fifo_push();
+	}
+	num_conversions++;
+}
+
+/**
+ * @brief      Pressure and temperature window comparators: SRC_PW/SRC_TW are
+ *             raised when a result crosses an edge of target +/- window,
+ *             going out or coming back in.  A zero window is the threshold
+ *             comparator, which is not modelled.
+ */
+void SimMPL3115A2::window_check( int32_t p_out, int32_t t_out ) {
+	/* targets and windows count 2 Pa or 1 m, OUT_P Pa x 4 or m x 16 */
+	bool alt = ( regs[MPL_CTRL_REG1] & MPL_CTRL1_ALT );
+	int32_t p_scale = alt ? 16 : 8;
+	int32_t p_tgt = ( regs[MPL_P_TGT_MSB] << 8 ) | regs[MPL_P_TGT_LSB];
+	int32_t p_wnd = ( regs[MPL_P_WND_MSB] << 8 ) | regs[MPL_P_WND_LSB];
+	int32_t t_tgt = (int8_t) regs[MPL_T_TGT];
+	int32_t t_wnd = regs[MPL_T_WND];
+	if ( alt ) {
+		p_tgt = (int16_t) p_tgt;
+	}
+	bool p_in = labs( p_out - p_tgt * p_scale ) <= p_wnd * p_scale;
+	bool t_in = labs( t_out - t_tgt * 16 ) <= t_wnd * 16;
+	uint8_t enabled = regs[MPL_CTRL_REG4];
+
+	if ( window_valid ) {
+		if ( p_wnd && ( p_in != p_inside ) && ( enabled & MPL_INT_PW ) ) {
+			regs[MPL_INT_SOURCE] |= MPL_INT_PW;
+		}
+		if ( t_wnd && ( t_in != t_inside ) && ( enabled & MPL_INT_TW ) ) {
+			regs[MPL_INT_SOURCE] |= MPL_INT_TW;
+		}
+	}
+	p_inside = p_in;
+	t_inside = t_in;
+	window_valid = true;
+}
+
+uint8_t SimMPL3115A2::fifo_mode( void ) const {
+	return regs[MPL_F_SETUP] & MPL_F_MODE_MASK;
+}
+
+/**
+ * @brief      Queues the result just latched in OUT_P/OUT_T.  A full FIFO
+ *             drops its oldest sample in circular mode and the new one in
+ *             stop mode, raising F_OVF either way.
+ */
+void SimMPL3115A2::fifo_push( void ) {
+	if ( SIM_MPL3115A2_FIFO_DEPTH == fifo_count ) {
+		fifo_overflow = true;
+		if ( MPL_F_MODE_CIRCULAR != fifo_mode() ) {
+			return;
+		}
+		fifo_head = ( fifo_head + 1 ) % SIM_MPL3115A2_FIFO_DEPTH;
+		fifo_byte = 0;
+		fifo_count--;
+	}
+	uint8_t slot = ( fifo_head + fifo_count ) % SIM_MPL3115A2_FIFO_DEPTH;
+	memcpy( fifo[slot], &regs[MPL_OUT_P_MSB], SIM_MPL3115A2_SAMPLE_BYTES );
+	fifo_count++;
+}
+
+/**
+ * @brief      Next F_DATA byte; an empty FIFO reads as 0.
+ */
+uint8_t SimMPL3115A2::fifo_pop( void ) {
+	if ( 0 == fifo_count ) {
+		return 0;
+	}
+	uint8_t value = fifo[fifo_head][fifo_byte++];
+	if ( SIM_MPL3115A2_SAMPLE_BYTES == fifo_byte ) {
+		fifo_byte = 0;
+		fifo_head = ( fifo_head + 1 ) % SIM_MPL3115A2_FIFO_DEPTH;
+		fifo_count--;
+	}
+	return value;
+}
+
+void SimMPL3115A2::write_reg( uint8_t reg, uint8_t value ) {
+	if ( reg >= SIM_MPL3115A2_NUM_REGS ) {
+		return;
+	}
+	if ( ( reg <= MPL_F_DATA ) || ( MPL_INT_SOURCE == reg ) ) {
+		/* output, status, FIFO and interrupt source registers are read only */
+		return;
+	}
+	if ( MPL_F_SETUP == reg ) {
+		if ( ( value & MPL_F_MODE_MASK ) != fifo_mode() ) {
+			/* a mode change empties the FIFO */
+			fifo_head = 0;
+			fifo_count = 0;
+			fifo_byte = 0;
+			fifo_overflow = false;
+		}
+		regs[reg] = value;
+		return;
+	}
+	if ( MPL_CTRL_REG1 == reg ) {
+		if ( value & MPL_CTRL1_RST ) {
+			reset();
+			return;
+		}
+		uint64_t now = sim::now_ns();
+		regs[reg] = value;
+		if ( ( value & MPL_CTRL1_SBYB ) && !active ) {
+			active = true;
+			next_sample_ns = now + conversion_ns( value );
+		}
+		else if ( !( value & MPL_CTRL1_SBYB ) ) {
+			active = false;
+		}
+		if ( ( value & MPL_CTRL1_OST ) && !one_shot_busy ) {
+			one_shot_busy = true;
+			one_shot_done_ns = now + conversion_ns( value );
+		}
+		return;
+	}
+	regs[reg] = value;
+}
+
+uint8_t SimMPL3115A2::read_reg( uint8_t reg ) {
+	if ( reg >= SIM_MPL3115A2_NUM_REGS ) {
+		return 0;
+	}
+	if ( MPL_STATUS == reg ) {
+		/* STATUS is a copy of DR_STATUS, or F_STATUS with the FIFO on */
+		reg = fifo_mode() ? MPL_F_STATUS : MPL_DR_STATUS;
+	}
+	if ( MPL_F_STATUS == reg ) {
+		uint8_t wmrk = regs[MPL_F_SETUP] & MPL_F_WMRK_MASK;
+		uint8_t value = fifo_count;
+		value |= fifo_overflow ? MPL_F_STATUS_OVF : 0;
+		value |= ( wmrk && ( fifo_count >= wmrk ) ) ? MPL_F_STATUS_WMRK : 0;
+		fifo_overflow = false;
+		return value;
+	}
+	if ( MPL_F_DATA == reg ) {
+		return fifo_pop();
+	}
+	uint8_t value = regs[reg];
+
+	if ( MPL_OUT_P_MSB == reg ) {
+		regs[MPL_DR_STATUS] &= ~( MPL_DR_PDR | MPL_DR_POW );
+		regs[MPL_INT_SOURCE] &= ~MPL_INT_PW;
+	}
+	else if ( MPL_OUT_T_MSB == reg ) {
+		regs[MPL_DR_STATUS] &= ~( MPL_DR_TDR | MPL_DR_TOW );
+		regs[MPL_INT_SOURCE] &= ~MPL_INT_TW;
+	}
+	if ( !( regs[MPL_DR_STATUS] & ( MPL_DR_PDR | MPL_DR_TDR ) ) ) {
+		regs[MPL_DR_STATUS] &= ~( MPL_DR_PTDR | MPL_DR_PTOW );
+	}
+	return value;
+}
+
+/**
+ * @brief      Auto-increment rule - with the FIFO off the read pointer wraps
+ *             from OUT_T_LSB back to STATUS, with it on the pointer stays on
+ *             F_DATA so the FIFO drains in one burst.
+ */
+uint8_t SimMPL3115A2::next_reg( uint8_t reg ) const {
+	if ( ( MPL_OUT_T_LSB == reg ) && !fifo_mode() ) {
+		return MPL_STATUS;
+	}
+	if ( ( MPL_F_DATA == reg ) && fifo_mode() ) {
+		return MPL_F_DATA;
+	}
+	reg++;
+	return ( reg >= SIM_MPL3115A2_NUM_REGS ) ? 0 : reg;
+}
+
+bool SimMPL3115A2::on_write( const uint8_t *data, size_t len ) {
+	sync();
+	if ( 0 == len ) {
+		return true;
+	}
+	reg_ptr = data[0];
+	for ( size_t i = 1; i < len; i++ ) {
+		write_reg( reg_ptr, data[i] );
+		reg_ptr = next_reg( reg_ptr );
+	}
+	return true;
+}
+
+size_t SimMPL3115A2::on_read( uint8_t *data, size_t len, uint64_t *stretch_ns ) {
+	*stretch_ns = 0;
+	sync();
+	for ( size_t i = 0; i < len; i++ ) {
+		data[i] = read_reg( reg_ptr );
+		reg_ptr = next_reg( reg_ptr );
+	}
+	return len;
+}
+
+/** @} end of addtogroup */
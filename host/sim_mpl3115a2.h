@@ -0,0 +1,80 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file sim_mpl3115a2.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Register level model of the MPL3115A2 barometer/altimeter.
+ *
+ * @details    Models the register file with auto-incrementing reads, the
+ *             standby/active modes, one-shot (OST) conversions, the
+ *             auto-acquisition period from CTRL_REG2, the data ready and
+ *             overwrite flags in DR_STATUS and the OUT_P/OUT_T delta
+ *             registers.  Conversion time and RMS noise follow the selected
+ *             oversampling ratio.
+ *
+ *             With F_MODE set in F_SETUP each conversion is also queued in
+ *             the 32 sample FIFO (circular or stop when full), STATUS reads
+ *             as F_STATUS and the samples are read out of F_DATA five bytes
+ *             at a time, the read pointer staying on F_DATA.
+ *
+ *             The pressure and temperature window comparators raise SRC_PW
+ *             and SRC_TW in INT_SOURCE when enabled in CTRL_REG4; reading
+ *             OUT_P_MSB or OUT_T_MSB clears them.
+ */
+
+#ifndef SIM_MPL3115A2_H
+#define SIM_MPL3115A2_H
+
+#include "sim.h"
+
+#define SIM_MPL3115A2_NUM_REGS      (0x2E)
+#define SIM_MPL3115A2_FIFO_DEPTH    (32)
+/* OUT_P MSB/CSB/LSB, OUT_T MSB/LSB */
+#define SIM_MPL3115A2_SAMPLE_BYTES  (5)
+
+class SimMPL3115A2 : public sim::I2CDevice {
+public:
+	SimMPL3115A2();
+	bool on_write( const uint8_t *data, size_t len );
+	size_t on_read( uint8_t *data, size_t len, uint64_t *stretch_ns );
+	void on_advance( void ) { sync(); }
+	uint32_t conversions( void ) const { return num_conversions; }
+	static uint64_t conversion_ns( uint8_t ctrl_reg1 );
+	static double pressure_noise_pa( uint8_t ctrl_reg1 );
+private:
+	void reset( void );
+	void sync( void );
+	void complete_conversion( uint64_t at_ns );
+	void write_reg( uint8_t reg, uint8_t value );
+	uint8_t read_reg( uint8_t reg );
+	uint8_t next_reg( uint8_t reg ) const;
+	uint8_t fifo_mode( void ) const;
+	void fifo_push( void );
+	uint8_t fifo_pop( void );
+	void window_check( int32_t p_out, int32_t t_out );
+	uint64_t acquisition_period_ns( void ) const;
+	double gaussian( void );
+	uint8_t regs[SIM_MPL3115A2_NUM_REGS];
+	uint8_t reg_ptr;
+	bool one_shot_busy;
+	uint64_t one_shot_done_ns;
+	bool active;
+	uint64_t next_sample_ns;
+	uint32_t num_conversions;
+	uint64_t rng_state;
+	uint8_t fifo[SIM_MPL3115A2_FIFO_DEPTH][SIM_MPL3115A2_SAMPLE_BYTES];
+	uint8_t fifo_head;
+	uint8_t fifo_count;
+	uint8_t fifo_byte;      /* next byte of the head sample */
+	bool fifo_overflow;
+	bool window_valid;      /* p_inside/t_inside hold a previous result */
+	bool p_inside;
+	bool t_inside;
+};
+
+#endif
+
+/** @} end of addtogroup */
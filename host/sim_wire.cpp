@@ -0,0 +1,216 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file sim_wire.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Simulated I2C bus and the TwoWire master that drives it.
+ */
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "sim.h"
+
+/*-----------------------------------------*/
+/* Private declarations  */
+
+#define SIM_I2C_MAX_DEVICES         (8)
+#define SIM_I2C_DEFAULT_CLOCK       (100000UL)
+
+/* twi library entry/exit and per byte interrupt handling */
+#define SIM_CYCLES_TWI_TRANSACTION  (200)
+#define SIM_CYCLES_TWI_BYTE         (80)
+
+/* endTransmission() result codes */
+#define TWI_OK                      (0)
+#define TWI_NACK_ADDR               (2)
+#define TWI_NACK_DATA               (3)
+
+namespace {
+
+sim::I2CDevice *devices[SIM_I2C_MAX_DEVICES];
+uint8_t num_devices = 0;
+uint64_t bit_ns = 1000000000ULL / SIM_I2C_DEFAULT_CLOCK;
+/* the last message ended without a STOP, the next START is a repeated one */
+bool bus_held = false;
+
+/**
+ * @brief      Charges one message: START (or repeated START), address byte,
+ *             data bytes (9 clocks each including ACK) and the STOP if one
+ *             is sent, plus any stretching.
+ *
+ * @details    A transaction runs from a START on an idle bus to the STOP, so
+ *             a register pointer write followed by a repeated START read is
+ *             one transaction of two messages.
+ */
+void charge_message( uint8_t address, size_t data_bytes, uint64_t stretch_ns, bool stop ) {
+	sim::Stats &st = sim::stats();
+	uint64_t ns = bit_ns * ( 1 + 9 * ( 1 + data_bytes ) + ( stop ? 1 : 0 ) ) + stretch_ns;
+
+	if ( !bus_held ) {
+		st.i2c_transactions++;
+		st.i2c_transactions_by_addr[address & 0x7F]++;
+	}
+	bus_held = !stop;
+	st.i2c_messages++;
+	st.i2c_bytes += data_bytes + 1;
+	st.i2c_ns += ns;
+	st.i2c_stretch_ns += stretch_ns;
+
+	sim::charge_cycles( SIM_CYCLES_TWI_TRANSACTION + SIM_CYCLES_TWI_BYTE * ( data_bytes + 1 ) );
+	sim::advance_ns( ns );
+}
+
+}
+
+namespace sim {
+
+void attach_i2c( I2CDevice *dev ) {
+	if ( num_devices < SIM_I2C_MAX_DEVICES ) {
+		devices[num_devices++] = dev;
+	}
+}
+
+I2CDevice *find_i2c( uint8_t address ) {
+	for ( uint8_t i = 0; i < num_devices; i++ ) {
+		if ( devices[i]->address() == address ) {
+			return devices[i];
+		}
+	}
+	return 0;
+}
+
+void advance_i2c( void ) {
+	for ( uint8_t i = 0; i < num_devices; i++ ) {
+		devices[i]->on_advance();
+	}
+}
+
+void set_i2c_clock( uint32_t hz ) {
+	if ( hz ) {
+		bit_ns = 1000000000ULL / hz;
+	}
+}
+
+uint64_t i2c_bit_ns( void ) {
+	return bit_ns;
+}
+
+}
+
+/*-----------------------------------------*/
+/* TwoWire */
+
+TwoWire Wire;
+
+TwoWire::TwoWire() {
+	tx_address = 0;
+	tx_length = 0;
+	rx_length = 0;
+	rx_index = 0;
+	transmitting = false;
+}
+
+void TwoWire::begin( void ) {
+	rx_length = 0;
+	rx_index = 0;
+	tx_length = 0;
+}
+
+void TwoWire::end( void ) {
+}
+
+void TwoWire::setClock( uint32_t clock_hz ) {
+	sim::set_i2c_clock( clock_hz );
+}
+
+void TwoWire::beginTransmission( uint8_t address ) {
+	transmitting = true;
+	tx_address = address;
+	tx_length = 0;
+}
+
+size_t TwoWire::write( uint8_t data ) {
+	if ( !transmitting || ( tx_length >= BUFFER_LENGTH ) ) {
+		return 0;
+	}
+	tx_buffer[tx_length++] = data;
+	return 1;
+}
+
+size_t TwoWire::write( const uint8_t *data, size_t quantity ) {
+	size_t n = 0;
+	while ( quantity-- ) {
+		n += write( *data++ );
+	}
+	return n;
+}
+
+uint8_t TwoWire::endTransmission( uint8_t send_stop ) {
+	uint8_t result = TWI_OK;
+	sim::I2CDevice *dev = sim::find_i2c( tx_address );
+
+	transmitting = false;
+	if ( 0 == dev ) {
+		/* the twi library always sends a STOP after a NACK */
+		charge_message( tx_address, 0, 0, true );
+		sim::stats().i2c_nacks++;
+		result = TWI_NACK_ADDR;
+	}
+	else {
+		charge_message( tx_address, tx_length, 0, send_stop );
+		if ( !dev->on_write( tx_buffer, tx_length ) ) {
+			bus_held = false;
+			sim::stats().i2c_nacks++;
+			result = TWI_NACK_DATA;
+		}
+	}
+	tx_length = 0;
+	return result;
+}
+
+uint8_t TwoWire::requestFrom( uint8_t address, uint8_t quantity, uint8_t send_stop ) {
+	sim::I2CDevice *dev = sim::find_i2c( address );
+	uint64_t stretch = 0;
+	size_t got = 0;
+
+	if ( quantity > BUFFER_LENGTH ) {
+		quantity = BUFFER_LENGTH;
+	}
+	if ( dev ) {
+		got = dev->on_read( rx_buffer, quantity, &stretch );
+	}
+	if ( 0 == got ) {
+		/* address NACK - only the address byte went out */
+		charge_message( address, 0, 0, true );
+		sim::stats().i2c_nacks++;
+	}
+	else {
+		charge_message( address, got, stretch, send_stop );
+	}
+	rx_index = 0;
+	rx_length = (uint8_t) got;
+	return rx_length;
+}
+
+int TwoWire::available( void ) {
+	return rx_length - rx_index;
+}
+
+int TwoWire::read( void ) {
+	if ( rx_index < rx_length ) {
+		return rx_buffer[rx_index++];
+	}
+	return -1;
+}
+
+int TwoWire::peek( void ) {
+	if ( rx_index < rx_length ) {
+		return rx_buffer[rx_index];
+	}
+	return -1;
+}
+
+/** @} end of addtogroup */
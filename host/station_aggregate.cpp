@@ -0,0 +1,56 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file station_aggregate.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "station_aggregate.h"
+
+void StationAggregate::add( const TELEMETRY_RECORD_T &rec ) {
+	if ( records ) {
+		uint16_t gap = (uint16_t) ( rec.seq - last.seq - 1 );
+		/* more than half the sequence space forward reads as a step back */
+		if ( gap < 0x8000 ) {
+			missed += gap;
+		}
+		else {
+			restarts++;
+		}
+	}
+	records++;
+
+	wind_sum += rec.wind_spd;
+	if ( rec.gust_spd > gust_max ) {
+		gust_max = rec.gust_spd;
+		gust_max_dir = rec.gust_dir;
+	}
+	if ( rec.valid & TELEM_VALID_HTU ) {
+		if ( !temp_records || ( rec.temp_htu_c100 < temp_min_c100 ) ) {
+			temp_min_c100 = rec.temp_htu_c100;
+		}
+		if ( !temp_records || ( rec.temp_htu_c100 > temp_max_c100 ) ) {
+			temp_max_c100 = rec.temp_htu_c100;
+		}
+		temp_records++;
+	}
+	if ( rec.valid & TELEM_VALID_MPL_P ) {
+		if ( !pressure_records || ( rec.pressure_pa4 < pressure_min_pa4 ) ) {
+			pressure_min_pa4 = rec.pressure_pa4;
+		}
+		if ( !pressure_records || ( rec.pressure_pa4 > pressure_max_pa4 ) ) {
+			pressure_max_pa4 = rec.pressure_pa4;
+		}
+		pressure_records++;
+	}
+	last = rec;
+}
+
+void StationAggregate::add_log( const RINGLOG_RECORD_T &rec ) {
+	(void) rec;
+	log_records++;
+}
+
+/** @} end of addtogroup */
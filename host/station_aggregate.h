@@ -0,0 +1,56 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file station_aggregate.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Running summary of one station's telemetry on the collector.
+ *
+ * @details    Reads each record the way the board means it: wind_spd is the
+ *             5 s mean, gust_spd the strongest 1 s wind of the last 2
+ *             minutes, rain_day the rolling 24 h total, and the HTU21D /
+ *             MPL3115A2 fields only count when their valid bit is set.  The
+ *             16 bit sequence number shows records lost on the link (a jump
+ *             forward) and board resets (a step back to a lower number).
+ */
+
+#ifndef STATION_AGGREGATE_H
+#define STATION_AGGREGATE_H
+
+#include <stdint.h>
+
+#include "../Telemetry.h"
+#include "../RingLog.h"
+
+struct StationAggregate {
+	uint64_t records = 0;
+	uint64_t missed = 0;        /* sequence numbers skipped */
+	uint64_t restarts = 0;      /* sequence went backwards */
+	uint64_t log_records = 0;   /* dumped from the EEPROM log */
+
+	uint64_t wind_sum = 0;      /* of the 5 s means, mph x 1000 */
+	uint32_t gust_max = 0;
+	uint16_t gust_max_dir = 0;
+	int16_t temp_min_c100 = 0;
+	int16_t temp_max_c100 = 0;
+	uint64_t temp_records = 0;
+	uint32_t pressure_min_pa4 = 0;
+	uint32_t pressure_max_pa4 = 0;
+	uint64_t pressure_records = 0;
+
+	TELEMETRY_RECORD_T last = TELEMETRY_RECORD_T();
+
+	void add( const TELEMETRY_RECORD_T &rec );
+	void add_log( const RINGLOG_RECORD_T &rec );
+
+	/** @brief Mean of the 5 s wind means, mph x 1000. */
+	uint32_t wind_mean( void ) const {
+		return records ? (uint32_t) ( wind_sum / records ) : 0;
+	}
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,93 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file station_history.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include <string.h>
+#include <sys/stat.h>
+
+#include "station_history.h"
+
+static const char *const column_names[HIST_COLUMNS] = {
+	"wind_mph", "wind_dir", "gust_mph", "rain_in", "temp_c", "humidity_pct", "pressure_pa"
+};
+
+const char *StationHistory::column_name( HIST_COLUMN_T c ) {
+	return ( c < HIST_COLUMNS ) ? column_names[c] : "?";
+}
+
+bool StationHistory::column_by_name( const char *name, HIST_COLUMN_T *c ) {
+	for ( int i = 0; i < HIST_COLUMNS; i++ ) {
+		if ( !strcmp( name, column_names[i] ) ) {
+			*c = (HIST_COLUMN_T) i;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief      Opens every column of the station kept in dir, creating the
+ *             directory and files if writable.
+ */
+bool StationHistory::open( const std::string &dir, bool writable ) {
+	if ( writable ) {
+		mkdir( dir.c_str(), 0755 );
+	}
+	for ( int i = 0; i < HIST_COLUMNS; i++ ) {
+		if ( !col[i].open( dir + "/" + column_names[i] + ".ser", writable ) ) {
+			close();
+			return false;
+		}
+	}
+	return true;
+}
+
+bool StationHistory::flush( void ) {
+	bool ok = true;
+	for ( int i = 0; i < HIST_COLUMNS; i++ ) {
+		ok = col[i].flush() && ok;
+	}
+	return ok;
+}
+
+void StationHistory::close( void ) {
+	for ( int i = 0; i < HIST_COLUMNS; i++ ) {
+		col[i].close();
+	}
+}
+
+bool StationHistory::add_minute( HIST_COLUMN_T c, int64_t t_ms, double v ) {
+	SeriesFile &s = col[c];
+	if ( s.samples() && ( t_ms / HIST_MINUTE_MS <= s.last_time() / HIST_MINUTE_MS ) ) {
+		return true;
+	}
+	return s.append( t_ms, v );
+}
+
+/**
+ * @brief      Files one telemetry record, stamped t_ms.
+ *
+ * @return     false if a column refused it - t_ms not after the last
+ *             sample, or a write failed.
+ */
+bool StationHistory::add( int64_t t_ms, const TELEMETRY_RECORD_T &rec ) {
+	bool ok = col[HIST_WIND_MPH].append( t_ms, (float) ( rec.wind_spd / 1000.0 ) );
+	ok = col[HIST_WIND_DIR].append( t_ms, rec.wind_dir ) && ok;
+	ok = col[HIST_GUST_MPH].append( t_ms, (float) ( rec.gust_spd / 1000.0 ) ) && ok;
+	ok = add_minute( HIST_RAIN_IN, t_ms, (float) ( rec.rain_1m / 1000.0 ) ) && ok;
+	if ( rec.valid & TELEM_VALID_HTU ) {
+		ok = add_minute( HIST_TEMP_C, t_ms, rec.temp_htu_c100 / 100.0f ) && ok;
+		ok = add_minute( HIST_HUMIDITY, t_ms, rec.humidity_c100 / 100.0f ) && ok;
+	}
+	if ( rec.valid & TELEM_VALID_MPL_P ) {
+		ok = add_minute( HIST_PRESSURE_PA, t_ms, rec.pressure_pa4 / 4.0f ) && ok;
+	}
+	return ok;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,62 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file station_history.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      One station's history on the collector - a directory holding
+ *             a SeriesFile per column.
+ *
+ * @details    Wind (WSA80422) is kept at the rate the reports arrive; rain,
+ *             temperature and humidity (HTU21D) and pressure (MPL3115A2)
+ *             once a minute, from the first report of each minute with the
+ *             reading valid.  Values are stored in the units the drivers
+ *             hand out - mph, degrees, inches, deg C, %RH and Pa - as the
+ *             floats they compute, so they compress the way the raw
+ *             readings do.
+ */
+
+#ifndef STATION_HISTORY_H
+#define STATION_HISTORY_H
+
+#include <stdint.h>
+#include <string>
+
+#include "series_store.h"
+#include "../Telemetry.h"
+
+typedef enum HIST_COLUMN {
+	HIST_WIND_MPH,
+	HIST_WIND_DIR,
+	HIST_GUST_MPH,
+	HIST_RAIN_IN,
+	HIST_TEMP_C,
+	HIST_HUMIDITY,
+	HIST_PRESSURE_PA,
+	HIST_COLUMNS
+} HIST_COLUMN_T;
+
+#define HIST_MINUTE_MS              (60000)
+
+class StationHistory {
+public:
+	bool open( const std::string &dir, bool writable );
+	bool add( int64_t t_ms, const TELEMETRY_RECORD_T &rec );
+	bool flush( void );
+	void close( void );
+
+	SeriesFile &column( HIST_COLUMN_T c ) { return col[c]; }
+	static const char *column_name( HIST_COLUMN_T c );
+	static bool column_by_name( const char *name, HIST_COLUMN_T *c );
+
+private:
+	SeriesFile col[HIST_COLUMNS];
+
+	bool add_minute( HIST_COLUMN_T c, int64_t t_ms, double v );
+};
+
+#endif
+
+/** @} end of addtogroup */
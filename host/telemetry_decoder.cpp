@@ -0,0 +1,50 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file telemetry_decoder.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "telemetry_decoder.h"
+#include "../cobs.h"
+#include "../crc8.h"
+
+bool TelemetryDecoder::decode_frame( const uint8_t *cobs, size_t len, TELEMETRY_RECORD_T *rec,
+                                     bool *crc_error ) {
+	uint8_t payload[TELEMETRY_PAYLOAD_LEN + 1];
+
+	*crc_error = false;
+	if ( COBS_ENCODED_LEN( sizeof( payload ) ) != len ) {
+		return false;
+	}
+	if ( sizeof( payload ) != cobs_decode( cobs, len, payload ) ) {
+		return false;
+	}
+	if ( !crc8_verify( payload, sizeof( payload ) ) ) {
+		*crc_error = true;
+		return false;
+	}
+	return telemetry_unpack( payload, TELEMETRY_PAYLOAD_LEN, rec );
+}
+
+bool TelemetryDecoder::decode_log_frame( const uint8_t *cobs, size_t len, RINGLOG_RECORD_T *rec,
+                                         bool *crc_error ) {
+	uint8_t payload[RINGLOG_RECORD_LEN + 2];
+
+	*crc_error = false;
+	if ( COBS_ENCODED_LEN( sizeof( payload ) ) != len ) {
+		return false;
+	}
+	if ( sizeof( payload ) != cobs_decode( cobs, len, payload ) ) {
+		return false;
+	}
+	if ( !crc8_verify( payload, sizeof( payload ) ) ) {
+		*crc_error = true;
+		return false;
+	}
+	return ( RINGLOG_FRAME_TAG == payload[0] ) && RingLog::unpack( payload + 1, rec );
+}
+
+/** @} end of addtogroup */
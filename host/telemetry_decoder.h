@@ -0,0 +1,155 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file telemetry_decoder.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Stream decoder for the station's binary telemetry frames
+ *             (see Telemetry.h for the wire format).
+ *
+ * @details    feed() takes bytes in whatever pieces they arrive and calls
+ *             back once per intact record.  Frames wholly inside one piece
+ *             are decoded straight from the caller's buffer; only a frame
+ *             split across pieces is copied.  Text or noise between frames
+ *             shows up as bad frames and costs nothing else - the decoder is
+ *             back in sync at the next 0x00.  Log records dumped from the
+ *             EEPROM (RingLog.h) share the link and go to a second callback.
+ */
+
+#ifndef TELEMETRY_DECODER_H
+#define TELEMETRY_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../Telemetry.h"
+#include "../RingLog.h"
+
+class TelemetryDecoder {
+public:
+	struct Stats {
+		uint64_t bytes;
+		uint64_t frames;
+		uint64_t log_records;
+		uint64_t bad_frames;    /* wrong length, bad COBS, unknown version */
+		uint64_t crc_errors;
+	};
+
+	TelemetryDecoder() { reset(); }
+
+	void reset( void ) {
+		memset( &st, 0, sizeof( st ) );
+		partial_len = 0;
+	}
+
+	const Stats &stats( void ) const { return st; }
+
+	/**
+	 * @brief      Decodes one frame with its delimiters removed.
+	 *
+	 * @return     false if the frame is damaged or not a record.
+	 */
+	static bool decode_frame( const uint8_t *cobs, size_t len, TELEMETRY_RECORD_T *rec,
+	                          bool *crc_error );
+
+	/**
+	 * @brief      Decodes one log record frame with its delimiters removed.
+	 *
+	 * @return     false if the frame is damaged or not a log record.
+	 */
+	static bool decode_log_frame( const uint8_t *cobs, size_t len, RINGLOG_RECORD_T *rec,
+	                              bool *crc_error );
+
+	/**
+	 * @brief      Feeds a piece of the stream.
+	 *
+	 * @param[in]  on_record  called as on_record( const TELEMETRY_RECORD_T & ).
+	 */
+	template <typename Fn>
+	void feed( const uint8_t *data, size_t len, Fn &&on_record ) {
+		feed( data, len, on_record, []( const RINGLOG_RECORD_T & ) {} );
+	}
+
+	/**
+	 * @brief      Feeds a piece of the stream, log records included.
+	 *
+	 * @param[in]  on_log  called as on_log( const RINGLOG_RECORD_T & ).
+	 */
+	template <typename Fn, typename LogFn>
+	void feed( const uint8_t *data, size_t len, Fn &&on_record, LogFn &&on_log ) {
+		const uint8_t *end = data + len;
+		st.bytes += len;
+
+		while ( data < end ) {
+			const uint8_t *zero = (const uint8_t *) memchr( data, 0, end - data );
+			if ( !zero ) {
+				append( data, end - data );
+				return;
+			}
+			if ( partial_len ) {
+				append( data, zero - data );
+				if ( partial_len <= sizeof( partial ) ) {
+					frame( partial, partial_len, on_record, on_log );
+				}
+				else {
+					st.bad_frames++;
+				}
+				partial_len = 0;
+			}
+			else if ( zero > data ) {
+				frame( data, zero - data, on_record, on_log );
+			}
+			data = zero + 1;
+		}
+	}
+
+private:
+	/* longest encoded frame worth keeping - anything longer is garbage */
+	uint8_t partial[TELEMETRY_FRAME_LEN];
+	size_t partial_len;
+	Stats st;
+
+	void append( const uint8_t *data, size_t len ) {
+		if ( partial_len + len <= sizeof( partial ) ) {
+			memcpy( partial + partial_len, data, len );
+		}
+		/* past the limit only the length is tracked, to reject the frame */
+		partial_len += len;
+	}
+
+	template <typename Fn, typename LogFn>
+	void frame( const uint8_t *cobs, size_t len, Fn &&on_record, LogFn &&on_log ) {
+		TELEMETRY_RECORD_T rec;
+		RINGLOG_RECORD_T log;
+		bool crc_error;
+		if ( RINGLOG_FRAME_LEN - 2 == len ) {
+			if ( decode_log_frame( cobs, len, &log, &crc_error ) ) {
+				st.log_records++;
+				on_log( log );
+			}
+			else if ( crc_error ) {
+				st.crc_errors++;
+			}
+			else {
+				st.bad_frames++;
+			}
+		}
+		else if ( decode_frame( cobs, len, &rec, &crc_error ) ) {
+			st.frames++;
+			on_record( rec );
+		}
+		else if ( crc_error ) {
+			st.crc_errors++;
+		}
+		else {
+			st.bad_frames++;
+		}
+	}
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,84 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file telemetry_dump.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Reads the station's serial stream on stdin and prints each
+ *             telemetry record as a CSV line - or, with --log, each record
+ *             dumped from the EEPROM log.
+ *
+ *             usage: weather_sim --seconds 60 | telemetry_dump
+ *                    telemetry_dump [--log] < /dev/ttyUSB0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "telemetry_decoder.h"
+
+static void print_record( const TELEMETRY_RECORD_T &r ) {
+	printf( "%u,%lu,%u,%d,%d,%u,%.3f,%.3f,%u,%.3f,%u,%.3f,%u,%.3f,%.3f,%.3f,",
+	        r.seq, (unsigned long) r.time_ms, r.valid, r.wind_x, r.wind_y, r.wind_dir,
+	        r.wind_spd / 1000.0, r.wind_spd_2m / 1000.0, r.wind_dir_2m,
+	        r.gust_spd / 1000.0, r.gust_dir, r.gust_10m_spd / 1000.0, r.gust_10m_dir,
+	        r.rain_1m / 1000.0, r.rain_1hr / 1000.0, r.rain_day / 1000.0 );
+	printf( "%.2f,%.2f,%.2f,%.2f,%u\n",
+	        r.temp_htu_c100 / 100.0, r.humidity_c100 / 100.0, r.temp_mpl_c100 / 100.0,
+	        r.pressure_pa4 / 4.0, r.light_mv );
+}
+
+static void print_log_record( const RINGLOG_RECORD_T &r ) {
+	printf( "%lu,%u,%.1f,%u,%.1f,%d,%.3f,",
+	        (unsigned long) r.seq, r.valid, r.wind_mph10 / 10.0, r.wind_dir,
+	        r.gust_mph10 / 10.0, ( WDIR_ERR == r.gust_dir ) ? -1 : (int) r.gust_dir,
+	        r.rain_tips * 0.011 );
+	printf( "%.2f,%.1f,%lu\n",
+	        r.temp_c100 / 100.0, r.humidity_x2 / 2.0, (unsigned long) r.pressure_pa );
+}
+
+int main( int argc, char **argv ) {
+	TelemetryDecoder dec;
+	uint8_t buf[4096];
+	ssize_t n;
+	bool log = false;
+
+	if ( ( 2 == argc ) && !strcmp( argv[1], "--log" ) ) {
+		log = true;
+	}
+	else if ( argc > 1 ) {
+		fprintf( stderr, "usage: %s [--log]\n", argv[0] );
+		return 2;
+	}
+
+	if ( log ) {
+		printf( "seq,valid,wind_2m_mph,wind_2m_dir,gust_mph,gust_dir,rain_in,"
+		        "temp_c,humidity_pct,pressure_pa\n" );
+	}
+	else {
+		printf( "seq,time_ms,valid,wind_x,wind_y,wind_dir,wind_mph,wind_2m_mph,wind_2m_dir,"
+		        "gust_mph,gust_dir,gust_10m_mph,gust_10m_dir,rain_1m_in,rain_1hr_in,"
+		        "rain_day_in,temp_htu_c,humidity_pct,temp_mpl_c,pressure_pa,light_mv\n" );
+	}
+	while ( ( n = read( 0, buf, sizeof( buf ) ) ) > 0 ) {
+		if ( log ) {
+			dec.feed( buf, (size_t) n, []( const TELEMETRY_RECORD_T & ) {}, print_log_record );
+		}
+		else {
+			dec.feed( buf, (size_t) n, print_record );
+		}
+	}
+
+	const TelemetryDecoder::Stats &st = dec.stats();
+	fprintf( stderr, "telemetry_dump: %llu bytes, %llu records, %llu log records, %llu bad, "
+	                 "%llu CRC errors\n",
+	         (unsigned long long) st.bytes, (unsigned long long) st.frames,
+	         (unsigned long long) st.log_records, (unsigned long long) st.bad_frames,
+	         (unsigned long long) st.crc_errors );
+	return 0;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,242 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file weather_sim.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Runs the unmodified WeatherStation sketch against the simulated
+ *             board and reports how long each loop() pass costs and how
+ *             much of the time the core was awake.
+ *
+ *             usage: weather_sim [--seconds N] [--wind MPH] [--rain IN_PER_HR]
+ *                                [--wdir ADC] [--eeprom FILE] [--dump-since SEQ]
+ *                                [--active-ma MA] [--sleep-ma MA] [--quiet]
+ *
+ *             --eeprom keeps the EEPROM in a file, so the log carries over
+ *             from one run (one reset) to the next.  --dump-since sends the
+ *             sketch a log dump request at start up.  --active-ma and
+ *             --sleep-ma are the supply current awake and idle, for the
+ *             mean current and daily charge the report ends with - the
+ *             defaults are the ATmega328P alone at 16 MHz and 5 V, so add
+ *             the sensors and the regulator for the whole board.
+ *
+ *             Built as weather_sim_prof the sketch has PROFILE_ENABLE set,
+ *             and the report ends with the profile of the run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+#include "sim_htu21d.h"
+#include "sim_mpl3115a2.h"
+
+#include "../WeatherStation.ino"
+
+/* call and timer compare overhead of one pass through loop() */
+#define SIM_CYCLES_LOOP_OVERHEAD    (40)
+
+#define NUM_LOOP_BUCKETS            (6)
+
+/* ATmega328P supply current at 16 MHz, 5 V - active and idle */
+#define SIM_ACTIVE_MA               (9.5)
+#define SIM_IDLE_MA                 (2.6)
+
+static SimHTU21D sim_htu21d;
+static SimMPL3115A2 sim_mpl3115a2;
+
+/**
+ * @brief      Distribution of loop() pass times.
+ */
+struct LoopProfile {
+	uint64_t passes;
+	uint64_t total_ns;
+	uint64_t max_ns;
+	uint64_t buckets[NUM_LOOP_BUCKETS];
+};
+
+static const uint64_t bucket_limit_ns[NUM_LOOP_BUCKETS] = {
+	10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, ~0ULL
+};
+static const char *bucket_name[NUM_LOOP_BUCKETS] = {
+	"< 10us", "< 100us", "< 1ms", "< 10ms", "< 100ms", ">= 100ms"
+};
+
+static void record_pass( LoopProfile *prof, uint64_t ns ) {
+	prof->passes++;
+	prof->total_ns += ns;
+	if ( ns > prof->max_ns ) {
+		prof->max_ns = ns;
+	}
+	for ( int i = 0; i < NUM_LOOP_BUCKETS; i++ ) {
+		if ( ns < bucket_limit_ns[i] ) {
+			prof->buckets[i]++;
+			break;
+		}
+	}
+}
+
+#if PROFILE_ENABLE
+/**
+ * @brief      Print target for the sketch's profile dump.
+ */
+class StderrPrint : public Print {
+public:
+	size_t write( uint8_t c ) {
+		fputc( c, stderr );
+		return 1;
+	}
+	using Print::write;
+};
+#endif
+
+static double ms( uint64_t ns ) {
+	return ns / 1e6;
+}
+
+static void report( const LoopProfile *prof, uint64_t run_ns, double active_ma,
+                    double sleep_ma ) {
+	const sim::Stats &st = sim::stats();
+	double asleep = (double) st.sleep_ns / run_ns;
+	double mean_ma = active_ma * ( 1.0 - asleep ) + sleep_ma * asleep;
+
+	fprintf( stderr, "\n==== weather_sim: %.1f s simulated ====\n", run_ns / 1e9 );
+	fprintf( stderr, "loop() passes      : %llu\n", (unsigned long long) prof->passes );
+	fprintf( stderr, "loop() mean awake  : %.3f ms\n",
+	         prof->passes ? ms( prof->total_ns ) / prof->passes : 0.0 );
+	fprintf( stderr, "loop() max awake   : %.3f ms\n", ms( prof->max_ns ) );
+	for ( int i = 0; i < NUM_LOOP_BUCKETS; i++ ) {
+		fprintf( stderr, "  %-10s       : %llu\n", bucket_name[i],
+		         (unsigned long long) prof->buckets[i] );
+	}
+	fprintf( stderr, "i2c transactions   : %llu (%llu messages, %llu bytes, %llu NACK)\n",
+	         (unsigned long long) st.i2c_transactions,
+	         (unsigned long long) st.i2c_messages,
+	         (unsigned long long) st.i2c_bytes,
+	         (unsigned long long) st.i2c_nacks );
+	fprintf( stderr, "i2c bus time       : %.3f ms (%.3f ms stretched)\n",
+	         ms( st.i2c_ns ), ms( st.i2c_stretch_ns ) );
+	fprintf( stderr, "delay() time       : %.3f ms (%.1f%%)\n",
+	         ms( st.delay_ns ), 100.0 * st.delay_ns / run_ns );
+	fprintf( stderr, "serial             : %llu bytes, %.3f ms blocked\n",
+	         (unsigned long long) st.serial_bytes, ms( st.serial_block_ns ) );
+	fprintf( stderr, "adc                : %llu reads, %.3f ms\n",
+	         (unsigned long long) st.adc_reads, ms( st.adc_ns ) );
+	fprintf( stderr, "interrupt edges    : %llu (%llu serviced, %llu lost)\n",
+	         (unsigned long long) st.irq_edges,
+	         (unsigned long long) st.irq_serviced,
+	         (unsigned long long) st.irq_lost );
+	fprintf( stderr, "interrupts masked  : %.3f ms\n", ms( st.irq_masked_ns ) );
+	fprintf( stderr, "eeprom             : %llu reads, %llu writes, %.3f ms waited\n",
+	         (unsigned long long) st.eeprom_reads, (unsigned long long) st.eeprom_writes,
+	         ms( st.eeprom_wait_ns ) );
+	fprintf( stderr, "asleep             : %.3f ms in %llu sleeps (%.1f%%)\n",
+	         ms( st.sleep_ns ), (unsigned long long) st.sleeps, 100.0 * asleep );
+	/* the sketch charges each wake-up a fixed POWER_WAKE_US */
+	fprintf( stderr, "awake              : %.2f%% (sketch counted %u.%u%%)\n",
+	         100.0 * ( 1.0 - asleep ), power.awakePermille() / 10, power.awakePermille() % 10 );
+	fprintf( stderr, "supply             : %.2f mA mean at %.2f/%.2f mA, %.1f mAh/day\n",
+	         mean_ma, active_ma, sleep_ma, mean_ma * 24.0 );
+#if PROFILE_ENABLE
+	/* the same lines the sketch sends for a "P" request, times in us */
+	StderrPrint err;
+	fprintf( stderr, "profile:\n" );
+	profile_dump_start();
+	while ( profile_dump_next( &err ) ) {
+	}
+#endif
+}
+
+int main( int argc, char **argv ) {
+	double seconds = 60.0;
+	double wind_mph = 5.0;
+	double rain_in_hr = 0.0;
+	unsigned wdir_adc = 895;
+	const char *eeprom_file = 0;
+	const char *dump_since = 0;
+	double active_ma = SIM_ACTIVE_MA;
+	double sleep_ma = SIM_IDLE_MA;
+
+	for ( int i = 1; i < argc; i++ ) {
+		if ( !strcmp( argv[i], "--seconds" ) && ( i + 1 < argc ) ) {
+			seconds = atof( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--wind" ) && ( i + 1 < argc ) ) {
+			wind_mph = atof( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--rain" ) && ( i + 1 < argc ) ) {
+			rain_in_hr = atof( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--wdir" ) && ( i + 1 < argc ) ) {
+			wdir_adc = (unsigned) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--eeprom" ) && ( i + 1 < argc ) ) {
+			eeprom_file = argv[++i];
+		}
+		else if ( !strcmp( argv[i], "--dump-since" ) && ( i + 1 < argc ) ) {
+			dump_since = argv[++i];
+		}
+		else if ( !strcmp( argv[i], "--active-ma" ) && ( i + 1 < argc ) ) {
+			active_ma = atof( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--sleep-ma" ) && ( i + 1 < argc ) ) {
+			sleep_ma = atof( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--quiet" ) ) {
+			sim::set_serial_echo( false );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--seconds N] [--wind MPH] [--rain IN_PER_HR] "
+			                 "[--wdir ADC] [--eeprom FILE] [--dump-since SEQ] "
+			                 "[--active-ma MA] [--sleep-ma MA] [--quiet]\n",
+			         argv[0] );
+			return 2;
+		}
+	}
+
+	sim::attach_i2c( &sim_htu21d );
+	sim::attach_i2c( &sim_mpl3115a2 );
+	sim::set_analog( WDIR_PIN, (uint16_t) wdir_adc );
+	sim::set_analog( REF_3V3_PIN, 675 );
+	sim::set_analog( LIGHT_PIN, 410 );
+	if ( eeprom_file && !sim::eeprom_attach_file( eeprom_file ) ) {
+		fprintf( stderr, "cannot open %s\n", eeprom_file );
+		return 1;
+	}
+
+	setup();
+	if ( dump_since ) {
+		char cmd[24];
+		int n = snprintf( cmd, sizeof( cmd ), "D%s\n", dump_since );
+		sim::serial_input( (const uint8_t *) cmd, (size_t) n );
+	}
+
+	/* 1.492 mph per anemometer closure per second, 0.011" per bucket tip */
+	sim::set_pulse_rate( WSPEED_PIN, wind_mph / 1.492 );
+	sim::set_pulse_rate( RAIN_PIN, rain_in_hr / 0.011 / 3600.0 );
+	sim::reset_stats();
+	power.resetStats();
+
+	LoopProfile prof;
+	memset( &prof, 0, sizeof( prof ) );
+	uint64_t start = sim::now_ns();
+	uint64_t end = start + (uint64_t) ( seconds * 1e9 );
+
+	while ( sim::now_ns() < end ) {
+		uint64_t t0 = sim::now_ns();
+		uint64_t slept = sim::stats().sleep_ns;
+		loop();
+		sim::charge_cycles( SIM_CYCLES_LOOP_OVERHEAD );
+		/* the pass's own cost - the sleep that ends it is reported apart */
+		record_pass( &prof, sim::now_ns() - t0 - ( sim::stats().sleep_ns - slept ) );
+	}
+
+	fflush( stdout );
+	report( &prof, sim::now_ns() - start, active_ma, sleep_ma );
+	return 0;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,83 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file wu_standin.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Runs the stand-in Wunderground endpoint until interrupted and
+ *             prints each accepted update.
+ *
+ *             usage: wu_standin [--port N] [--fail-every N] [--drop-every N]
+ *                               [--chunk-every N] [--close-every N]
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "http_standin.h"
+
+static volatile sig_atomic_t quit = 0;
+
+static void on_signal( int ) {
+	quit = 1;
+}
+
+int main( int argc, char **argv ) {
+	HttpStandin::Faults faults;
+	uint16_t port = 8080;
+
+	for ( int i = 1; i < argc; i++ ) {
+		if ( !strcmp( argv[i], "--port" ) && ( i + 1 < argc ) ) {
+			port = (uint16_t) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--fail-every" ) && ( i + 1 < argc ) ) {
+			faults.fail_every = (uint32_t) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--drop-every" ) && ( i + 1 < argc ) ) {
+			faults.drop_every = (uint32_t) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--chunk-every" ) && ( i + 1 < argc ) ) {
+			faults.chunk_every = (uint32_t) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--close-every" ) && ( i + 1 < argc ) ) {
+			faults.close_every = (uint32_t) atoi( argv[++i] );
+		}
+		else {
+			fprintf( stderr, "usage: %s [--port N] [--fail-every N] [--drop-every N] "
+			         "[--chunk-every N] [--close-every N]\n", argv[0] );
+			return 2;
+		}
+	}
+
+	HttpStandin server;
+	port = server.start( port, faults );
+	if ( !port ) {
+		perror( "wu_standin" );
+		return 1;
+	}
+	signal( SIGINT, on_signal );
+	signal( SIGTERM, on_signal );
+	fprintf( stderr, "wu_standin: listening on 127.0.0.1:%u\n", port );
+
+	size_t shown = 0;
+	while ( !quit ) {
+		usleep( 100000 );
+		std::vector<std::string> got = server.accepted();
+		for ( ; shown < got.size(); shown++ ) {
+			printf( "%s\n", got[shown].c_str() );
+		}
+		fflush( stdout );
+	}
+	server.stop();
+	fprintf( stderr, "wu_standin: %llu requests on %llu connections, %zu accepted\n",
+	         (unsigned long long) server.requests(), (unsigned long long) server.connections(),
+	         shown );
+	return 0;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,143 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file wu_upload.cpp
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Uploader daemon - reads the station's telemetry stream on
+ *             stdin, turns every record into a Wunderground update stamped
+ *             with the time it arrived, and uploads them in batches.
+ *
+ *             usage: wu_upload --id ID --password PW [--url URL] [--batch N]
+ *                              [--flush-s S] [--drain-s S] [--dry-run]
+ *
+ *             weather_sim --seconds 600 | wu_upload --id KXXX --password PW \
+ *                 --url http://127.0.0.1:8080/weatherstation/updateweatherstation.php
+ */
+
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "telemetry_decoder.h"
+#include "wu_uploader.h"
+#include "../Wunderground.h"
+
+#define WU_DEFAULT_URL "http://weatherstation.wunderground.com/weatherstation/updateweatherstation.php"
+
+static uint64_t now_ms( void ) {
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return (uint64_t) ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void usage( const char *prog ) {
+	fprintf( stderr, "usage: %s --id ID --password PW [--url URL] [--batch N] "
+	                 "[--flush-s S] [--drain-s S] [--dry-run]\n", prog );
+}
+
+int main( int argc, char **argv ) {
+	WuUploader::Config cfg;
+	WU_STATION_T station = { 0, 0, "WeatherStation" };
+	std::string url = WU_DEFAULT_URL;
+	double drain_s = 30.0;
+	bool dry_run = false;
+
+	for ( int i = 1; i < argc; i++ ) {
+		bool has_arg = ( i + 1 < argc );
+		if ( !strcmp( argv[i], "--id" ) && has_arg ) {
+			station.id = argv[++i];
+		}
+		else if ( !strcmp( argv[i], "--password" ) && has_arg ) {
+			station.password = argv[++i];
+		}
+		else if ( !strcmp( argv[i], "--url" ) && has_arg ) {
+			url = argv[++i];
+		}
+		else if ( !strcmp( argv[i], "--batch" ) && has_arg ) {
+			cfg.batch_max = (size_t) atoi( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--flush-s" ) && has_arg ) {
+			cfg.flush_ms = (uint32_t) ( atof( argv[++i] ) * 1000 );
+		}
+		else if ( !strcmp( argv[i], "--drain-s" ) && has_arg ) {
+			drain_s = atof( argv[++i] );
+		}
+		else if ( !strcmp( argv[i], "--dry-run" ) ) {
+			dry_run = true;
+		}
+		else {
+			usage( argv[0] );
+			return 2;
+		}
+	}
+	if ( !station.password ) {
+		station.password = getenv( "WU_PASSWORD" );
+	}
+	if ( !station.id || !station.password || !cfg.batch_max ||
+	     !WuUploader::parse_url( url, &cfg ) ) {
+		usage( argv[0] );
+		return 2;
+	}
+
+	WuUploader up( cfg );
+	TelemetryDecoder dec;
+	uint8_t buf[4096];
+	bool eof = false;
+
+	auto on_record = [&]( const TELEMETRY_RECORD_T &rec ) {
+		char dateutc[20];
+		char query[WU_QUERY_MAX];
+		time_t t = time( 0 );
+		struct tm utc;
+		gmtime_r( &t, &utc );
+		strftime( dateutc, sizeof( dateutc ), "%Y-%m-%d %H:%M:%S", &utc );
+		if ( !wu_build_query( query, sizeof( query ), &station, dateutc, &rec ) ) {
+			return;
+		}
+		if ( dry_run ) {
+			printf( "%s\n", query );
+		}
+		else {
+			up.enqueue( query, now_ms() );
+		}
+	};
+
+	while ( !eof ) {
+		struct pollfd p = { 0, POLLIN, 0 };
+		if ( poll( &p, 1, 200 ) > 0 ) {
+			ssize_t n = read( 0, buf, sizeof( buf ) );
+			if ( n > 0 ) {
+				dec.feed( buf, (size_t) n, on_record );
+			}
+			else {
+				eof = true;
+			}
+		}
+		up.service( now_ms() );
+	}
+
+	/* input is done - send what is left, retrying until the deadline */
+	uint64_t deadline = now_ms() + (uint64_t) ( drain_s * 1000 );
+	while ( up.pending() && ( now_ms() < deadline ) ) {
+		up.service( now_ms(), true );
+		if ( up.pending() ) {
+			usleep( 50000 );
+		}
+	}
+
+	const WuUploader::Stats &st = up.stats();
+	fprintf( stderr, "wu_upload: %llu records, %llu sent, %llu rejected, %llu dropped, "
+	                 "%zu unsent, %llu batches, %llu failures\n",
+	         (unsigned long long) dec.stats().frames, (unsigned long long) st.sent,
+	         (unsigned long long) st.rejected, (unsigned long long) st.dropped, up.pending(),
+	         (unsigned long long) st.batches, (unsigned long long) st.failures );
+	return up.pending() ? 1 : 0;
+}
+
+/** @} end of addtogroup */
@@ -0,0 +1,322 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file wu_uploader.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include <ctype.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "wu_uploader.h"
+
+WuUploader::WuUploader( const Config &config ) : cfg( config ) {
+	memset( &st, 0, sizeof( st ) );
+	fd = -1;
+	retry_at_ms = 0;
+	backoff_ms = cfg.backoff_min_ms;
+}
+
+WuUploader::~WuUploader() {
+	disconnect();
+}
+
+/**
+ * @brief      Splits http://host[:port][/path] into the config.
+ *
+ * @return     false for anything else (no TLS here).
+ */
+bool WuUploader::parse_url( const std::string &url, Config *cfg ) {
+	const std::string scheme = "http://";
+	if ( url.compare( 0, scheme.size(), scheme ) ) {
+		return false;
+	}
+	std::string rest = url.substr( scheme.size() );
+	size_t slash = rest.find( '/' );
+	std::string hostport = rest.substr( 0, slash );
+	cfg->path = ( std::string::npos == slash ) ? "/" : rest.substr( slash );
+	size_t colon = hostport.find( ':' );
+	cfg->host = hostport.substr( 0, colon );
+	cfg->port = 80;
+	if ( std::string::npos != colon ) {
+		long port = strtol( hostport.c_str() + colon + 1, 0, 10 );
+		if ( ( port <= 0 ) || ( port > 65535 ) ) {
+			return false;
+		}
+		cfg->port = (uint16_t) port;
+	}
+	return !cfg->host.empty();
+}
+
+void WuUploader::enqueue( const std::string &query, uint64_t now_ms ) {
+	if ( queue.size() >= cfg.queue_max ) {
+		queue.pop_front();
+		st.dropped++;
+	}
+	queue.push_back( Item{ query, now_ms } );
+	st.queued++;
+}
+
+/**
+ * @brief      Sends a batch if one is due and the backoff allows.
+ *
+ * @param[in]  flush_all  send whatever is queued without waiting for a full
+ *                        batch (shutdown).
+ */
+void WuUploader::service( uint64_t now_ms, bool flush_all ) {
+	if ( queue.empty() || ( now_ms < retry_at_ms ) ) {
+		return;
+	}
+	bool due = flush_all || ( queue.size() >= cfg.batch_max ) ||
+	           ( now_ms - queue.front().queued_ms >= cfg.flush_ms );
+	if ( !due ) {
+		return;
+	}
+
+	st.batches++;
+	size_t n = 0;
+	bool failed = false;
+	while ( !queue.empty() && ( n < cfg.batch_max ) ) {
+		if ( ( fd < 0 ) && !connect_server() ) {
+			failed = true;
+			break;
+		}
+		Result r = send_one( queue.front().query );
+		if ( RES_RETRY == r ) {
+			failed = true;
+			break;
+		}
+		if ( RES_OK == r ) {
+			st.sent++;
+		}
+		else {
+			st.rejected++;
+		}
+		queue.pop_front();
+		n++;
+	}
+	/* one connection per batch */
+	disconnect();
+
+	if ( failed ) {
+		st.failures++;
+		retry_at_ms = now_ms + backoff_ms;
+		backoff_ms = ( backoff_ms > cfg.backoff_max_ms / 2 ) ? cfg.backoff_max_ms : backoff_ms * 2;
+	}
+	else {
+		backoff_ms = cfg.backoff_min_ms;
+		retry_at_ms = 0;
+	}
+}
+
+bool WuUploader::connect_server( void ) {
+	struct addrinfo hints, *res = 0;
+	char port[8];
+
+	memset( &hints, 0, sizeof( hints ) );
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	snprintf( port, sizeof( port ), "%u", cfg.port );
+	if ( getaddrinfo( cfg.host.c_str(), port, &hints, &res ) ) {
+		return false;
+	}
+	for ( struct addrinfo *ai = res; ai; ai = ai->ai_next ) {
+		fd = socket( ai->ai_family, ai->ai_socktype, ai->ai_protocol );
+		if ( fd < 0 ) {
+			continue;
+		}
+		struct timeval tv = { (time_t) ( cfg.timeout_ms / 1000 ),
+		                      (suseconds_t) ( ( cfg.timeout_ms % 1000 ) * 1000 ) };
+		setsockopt( fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof( tv ) );
+		setsockopt( fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof( tv ) );
+		int one = 1;
+		setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof( one ) );
+		if ( 0 == connect( fd, ai->ai_addr, ai->ai_addrlen ) ) {
+			break;
+		}
+		close( fd );
+		fd = -1;
+	}
+	freeaddrinfo( res );
+	if ( fd >= 0 ) {
+		st.connects++;
+	}
+	return fd >= 0;
+}
+
+void WuUploader::disconnect( void ) {
+	if ( fd >= 0 ) {
+		close( fd );
+		fd = -1;
+	}
+}
+
+WuUploader::Result WuUploader::send_one( const std::string &query ) {
+	std::string req = "GET " + cfg.path + "?" + query + " HTTP/1.1\r\nHost: " + cfg.host +
+	                  "\r\nConnection: keep-alive\r\n\r\n";
+	size_t off = 0;
+	while ( off < req.size() ) {
+		ssize_t n = send( fd, req.data() + off, req.size() - off, MSG_NOSIGNAL );
+		if ( n <= 0 ) {
+			disconnect();
+			return RES_RETRY;
+		}
+		off += (size_t) n;
+	}
+
+	int status;
+	std::string body;
+	bool keep_alive;
+	if ( !read_response( &status, &body, &keep_alive ) ) {
+		disconnect();
+		return RES_RETRY;
+	}
+	if ( !keep_alive ) {
+		disconnect();
+	}
+	if ( ( status >= 500 ) || ( 429 == status ) ) {
+		return RES_RETRY;
+	}
+	/* Wunderground answers 200 either way - the body says whether it took it */
+	return ( ( 200 == status ) && ( 0 == body.compare( 0, 7, "success" ) ) ) ? RES_OK : RES_REJECTED;
+}
+
+/**
+ * @brief      Appends whatever the server sends next.
+ *
+ * @return     false at the end of the connection, on an error or timeout.
+ */
+bool WuUploader::recv_more( std::string *buf ) {
+	char chunk[1024];
+	ssize_t n = recv( fd, chunk, sizeof( chunk ), 0 );
+	if ( n <= 0 ) {
+		return false;
+	}
+	buf->append( chunk, (size_t) n );
+	return true;
+}
+
+/**
+ * @brief      Reads one response - status line, headers and a body framed
+ *             by Content-Length, by chunked transfer coding or, with neither,
+ *             by the server closing the connection.
+ */
+bool WuUploader::read_response( int *status, std::string *body, bool *keep_alive ) {
+	std::string buf;
+	size_t hdr_end;
+
+	while ( std::string::npos == ( hdr_end = buf.find( "\r\n\r\n" ) ) ) {
+		if ( !recv_more( &buf ) ) {
+			return false;
+		}
+	}
+	if ( buf.compare( 0, 5, "HTTP/" ) ) {
+		return false;
+	}
+	size_t sp = buf.find( ' ' );
+	*status = atoi( buf.c_str() + sp + 1 );
+
+	size_t content_length = 0;
+	bool has_length = false;
+	bool chunked = false;
+	*keep_alive = ( 0 == buf.compare( 0, 8, "HTTP/1.1" ) );
+	size_t line = buf.find( "\r\n" ) + 2;
+	while ( line < hdr_end ) {
+		size_t eol = buf.find( "\r\n", line );
+		std::string h = buf.substr( line, eol - line );
+		if ( 0 == strncasecmp( h.c_str(), "Content-Length:", 15 ) ) {
+			content_length = strtoul( h.c_str() + 15, 0, 10 );
+			has_length = true;
+		}
+		else if ( 0 == strncasecmp( h.c_str(), "Transfer-Encoding:", 18 ) ) {
+			chunked = ( 0 != strcasestr( h.c_str() + 18, "chunked" ) );
+		}
+		else if ( 0 == strncasecmp( h.c_str(), "Connection:", 11 ) ) {
+			*keep_alive = ( 0 == strcasestr( h.c_str() + 11, "close" ) );
+		}
+		line = eol + 2;
+	}
+	buf.erase( 0, hdr_end + 4 );
+
+	if ( ( *status < 200 ) || ( 204 == *status ) || ( 304 == *status ) ) {
+		body->clear();
+		return true;
+	}
+	if ( chunked ) {
+		return read_chunked( &buf, body );
+	}
+	if ( !has_length ) {
+		/* the body runs to the end of the connection */
+		*keep_alive = false;
+		while ( recv_more( &buf ) ) {
+		}
+		*body = buf;
+		return true;
+	}
+	while ( buf.size() < content_length ) {
+		if ( !recv_more( &buf ) ) {
+			return false;
+		}
+	}
+	*body = buf.substr( 0, content_length );
+	return true;
+}
+
+/**
+ * @brief      Decodes a chunked body, buf holding what has been read past
+ *             the headers.  Chunk extensions and trailers are skipped.
+ *
+ * @return     false if the connection ends or a chunk size is malformed.
+ */
+bool WuUploader::read_chunked( std::string *buf, std::string *body ) {
+	size_t pos = 0;
+	size_t eol;
+
+	body->clear();
+	for ( ;; ) {
+		while ( std::string::npos == ( eol = buf->find( "\r\n", pos ) ) ) {
+			if ( !recv_more( buf ) ) {
+				return false;
+			}
+		}
+		if ( !isxdigit( (unsigned char) ( *buf )[pos] ) ) {
+			return false;
+		}
+		size_t len = strtoul( buf->c_str() + pos, 0, 16 );
+		pos = eol + 2;
+		if ( 0 == len ) {
+			break;
+		}
+		while ( buf->size() < pos + len + 2 ) {
+			if ( !recv_more( buf ) ) {
+				return false;
+			}
+		}
+		body->append( *buf, pos, len );
+		pos += len + 2;
+	}
+	/* trailer lines, up to the empty one */
+	for ( ;; ) {
+		while ( std::string::npos == ( eol = buf->find( "\r\n", pos ) ) ) {
+			if ( !recv_more( buf ) ) {
+				return false;
+			}
+		}
+		if ( eol == pos ) {
+			return true;
+		}
+		pos = eol + 2;
+	}
+}
+
+/** @} end of addtogroup */
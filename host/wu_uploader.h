@@ -0,0 +1,89 @@
+/*-----------------------------------------------*/
+/** @addtogroup host_sim Host Simulation
+ * @{
+ *
+ * @file wu_uploader.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Queues Wunderground update requests and sends them in batches
+ *             over one keep-alive HTTP connection, retrying with exponential
+ *             backoff.
+ *
+ * @details    A batch goes out once batch_max requests are waiting or the
+ *             oldest has waited flush_ms.  Requests leave the queue only when
+ *             the server answers "success" (or rejects them outright), so a
+ *             failed or dropped connection just delays them.  The queue is
+ *             bounded; when full the oldest request is dropped and counted.
+ *             Sockets are blocking with timeouts - this is meant for a small
+ *             single threaded daemon.
+ */
+
+#ifndef WU_UPLOADER_H
+#define WU_UPLOADER_H
+
+#include <stdint.h>
+#include <deque>
+#include <string>
+
+class WuUploader {
+public:
+	struct Config {
+		std::string host = "127.0.0.1";
+		uint16_t port = 80;
+		std::string path = "/weatherstation/updateweatherstation.php";
+		size_t batch_max = 12;
+		uint32_t flush_ms = 60000;
+		size_t queue_max = 1440;
+		uint32_t timeout_ms = 5000;
+		uint32_t backoff_min_ms = 1000;
+		uint32_t backoff_max_ms = 300000;
+	};
+
+	struct Stats {
+		uint64_t queued;
+		uint64_t sent;
+		uint64_t rejected;      /* answered, but not "success" - not retried */
+		uint64_t dropped;       /* pushed out of a full queue */
+		uint64_t batches;
+		uint64_t connects;
+		uint64_t failures;      /* connect/IO errors and 5xx answers */
+	};
+
+	explicit WuUploader( const Config &cfg );
+	~WuUploader();
+
+	static bool parse_url( const std::string &url, Config *cfg );
+
+	void enqueue( const std::string &query, uint64_t now_ms );
+	void service( uint64_t now_ms, bool flush_all = false );
+	size_t pending( void ) const { return queue.size(); }
+	uint64_t next_attempt_ms( void ) const { return retry_at_ms; }
+	const Stats &stats( void ) const { return st; }
+
+private:
+	struct Item {
+		std::string query;
+		uint64_t queued_ms;
+	};
+
+	enum Result { RES_OK, RES_REJECTED, RES_RETRY };
+
+	bool connect_server( void );
+	void disconnect( void );
+	Result send_one( const std::string &query );
+	bool read_response( int *status, std::string *body, bool *keep_alive );
+	bool read_chunked( std::string *buf, std::string *body );
+	bool recv_more( std::string *buf );
+
+	Config cfg;
+	Stats st;
+	std::deque<Item> queue;
+	int fd;
+	uint64_t retry_at_ms;
+	uint32_t backoff_ms;
+};
+
+#endif
+
+/** @} end of addtogroup */
@@ -0,0 +1,117 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file units.cpp
+ *
+ * @date       16-OCT-2026
+ */
+
+#include "units.h"
+
+/* HTU21D: T = -46.85 + 175.72 x raw / 2^16, RH = -6 + 125 x raw / 2^16 */
+#define UNITS_HTU_T_SLOPE_C100      (17572UL)
+#define UNITS_HTU_T_OFFSET_C100     (4685)
+#define UNITS_HTU_RH_SLOPE_C100     (12500UL)
+#define UNITS_HTU_RH_OFFSET_C100    (600)
+/* the bottom two bits of an HTU21D reading are status, not data */
+#define UNITS_HTU_STATUS_MASK       (0x0003)
+
+/* light sensor: volts = 3.3 x light / ref, the 3.3 V rail read on ref */
+#define UNITS_LIGHT_REF_MV          (3300UL)
+
+/**
+ * @brief      v / d rounded half away from zero (d > 0).
+ */
+int32_t units_div_round( int32_t v, int32_t d ) {
+	return ( v < 0 ) ? -( ( -v + d / 2 ) / d ) : ( v + d / 2 ) / d;
+}
+
+/**
+ * @brief      slope x raw / 2^16 - offset, rounded half away from zero.
+ *
+ * @details    The quotient of the shift is the whole part and the low 16
+ *             bits the fraction.  A non-negative result rounds up from
+ *             exactly one half; a negative one only from past one half, as
+ *             the fraction then takes it towards zero.
+ */
+static int16_t scale_q16( uint32_t slope, uint16_t raw, int16_t offset ) {
+	uint32_t prod = slope * ( raw & ~UNITS_HTU_STATUS_MASK );
+	int32_t whole = (int32_t) ( prod >> 16 ) - offset;
+	uint16_t frac = (uint16_t) prod;
+
+	if ( whole >= 0 ) {
+		whole += ( frac >= 0x8000 ) ? 1 : 0;
+	}
+	else {
+		whole += ( frac > 0x8000 ) ? 1 : 0;
+	}
+	return (int16_t) whole;
+}
+
+/**
+ * @brief      HTU21D temperature reading to hundredths of a degree C.
+ */
+int16_t units_htu_temp_c100( uint16_t raw ) {
+	return scale_q16( UNITS_HTU_T_SLOPE_C100, raw, UNITS_HTU_T_OFFSET_C100 );
+}
+
+/**
+ * @brief      HTU21D humidity reading to hundredths of a percent RH.  Not
+ *             clamped - the sensor can read a little under 0 % and over
+ *             100 %.
+ */
+int16_t units_htu_humidity_c100( uint16_t raw ) {
+	return scale_q16( UNITS_HTU_RH_SLOPE_C100, raw, UNITS_HTU_RH_OFFSET_C100 );
+}
+
+/**
+ * @brief      MPL3115A2 temperature (OUT_T_MSB:OUT_T_LSB, Q8.4 two's
+ *             complement in the upper 12 bits) to hundredths of a degree C.
+ */
+int16_t units_mpl_temp_c100( uint16_t raw ) {
+	int16_t sixteenths = (int16_t) raw;
+	sixteenths >>= 4;
+	/* x 100 / 16 = x 25 / 4 */
+	return (int16_t) units_div_round( (int32_t) sixteenths * 25, 4 );
+}
+
+/**
+ * @brief      Pressure in Pa x 4 to thousandths of an inch of mercury,
+ *             rounded half up.
+ *
+ * @details    inHg x 1000 = pa4 x 250000 / 3386389.  The product needs 39
+ *             bits, so the division is done as two long division steps of
+ *             x 500 each, every intermediate fitting in 32 bits.
+ */
+uint32_t units_pa4_to_inhg1000( uint32_t pa4 ) {
+	uint32_t a = pa4 * 500UL;
+	uint32_t q = a / UNITS_INHG_PA1000;
+	uint32_t r = ( a % UNITS_INHG_PA1000 ) * 500UL;
+	q = q * 500UL + r / UNITS_INHG_PA1000;
+	r %= UNITS_INHG_PA1000;
+	return q + ( ( r >= ( UNITS_INHG_PA1000 + 1 ) / 2 ) ? 1 : 0 );
+}
+
+/**
+ * @brief      Hundredths of a degree C to hundredths of a degree F.
+ */
+int32_t units_c100_to_f100( int16_t c100 ) {
+	return units_div_round( (int32_t) c100 * 9 + 16000, 5 );
+}
+
+/**
+ * @brief      Light sensor voltage in millivolts, scaled against the 3.3 V
+ *             rail so it does not depend on VCC.  Rounded half up.
+ *
+ * @return     0xFFFF if the rail reads 0 or the result does not fit.
+ */
+uint16_t units_light_mv( uint16_t light_adc, uint16_t ref_adc ) {
+	if ( 0 == ref_adc ) {
+		return 0xFFFF;
+	}
+	uint32_t mv = ( 2 * UNITS_LIGHT_REF_MV * light_adc + ref_adc ) / ( 2UL * ref_adc );
+	return ( mv > 0xFFFF ) ? 0xFFFF : (uint16_t) mv;
+}
+
+/** @} end of addtogroup */
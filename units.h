@@ -0,0 +1,43 @@
+/*-----------------------------------------------*/
+/** @addtogroup weather_station Mini Backyard Weather Station
+ * @{
+ *
+ * @file units.h
+ *
+ * @date       16-OCT-2026
+ *
+ * @brief      Integer conversions from raw sensor readings to the units the
+ *             station reports in.
+ *
+ * @details    The AVR has no floating point unit: every float multiply or
+ *             divide is a library call of a few hundred cycles and the first
+ *             one pulls the soft-float routines into flash.  These kernels
+ *             give the same figures in fixed point - hundredths of a degree
+ *             or percent, Pa x 4, thousandths of an inch of mercury and
+ *             millivolts - using only 32 bit integer arithmetic.
+ *
+ *             Every result is the exact value rounded half away from zero,
+ *             not an approximation of the float expression it replaces;
+ *             host/bench_units checks each one over its whole input range.
+ *             Floats are left to the edges that print for a person.
+ */
+
+#ifndef UNITS_H
+#define UNITS_H
+
+#include <stdint.h>
+
+/* @brief      1 inHg = 3386.389 Pa */
+#define UNITS_INHG_PA1000 (3386389UL)
+
+int16_t units_htu_temp_c100( uint16_t raw );
+int16_t units_htu_humidity_c100( uint16_t raw );
+int16_t units_mpl_temp_c100( uint16_t raw );
+uint32_t units_pa4_to_inhg1000( uint32_t pa4 );
+int32_t units_c100_to_f100( int16_t c100 );
+uint16_t units_light_mv( uint16_t light_adc, uint16_t ref_adc );
+int32_t units_div_round( int32_t v, int32_t d );
+
+#endif
+
+/** @} end of addtogroup */